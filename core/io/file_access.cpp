@@ -35,6 +35,8 @@
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/sort_array.h"
 
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = { nullptr, nullptr };
 
@@ -381,6 +383,53 @@ uint64_t FileAccess::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return i;
 }
 
+Error FileAccess::get_buffers(BufferRead *p_reads, uint32_t p_count) const {
+	ERR_FAIL_COND_V(!p_reads && p_count > 0, ERR_INVALID_PARAMETER);
+
+	if (p_count == 0) {
+		return OK;
+	}
+
+	// Generic fallback, issue the reads in file order so sequential backends don't thrash.
+	LocalVector<uint32_t> order;
+	order.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		order[i] = i;
+	}
+
+	struct ReadSort {
+		const BufferRead *reads = nullptr;
+		bool operator()(uint32_t p_a, uint32_t p_b) const { return reads[p_a].position < reads[p_b].position; }
+	};
+
+	SortArray<uint32_t, ReadSort> sorter;
+	sorter.compare.reads = p_reads;
+	sorter.sort(order.ptr(), p_count);
+
+	// The cursor is restored afterwards, so the batch doesn't change the visible state.
+	FileAccess *self = const_cast<FileAccess *>(this);
+	uint64_t prev_pos = get_position();
+	Error err = OK;
+	for (uint32_t i = 0; i < p_count; i++) {
+		BufferRead &r = p_reads[order[i]];
+		r.read = 0; // Skipped reads report nothing read, not the count of a previous batch.
+		if (r.length > 0) {
+			ERR_CONTINUE(!r.dst);
+			self->seek(r.position);
+			r.read = get_buffer(r.dst, r.length);
+		}
+	}
+	self->seek(prev_pos);
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		if (p_reads[i].read != p_reads[i].length) {
+			err = ERR_FILE_EOF;
+		}
+	}
+
+	return err;
+}
+
 String FileAccess::get_as_utf8_string(bool p_skip_cr) const {
 	Vector<uint8_t> sourcef;
 	uint64_t len = get_length();
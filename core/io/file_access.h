@@ -111,6 +111,23 @@ public:
 	virtual real_t get_real() const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
+
+	struct BufferRead {
+		uint64_t position = 0; ///< absolute position in the file
+		uint8_t *dst = nullptr;
+		uint64_t length = 0;
+		uint64_t read = 0; ///< bytes actually read, filled in by get_buffers()
+	};
+
+	/**
+	 * Perform a batch of positional reads. Implementations are free to reorder
+	 * or run them concurrently; the current file position is left unchanged.
+	 * Returns ERR_FILE_EOF if any read came back short.
+	 * This call blocks until every read of the batch is done, there is no
+	 * asynchronous submit/completion API. To overlap the reads with other
+	 * work, call it from a WorkerThreadPool task.
+	 */
+	virtual Error get_buffers(BufferRead *p_reads, uint32_t p_count) const;
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
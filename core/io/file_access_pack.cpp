@@ -31,6 +31,7 @@
 #include "file_access_pack.h"
 
 #include "core/io/file_access_encrypted.h"
+#include "core/templates/local_vector.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/version.h"
@@ -336,6 +337,34 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return to_read;
 }
 
+Error FileAccessPack::get_buffers(BufferRead *p_reads, uint32_t p_count) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_READ, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_reads && p_count > 0, ERR_INVALID_PARAMETER);
+
+	// Translate the reads into the pack's address space and forward the whole batch,
+	// so the underlying file access can service them in one go.
+	LocalVector<BufferRead> pack_reads;
+	pack_reads.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		const BufferRead &r = p_reads[i];
+		BufferRead &pr = pack_reads[i];
+		pr.dst = r.dst;
+		pr.position = off + r.position;
+		pr.length = r.position >= pf.size ? 0 : MIN(r.length, pf.size - r.position);
+	}
+
+	// The underlying file access restores its cursor, so the pack's view is unchanged.
+	Error err = f->get_buffers(pack_reads.ptr(), p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_reads[i].read = pack_reads[i].read;
+		if (p_reads[i].read != p_reads[i].length) {
+			err = ERR_FILE_EOF;
+		}
+	}
+
+	return err;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
@@ -166,6 +166,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Error get_buffers(BufferRead *p_reads, uint32_t p_count) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
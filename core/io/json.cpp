@@ -31,6 +31,8 @@
 #include "json.h"
 
 #include "core/string/print_string.h"
+#include "core/string/string_builder.h"
+#include "core/templates/local_vector.h"
 
 const char *JSON::tk_name[TK_MAX] = {
 	"'{'",
@@ -45,42 +47,38 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-String JSON::_make_indent(const String &p_indent, int p_size) {
-	String indent_text = "";
+void JSON::_add_indent(StringBuilder &r_builder, const String &p_indent, int p_size) {
 	if (!p_indent.is_empty()) {
 		for (int i = 0; i < p_size; i++) {
-			indent_text += p_indent;
+			r_builder += p_indent;
 		}
 	}
-	return indent_text;
 }
 
-String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
-	String colon = ":";
-	String end_statement = "";
-
-	if (!p_indent.is_empty()) {
-		colon += " ";
-		end_statement += "\n";
-	}
+void JSON::_stringify(StringBuilder &r_builder, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
+	const bool pretty = !p_indent.is_empty();
 
 	switch (p_var.get_type()) {
 		case Variant::NIL:
-			return "null";
+			r_builder += "null";
+			return;
 		case Variant::BOOL:
-			return p_var.operator bool() ? "true" : "false";
+			r_builder += p_var.operator bool() ? "true" : "false";
+			return;
 		case Variant::INT:
-			return itos(p_var);
+			r_builder += itos(p_var);
+			return;
 		case Variant::FLOAT: {
 			double num = p_var;
 			if (p_full_precision) {
 				// Store unreliable digits (17) instead of just reliable
 				// digits (14) so that the value can be decoded exactly.
-				return String::num(num, 17 - (int)floor(log10(num)));
+				r_builder += String::num(num, 17 - (int)floor(log10(num)));
 			} else {
 				// Store only reliable digits (14) by default.
-				return String::num(num, 14 - (int)floor(log10(num)));
+				r_builder += String::num(num, 14 - (int)floor(log10(num)));
 			}
+			return;
 		}
 		case Variant::PACKED_INT32_ARRAY:
 		case Variant::PACKED_INT64_ARRAY:
@@ -88,30 +86,37 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 		case Variant::PACKED_FLOAT64_ARRAY:
 		case Variant::PACKED_STRING_ARRAY:
 		case Variant::ARRAY: {
-			String s = "[";
-			s += end_statement;
 			Array a = p_var;
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(a.id()), "\"[...]\"", "Converting circular structure to JSON.");
+			if (p_markers.has(a.id())) {
+				r_builder += "\"[...]\"";
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
 			p_markers.insert(a.id());
 
+			r_builder += pretty ? "[\n" : "[";
 			for (int i = 0; i < a.size(); i++) {
 				if (i > 0) {
-					s += ",";
-					s += end_statement;
+					r_builder += pretty ? ",\n" : ",";
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(a[i], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_add_indent(r_builder, p_indent, p_cur_indent + 1);
+				_stringify(r_builder, a[i], p_indent, p_cur_indent + 1, p_sort_keys, p_markers, p_full_precision);
 			}
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "]";
+			if (pretty) {
+				r_builder += "\n";
+			}
+			_add_indent(r_builder, p_indent, p_cur_indent);
+			r_builder += "]";
 			p_markers.erase(a.id());
-			return s;
+			return;
 		}
 		case Variant::DICTIONARY: {
-			String s = "{";
-			s += end_statement;
 			Dictionary d = p_var;
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(d.id()), "\"{...}\"", "Converting circular structure to JSON.");
+			if (p_markers.has(d.id())) {
+				r_builder += "\"{...}\"";
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
 			p_markers.insert(d.id());
 
 			List<Variant> keys;
@@ -121,25 +126,32 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 				keys.sort();
 			}
 
+			r_builder += pretty ? "{\n" : "{";
 			bool first_key = true;
 			for (const Variant &E : keys) {
 				if (first_key) {
 					first_key = false;
 				} else {
-					s += ",";
-					s += end_statement;
+					r_builder += pretty ? ",\n" : ",";
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(String(E), p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
-				s += colon;
-				s += _stringify(d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_add_indent(r_builder, p_indent, p_cur_indent + 1);
+				_stringify(r_builder, String(E), p_indent, p_cur_indent + 1, p_sort_keys, p_markers, p_full_precision);
+				r_builder += pretty ? ": " : ":";
+				_stringify(r_builder, d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers, p_full_precision);
 			}
-
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "}";
+			if (pretty) {
+				r_builder += "\n";
+			}
+			_add_indent(r_builder, p_indent, p_cur_indent);
+			r_builder += "}";
 			p_markers.erase(d.id());
-			return s;
+			return;
 		}
 		default:
-			return "\"" + String(p_var).json_escape() + "\"";
+			r_builder += "\"";
+			r_builder += String(p_var).json_escape();
+			r_builder += "\"";
+			return;
 	}
 }
 
@@ -536,11 +548,537 @@ Error JSON::parse(const String &p_json_string) {
 	return err;
 }
 
+// Buffered reader over the raw UTF-8 bytes of a file. Tokens are scanned directly on
+// the bytes: everything outside of strings is ASCII, and strings are decoded once
+// they are complete.
+struct JSON::StreamReader {
+	Ref<FileAccess> f;
+	LocalVector<uint8_t> buffer;
+	uint32_t pos = 0;
+	uint32_t size = 0;
+
+	bool fill() {
+		if (f.is_null()) {
+			return false;
+		}
+		uint64_t read = f->get_buffer(buffer.ptr(), buffer.size());
+		pos = 0;
+		size = read > buffer.size() ? 0 : read;
+		if (size == 0) {
+			f.unref(); // Done reading, don't hit the file again.
+			return false;
+		}
+		return true;
+	}
+
+	// Returns -1 at the end of the stream.
+	_FORCE_INLINE_ int peek() {
+		if (pos == size && !fill()) {
+			return -1;
+		}
+		return buffer[pos];
+	}
+
+	_FORCE_INLINE_ int get() {
+		if (pos == size && !fill()) {
+			return -1;
+		}
+		return buffer[pos++];
+	}
+};
+
+static void _append_utf8(CharString &r_str, int &r_len, char32_t p_char) {
+	char buf[4];
+	int n = 0;
+	if (p_char < 0x80) {
+		buf[n++] = p_char;
+	} else if (p_char < 0x800) {
+		buf[n++] = 0xC0 | (p_char >> 6);
+		buf[n++] = 0x80 | (p_char & 0x3F);
+	} else if (p_char < 0x10000) {
+		buf[n++] = 0xE0 | (p_char >> 12);
+		buf[n++] = 0x80 | ((p_char >> 6) & 0x3F);
+		buf[n++] = 0x80 | (p_char & 0x3F);
+	} else {
+		buf[n++] = 0xF0 | (p_char >> 18);
+		buf[n++] = 0x80 | ((p_char >> 12) & 0x3F);
+		buf[n++] = 0x80 | ((p_char >> 6) & 0x3F);
+		buf[n++] = 0x80 | (p_char & 0x3F);
+	}
+
+	if (r_len + n > r_str.size()) {
+		r_str.resize(MAX(r_str.size() * 2, 64));
+	}
+	memcpy(r_str.ptrw() + r_len, buf, n);
+	r_len += n;
+}
+
+Error JSON::_get_stream_hex(StreamReader &p_reader, char32_t &r_value, String &r_err_str) {
+	r_value = 0;
+	for (int j = 0; j < 4; j++) {
+		int c = p_reader.get();
+		if (c <= 0) {
+			r_err_str = "Unterminated String";
+			return ERR_PARSE_ERROR;
+		}
+		if (!is_hex_digit(c)) {
+			r_err_str = "Malformed hex constant in string";
+			return ERR_PARSE_ERROR;
+		}
+		r_value <<= 4;
+		r_value |= is_digit(c) ? c - '0' : (c | 0x20) - 'a' + 10;
+	}
+	return OK;
+}
+
+Error JSON::_get_stream_token(StreamReader &p_reader, Token &r_token, int &line, String &r_err_str) {
+	while (true) {
+		int c = p_reader.peek();
+		switch (c) {
+			case -1:
+			case 0: {
+				r_token.type = TK_EOF;
+				return OK;
+			}
+			case '\n': {
+				line++;
+				p_reader.get();
+			} break;
+			case '{': {
+				r_token.type = TK_CURLY_BRACKET_OPEN;
+				p_reader.get();
+				return OK;
+			}
+			case '}': {
+				r_token.type = TK_CURLY_BRACKET_CLOSE;
+				p_reader.get();
+				return OK;
+			}
+			case '[': {
+				r_token.type = TK_BRACKET_OPEN;
+				p_reader.get();
+				return OK;
+			}
+			case ']': {
+				r_token.type = TK_BRACKET_CLOSE;
+				p_reader.get();
+				return OK;
+			}
+			case ':': {
+				r_token.type = TK_COLON;
+				p_reader.get();
+				return OK;
+			}
+			case ',': {
+				r_token.type = TK_COMMA;
+				p_reader.get();
+				return OK;
+			}
+			case '"': {
+				p_reader.get();
+				CharString str;
+				int len = 0;
+				while (true) {
+					// Copy plain runs straight out of the read buffer.
+					uint32_t run = p_reader.pos;
+					while (run < p_reader.size && p_reader.buffer[run] != '"' && p_reader.buffer[run] != '\\' && p_reader.buffer[run] != '\n' && p_reader.buffer[run] != 0) {
+						run++;
+					}
+					if (run > p_reader.pos) {
+						int n = run - p_reader.pos;
+						if (len + n > str.size()) {
+							str.resize(MAX(str.size() * 2, len + n));
+						}
+						memcpy(str.ptrw() + len, &p_reader.buffer[p_reader.pos], n);
+						len += n;
+						p_reader.pos = run;
+					}
+
+					int ch = p_reader.get();
+					if (ch <= 0) {
+						r_err_str = "Unterminated String";
+						return ERR_PARSE_ERROR;
+					} else if (ch == '"') {
+						break;
+					} else if (ch == '\\') {
+						int next = p_reader.get();
+						if (next <= 0) {
+							r_err_str = "Unterminated String";
+							return ERR_PARSE_ERROR;
+						}
+						char32_t res = 0;
+
+						switch (next) {
+							case 'b':
+								res = 8;
+								break;
+							case 't':
+								res = 9;
+								break;
+							case 'n':
+								res = 10;
+								break;
+							case 'f':
+								res = 12;
+								break;
+							case 'r':
+								res = 13;
+								break;
+							case 'u': {
+								Error err = _get_stream_hex(p_reader, res, r_err_str);
+								if (err != OK) {
+									return err;
+								}
+
+								if ((res & 0xfffffc00) == 0xd800) {
+									if (p_reader.get() != '\\' || p_reader.get() != 'u') {
+										r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+										return ERR_PARSE_ERROR;
+									}
+									char32_t trail;
+									err = _get_stream_hex(p_reader, trail, r_err_str);
+									if (err != OK) {
+										return err;
+									}
+									if ((trail & 0xfffffc00) == 0xdc00) {
+										res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+									} else {
+										r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+										return ERR_PARSE_ERROR;
+									}
+								} else if ((res & 0xfffffc00) == 0xdc00) {
+									r_err_str = "Invalid UTF-16 sequence in string, unpaired trail surrogate";
+									return ERR_PARSE_ERROR;
+								}
+							} break;
+							default: {
+								res = next;
+							} break;
+						}
+
+						_append_utf8(str, len, res);
+					} else {
+						if (ch == '\n') {
+							line++;
+						}
+						// A raw byte of the input, which is already UTF-8.
+						if (len + 1 > str.size()) {
+							str.resize(MAX(str.size() * 2, 64));
+						}
+						str.ptrw()[len++] = ch;
+					}
+				}
+
+				String s;
+				s.parse_utf8(str.get_data(), len);
+				r_token.type = TK_STRING;
+				r_token.value = s;
+				return OK;
+			}
+			default: {
+				if (c <= 32) {
+					p_reader.get();
+					break;
+				}
+
+				if (c == '-' || is_digit(c)) {
+					// A number, following the JSON grammar so the scan stops at the right character.
+					char num[64];
+					int len = 0;
+					bool too_long = false;
+					auto take = [&]() {
+						int d = p_reader.get();
+						if (len < 63) {
+							num[len++] = d;
+						} else {
+							too_long = true;
+						}
+					};
+					if (c == '-') {
+						take();
+					}
+					while (is_digit(p_reader.peek())) {
+						take();
+					}
+					if (p_reader.peek() == '.') {
+						take();
+						while (is_digit(p_reader.peek())) {
+							take();
+						}
+					}
+					if (p_reader.peek() == 'e' || p_reader.peek() == 'E') {
+						take();
+						if (p_reader.peek() == '+' || p_reader.peek() == '-') {
+							take();
+						}
+						while (is_digit(p_reader.peek())) {
+							take();
+						}
+					}
+					num[len] = 0;
+					if (too_long) {
+						r_err_str = "Number is too long";
+						return ERR_PARSE_ERROR;
+					}
+
+					r_token.type = TK_NUMBER;
+					r_token.value = String::to_float(num);
+					return OK;
+
+				} else if (is_ascii_char(c)) {
+					String id;
+					while (is_ascii_char(p_reader.peek())) {
+						id += char32_t(p_reader.get());
+					}
+
+					r_token.type = TK_IDENTIFIER;
+					r_token.value = id;
+					return OK;
+				} else {
+					r_err_str = "Unexpected character.";
+					return ERR_PARSE_ERROR;
+				}
+			}
+		}
+	}
+}
+
+Error JSON::_parse_stream(StreamReader &p_reader, StreamHandler *p_handler, int &line, String &r_err_str) {
+	enum State {
+		STATE_VALUE,
+		STATE_ARRAY_VALUE_OR_END,
+		STATE_ARRAY_COMMA_OR_END,
+		STATE_OBJECT_KEY_OR_END,
+		STATE_OBJECT_COLON,
+		STATE_OBJECT_COMMA_OR_END,
+		STATE_DONE,
+	};
+
+	// Explicit stack of open containers (true for objects), so that nesting depth
+	// doesn't consume native stack.
+	LocalVector<bool> stack;
+	State state = STATE_VALUE;
+	Token token;
+
+	while (true) {
+		Error err = _get_stream_token(p_reader, token, line, r_err_str);
+		if (err != OK) {
+			return err;
+		}
+
+		bool closed = false;
+
+		switch (state) {
+			case STATE_DONE: {
+				if (token.type != TK_EOF) {
+					r_err_str = "Expected 'EOF'";
+					return ERR_PARSE_ERROR;
+				}
+				return OK;
+			}
+			case STATE_OBJECT_KEY_OR_END: {
+				if (token.type == TK_CURLY_BRACKET_CLOSE) {
+					closed = true;
+					break;
+				}
+				if (token.type == TK_EOF) {
+					r_err_str = "Expected '}'";
+					return ERR_PARSE_ERROR;
+				}
+				if (token.type != TK_STRING) {
+					r_err_str = "Expected key";
+					return ERR_PARSE_ERROR;
+				}
+				err = p_handler->key(token.value);
+				if (err != OK) {
+					return err;
+				}
+				state = STATE_OBJECT_COLON;
+				continue;
+			}
+			case STATE_OBJECT_COLON: {
+				if (token.type != TK_COLON) {
+					r_err_str = "Expected ':'";
+					return ERR_PARSE_ERROR;
+				}
+				state = STATE_VALUE;
+				continue;
+			}
+			case STATE_OBJECT_COMMA_OR_END: {
+				if (token.type == TK_CURLY_BRACKET_CLOSE) {
+					closed = true;
+					break;
+				}
+				if (token.type != TK_COMMA) {
+					r_err_str = "Expected '}' or ','";
+					return ERR_PARSE_ERROR;
+				}
+				state = STATE_OBJECT_KEY_OR_END;
+				continue;
+			}
+			case STATE_ARRAY_COMMA_OR_END: {
+				if (token.type == TK_BRACKET_CLOSE) {
+					closed = true;
+					break;
+				}
+				if (token.type != TK_COMMA) {
+					r_err_str = token.type == TK_EOF ? "Expected ']'" : "Expected ','";
+					return ERR_PARSE_ERROR;
+				}
+				state = STATE_ARRAY_VALUE_OR_END;
+				continue;
+			}
+			case STATE_ARRAY_VALUE_OR_END: {
+				if (token.type == TK_BRACKET_CLOSE) {
+					closed = true;
+					break;
+				}
+				[[fallthrough]];
+			}
+			case STATE_VALUE: {
+				if (token.type == TK_EOF && !stack.is_empty()) {
+					// parse() runs out of input in the container loop, so report the same.
+					r_err_str = stack[stack.size() - 1] ? "Expected '}'" : "Expected ']'";
+					return ERR_PARSE_ERROR;
+				}
+				if (token.type == TK_CURLY_BRACKET_OPEN) {
+					err = p_handler->begin_object();
+					stack.push_back(true);
+					state = STATE_OBJECT_KEY_OR_END;
+				} else if (token.type == TK_BRACKET_OPEN) {
+					err = p_handler->begin_array();
+					stack.push_back(false);
+					state = STATE_ARRAY_VALUE_OR_END;
+				} else if (token.type == TK_IDENTIFIER) {
+					String id = token.value;
+					if (id == "true") {
+						err = p_handler->value(true);
+					} else if (id == "false") {
+						err = p_handler->value(false);
+					} else if (id == "null") {
+						err = p_handler->value(Variant());
+					} else {
+						r_err_str = "Expected 'true','false' or 'null', got '" + id + "'.";
+						return ERR_PARSE_ERROR;
+					}
+					closed = true; // A scalar completes immediately.
+				} else if (token.type == TK_NUMBER || token.type == TK_STRING) {
+					err = p_handler->value(token.value);
+					closed = true;
+				} else {
+					r_err_str = "Expected value, got " + String(tk_name[token.type]) + ".";
+					return ERR_PARSE_ERROR;
+				}
+				if (err != OK) {
+					return err;
+				}
+				if (!closed) {
+					continue;
+				}
+				// The scalar doesn't close a container, only move on to what follows it.
+				state = stack.is_empty() ? STATE_DONE : (stack[stack.size() - 1] ? STATE_OBJECT_COMMA_OR_END : STATE_ARRAY_COMMA_OR_END);
+				continue;
+			}
+		}
+
+		if (closed) {
+			bool is_object = stack[stack.size() - 1];
+			stack.resize(stack.size() - 1);
+			err = is_object ? p_handler->end_object() : p_handler->end_array();
+			if (err != OK) {
+				return err;
+			}
+			state = stack.is_empty() ? STATE_DONE : (stack[stack.size() - 1] ? STATE_OBJECT_COMMA_OR_END : STATE_ARRAY_COMMA_OR_END);
+		}
+	}
+}
+
+// Builds the same Variant as parse() from the stream events.
+class JSONStreamDataBuilder : public JSON::StreamHandler {
+	LocalVector<Variant> stack;
+	String last_key;
+
+	void _add(const Variant &p_value) {
+		if (stack.is_empty()) {
+			data = p_value;
+		} else if (stack[stack.size() - 1].get_type() == Variant::ARRAY) {
+			Array array = stack[stack.size() - 1];
+			array.push_back(p_value);
+		} else {
+			Dictionary object = stack[stack.size() - 1];
+			object[last_key] = p_value;
+		}
+	}
+
+public:
+	Variant data;
+
+	virtual Error begin_object() override {
+		Dictionary object;
+		_add(object);
+		stack.push_back(object);
+		return OK;
+	}
+	virtual Error end_object() override {
+		stack.resize(stack.size() - 1);
+		return OK;
+	}
+	virtual Error begin_array() override {
+		Array array;
+		_add(array);
+		stack.push_back(array);
+		return OK;
+	}
+	virtual Error end_array() override {
+		stack.resize(stack.size() - 1);
+		return OK;
+	}
+	virtual Error key(const String &p_key) override {
+		last_key = p_key;
+		return OK;
+	}
+	virtual Error value(const Variant &p_value) override {
+		_add(p_value);
+		return OK;
+	}
+};
+
+Error JSON::parse_stream(Ref<FileAccess> p_file, StreamHandler *p_handler) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+
+	data = Variant();
+	err_str = String();
+
+	StreamReader reader;
+	reader.f = p_file;
+	reader.buffer.resize(65536);
+
+	// Skip the UTF-8 byte order mark, if any.
+	if (reader.peek() == 0xEF && reader.size >= 3 && reader.buffer[1] == 0xBB && reader.buffer[2] == 0xBF) {
+		reader.pos = 3;
+	}
+
+	JSONStreamDataBuilder builder;
+	int line = 0;
+	Error err = _parse_stream(reader, p_handler ? p_handler : &builder, line, err_str);
+	err_line = err == OK ? 0 : line;
+	if (err == OK && !p_handler) {
+		data = builder.data;
+	}
+	return err;
+}
+
+Error JSON::_parse_stream_bind(Ref<FileAccess> p_file) {
+	return parse_stream(p_file);
+}
+
 String JSON::stringify(const Variant &p_var, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
-	Ref<JSON> jason;
-	jason.instantiate();
+	// Collect the pieces and concatenate them once at the end, rather than building
+	// and copying intermediate strings at every nesting level.
+	StringBuilder builder;
 	HashSet<const void *> markers;
-	return jason->_stringify(p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	_stringify(builder, p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	return builder.as_string();
 }
 
 Variant JSON::parse_string(const String &p_json_string) {
@@ -555,6 +1093,7 @@ void JSON::_bind_methods() {
 	ClassDB::bind_static_method("JSON", D_METHOD("stringify", "data", "indent", "sort_keys", "full_precision"), &JSON::stringify, DEFVAL(""), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_static_method("JSON", D_METHOD("parse_string", "json_string"), &JSON::parse_string);
 	ClassDB::bind_method(D_METHOD("parse", "json_string"), &JSON::parse);
+	ClassDB::bind_method(D_METHOD("parse_stream", "file"), &JSON::_parse_stream_bind);
 
 	ClassDB::bind_method(D_METHOD("get_data"), &JSON::get_data);
 	ClassDB::bind_method(D_METHOD("get_error_line"), &JSON::get_error_line);
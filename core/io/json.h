@@ -31,9 +31,12 @@
 #ifndef JSON_H
 #define JSON_H
 
+#include "core/io/file_access.h"
 #include "core/object/ref_counted.h"
 #include "core/variant/variant.h"
 
+class StringBuilder;
+
 class JSON : public RefCounted {
 	GDCLASS(JSON, RefCounted);
 
@@ -69,8 +72,8 @@ class JSON : public RefCounted {
 
 	static const char *tk_name[];
 
-	static String _make_indent(const String &p_indent, int p_size);
-	static String _stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision = false);
+	static void _add_indent(StringBuilder &r_builder, const String &p_indent, int p_size);
+	static void _stringify(StringBuilder &r_builder, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision = false);
 	static Error _get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
 	static Error _parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str);
 	static Error _parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str);
@@ -80,8 +83,33 @@ class JSON : public RefCounted {
 protected:
 	static void _bind_methods();
 
+public:
+	// Receives the events emitted by parse_stream(). Returning an error from any of
+	// the callbacks aborts parsing with that error.
+	class StreamHandler {
+	public:
+		virtual Error begin_object() { return OK; }
+		virtual Error end_object() { return OK; }
+		virtual Error begin_array() { return OK; }
+		virtual Error end_array() { return OK; }
+		virtual Error key(const String &p_key) { return OK; }
+		virtual Error value(const Variant &p_value) { return OK; } // null, bool, number or string.
+
+		virtual ~StreamHandler() {}
+	};
+
+private:
+	struct StreamReader;
+	static Error _get_stream_hex(StreamReader &p_reader, char32_t &r_value, String &r_err_str);
+	static Error _get_stream_token(StreamReader &p_reader, Token &r_token, int &line, String &r_err_str);
+	static Error _parse_stream(StreamReader &p_reader, StreamHandler *p_handler, int &line, String &r_err_str);
+
+	Error _parse_stream_bind(Ref<FileAccess> p_file);
+
 public:
 	Error parse(const String &p_json_string);
+	// Without a handler, the parsed value is stored like parse() does.
+	Error parse_stream(Ref<FileAccess> p_file, StreamHandler *p_handler = nullptr);
 	static String stringify(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
 	static Variant parse_string(const String &p_json_string);
 
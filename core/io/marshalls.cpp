@@ -33,7 +33,10 @@
 #include "core/object/ref_counted.h"
 #include "core/os/keyboard.h"
 #include "core/string/print_string.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 
+#include <float.h>
 #include <limits.h>
 #include <stdio.h>
 
@@ -788,10 +791,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -1813,3 +1813,869 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 	return OK;
 }
+
+// Compact codec.
+//
+// Every value starts with a single byte holding the Variant type in the low bits and
+// codec specific flags in the high bits. Integers and lengths are LEB128 varints (signed
+// values zigzag-encoded), floats are stored in single precision whenever that is lossless,
+// and strings (including StringNames, NodePaths and Dictionary keys) are interned in a
+// per-message table: the first occurrence is written inline and later ones as an index.
+// Types that have no compact form (objects, RIDs, callables and signals) embed the
+// regular encoding.
+
+enum {
+	COMPACT_TYPE_MASK = 0x3F,
+	COMPACT_FLAG = 1 << 6, // Boolean value, double precision floats or string table reference, depending on the type.
+};
+
+static_assert(Variant::VARIANT_MAX <= COMPACT_TYPE_MASK + 1, "Variant types no longer fit in the compact codec header.");
+
+struct VariantCompactEncoder {
+	LocalVector<uint8_t> &buffer;
+	HashMap<String, uint32_t> strings;
+	bool full_objects = false;
+
+	VariantCompactEncoder(LocalVector<uint8_t> &r_buffer) :
+			buffer(r_buffer) {}
+
+	_FORCE_INLINE_ void put_u8(uint8_t p_value) {
+		buffer.push_back(p_value);
+	}
+
+	void put_bytes(const uint8_t *p_data, uint32_t p_size) {
+		uint32_t ofs = buffer.size();
+		buffer.resize(ofs + p_size);
+		if (p_size) {
+			memcpy(&buffer[ofs], p_data, p_size);
+		}
+	}
+
+	void put_varint(uint64_t p_value) {
+		while (p_value >= 0x80) {
+			put_u8(uint8_t(p_value) | 0x80);
+			p_value >>= 7;
+		}
+		put_u8(uint8_t(p_value));
+	}
+
+	_FORCE_INLINE_ void put_svarint(int64_t p_value) {
+		put_varint((uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63));
+	}
+
+	void put_float(float p_value) {
+		uint8_t b[4];
+		encode_float(p_value, b);
+		put_bytes(b, 4);
+	}
+
+	void put_double(double p_value) {
+		uint8_t b[8];
+		encode_double(p_value, b);
+		put_bytes(b, 8);
+	}
+
+	_FORCE_INLINE_ void put_real(real_t p_value) {
+#ifdef REAL_T_IS_DOUBLE
+		put_double(p_value);
+#else
+		put_float(p_value);
+#endif
+	}
+
+	_FORCE_INLINE_ uint8_t real_header(Variant::Type p_type) const {
+#ifdef REAL_T_IS_DOUBLE
+		return p_type | COMPACT_FLAG;
+#else
+		return p_type;
+#endif
+	}
+
+	void put_string(Variant::Type p_type, const String &p_string) {
+		HashMap<String, uint32_t>::Iterator E = strings.find(p_string);
+		if (E) {
+			put_u8(p_type | COMPACT_FLAG);
+			put_varint(E->value);
+			return;
+		}
+
+		strings.insert(p_string, strings.size());
+
+		CharString utf8 = p_string.utf8();
+		put_u8(p_type);
+		put_varint(utf8.length());
+		put_bytes((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	Error put_variant(const Variant &p_variant, int p_depth);
+};
+
+Error VariantCompactEncoder::put_variant(const Variant &p_variant, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+
+	Variant::Type type = p_variant.get_type();
+
+	switch (type) {
+		case Variant::NIL: {
+			put_u8(type);
+		} break;
+		case Variant::BOOL: {
+			put_u8(bool(p_variant) ? (type | COMPACT_FLAG) : type);
+		} break;
+		case Variant::INT: {
+			put_u8(type);
+			put_svarint(p_variant);
+		} break;
+		case Variant::FLOAT: {
+			double d = p_variant;
+			// Converting a finite double outside the float range is undefined, so check first.
+			if (Math::is_inf(d) || (d >= -FLT_MAX && d <= FLT_MAX && double(float(d)) == d)) {
+				put_u8(type);
+				put_float(float(d));
+			} else {
+				put_u8(type | COMPACT_FLAG);
+				put_double(d);
+			}
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME:
+		case Variant::NODE_PATH: {
+			put_string(type, p_variant);
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v = p_variant;
+			put_u8(real_header(type));
+			put_real(v.x);
+			put_real(v.y);
+		} break;
+		case Variant::VECTOR2I: {
+			Vector2i v = p_variant;
+			put_u8(type);
+			put_svarint(v.x);
+			put_svarint(v.y);
+		} break;
+		case Variant::RECT2: {
+			Rect2 r = p_variant;
+			put_u8(real_header(type));
+			put_real(r.position.x);
+			put_real(r.position.y);
+			put_real(r.size.x);
+			put_real(r.size.y);
+		} break;
+		case Variant::RECT2I: {
+			Rect2i r = p_variant;
+			put_u8(type);
+			put_svarint(r.position.x);
+			put_svarint(r.position.y);
+			put_svarint(r.size.x);
+			put_svarint(r.size.y);
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = p_variant;
+			put_u8(real_header(type));
+			for (int i = 0; i < 3; i++) {
+				put_real(v.coord[i]);
+			}
+		} break;
+		case Variant::VECTOR3I: {
+			Vector3i v = p_variant;
+			put_u8(type);
+			for (int i = 0; i < 3; i++) {
+				put_svarint(v.coord[i]);
+			}
+		} break;
+		case Variant::TRANSFORM2D: {
+			Transform2D t = p_variant;
+			put_u8(real_header(type));
+			for (int i = 0; i < 3; i++) {
+				put_real(t.columns[i].x);
+				put_real(t.columns[i].y);
+			}
+		} break;
+		case Variant::VECTOR4: {
+			Vector4 v = p_variant;
+			put_u8(real_header(type));
+			for (int i = 0; i < 4; i++) {
+				put_real(v.components[i]);
+			}
+		} break;
+		case Variant::VECTOR4I: {
+			Vector4i v = p_variant;
+			put_u8(type);
+			for (int i = 0; i < 4; i++) {
+				put_svarint(v.coord[i]);
+			}
+		} break;
+		case Variant::PLANE: {
+			Plane p = p_variant;
+			put_u8(real_header(type));
+			for (int i = 0; i < 3; i++) {
+				put_real(p.normal.coord[i]);
+			}
+			put_real(p.d);
+		} break;
+		case Variant::QUATERNION: {
+			Quaternion q = p_variant;
+			put_u8(real_header(type));
+			for (int i = 0; i < 4; i++) {
+				put_real(q.components[i]);
+			}
+		} break;
+		case Variant::AABB: {
+			::AABB aabb = p_variant;
+			put_u8(real_header(type));
+			for (int i = 0; i < 3; i++) {
+				put_real(aabb.position.coord[i]);
+			}
+			for (int i = 0; i < 3; i++) {
+				put_real(aabb.size.coord[i]);
+			}
+		} break;
+		case Variant::BASIS: {
+			Basis b = p_variant;
+			put_u8(real_header(type));
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					put_real(b.rows[i][j]);
+				}
+			}
+		} break;
+		case Variant::TRANSFORM3D: {
+			Transform3D t = p_variant;
+			put_u8(real_header(type));
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					put_real(t.basis.rows[i][j]);
+				}
+			}
+			for (int i = 0; i < 3; i++) {
+				put_real(t.origin.coord[i]);
+			}
+		} break;
+		case Variant::PROJECTION: {
+			Projection p = p_variant;
+			put_u8(real_header(type));
+			for (int i = 0; i < 4; i++) {
+				for (int j = 0; j < 4; j++) {
+					put_real(p.matrix[i][j]);
+				}
+			}
+		} break;
+		case Variant::COLOR: {
+			Color c = p_variant;
+			put_u8(type);
+			for (int i = 0; i < 4; i++) {
+				put_float(c.components[i]); // Colors should always be in single-precision.
+			}
+		} break;
+		case Variant::RID:
+		case Variant::OBJECT:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			int len = 0;
+			Error err = encode_variant(p_variant, nullptr, len, full_objects, p_depth);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			put_u8(type);
+			put_varint(len);
+			uint32_t ofs = buffer.size();
+			buffer.resize(ofs + len);
+			err = encode_variant(p_variant, &buffer[ofs], len, full_objects, p_depth);
+			ERR_FAIL_COND_V(err != OK, err);
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary d = p_variant;
+			put_u8(type);
+			put_varint(d.size());
+
+			List<Variant> keys;
+			d.get_key_list(&keys);
+			for (const Variant &E : keys) {
+				Error err = put_variant(E, p_depth + 1);
+				ERR_FAIL_COND_V(err != OK, err);
+				err = put_variant(d[E], p_depth + 1);
+				ERR_FAIL_COND_V(err != OK, err);
+			}
+		} break;
+		case Variant::ARRAY: {
+			Array a = p_variant;
+			put_u8(type);
+			put_varint(a.size());
+			for (int i = 0; i < a.size(); i++) {
+				Error err = put_variant(a[i], p_depth + 1);
+				ERR_FAIL_COND_V(err != OK, err);
+			}
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			Vector<uint8_t> data = p_variant;
+			put_u8(type);
+			put_varint(data.size());
+			put_bytes(data.ptr(), data.size());
+		} break;
+		case Variant::PACKED_INT32_ARRAY: {
+			Vector<int32_t> data = p_variant;
+			put_u8(type);
+			put_varint(data.size());
+			uint32_t ofs = buffer.size();
+			buffer.resize(ofs + data.size() * 4);
+			for (int i = 0; i < data.size(); i++) {
+				encode_uint32(data[i], &buffer[ofs + i * 4]);
+			}
+		} break;
+		case Variant::PACKED_INT64_ARRAY: {
+			Vector<int64_t> data = p_variant;
+			put_u8(type);
+			put_varint(data.size());
+			uint32_t ofs = buffer.size();
+			buffer.resize(ofs + data.size() * 8);
+			for (int i = 0; i < data.size(); i++) {
+				encode_uint64(data[i], &buffer[ofs + i * 8]);
+			}
+		} break;
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			Vector<float> data = p_variant;
+			put_u8(type);
+			put_varint(data.size());
+			uint32_t ofs = buffer.size();
+			buffer.resize(ofs + data.size() * 4);
+			for (int i = 0; i < data.size(); i++) {
+				encode_float(data[i], &buffer[ofs + i * 4]);
+			}
+		} break;
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			Vector<double> data = p_variant;
+			put_u8(type);
+			put_varint(data.size());
+			uint32_t ofs = buffer.size();
+			buffer.resize(ofs + data.size() * 8);
+			for (int i = 0; i < data.size(); i++) {
+				encode_double(data[i], &buffer[ofs + i * 8]);
+			}
+		} break;
+		case Variant::PACKED_STRING_ARRAY: {
+			Vector<String> data = p_variant;
+			put_u8(type);
+			put_varint(data.size());
+			for (int i = 0; i < data.size(); i++) {
+				put_string(Variant::STRING, data[i]);
+			}
+		} break;
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			Vector<Vector2> data = p_variant;
+			put_u8(real_header(type));
+			put_varint(data.size());
+			for (int i = 0; i < data.size(); i++) {
+				put_real(data[i].x);
+				put_real(data[i].y);
+			}
+		} break;
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			Vector<Vector3> data = p_variant;
+			put_u8(real_header(type));
+			put_varint(data.size());
+			for (int i = 0; i < data.size(); i++) {
+				for (int j = 0; j < 3; j++) {
+					put_real(data[i].coord[j]);
+				}
+			}
+		} break;
+		case Variant::PACKED_COLOR_ARRAY: {
+			Vector<Color> data = p_variant;
+			put_u8(type);
+			put_varint(data.size());
+			for (int i = 0; i < data.size(); i++) {
+				for (int j = 0; j < 4; j++) {
+					put_float(data[i].components[j]);
+				}
+			}
+		} break;
+		default: {
+			ERR_FAIL_V(ERR_BUG);
+		}
+	}
+
+	return OK;
+}
+
+struct VariantCompactDecoder {
+	const uint8_t *buf = nullptr;
+	int len = 0;
+	int pos = 0;
+	LocalVector<String> strings;
+	bool allow_objects = false;
+
+	_FORCE_INLINE_ Error get_u8(uint8_t &r_value) {
+		ERR_FAIL_COND_V(pos >= len, ERR_INVALID_DATA);
+		r_value = buf[pos++];
+		return OK;
+	}
+
+	Error get_varint(uint64_t &r_value) {
+		r_value = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			uint8_t b;
+			Error err = get_u8(b);
+			ERR_FAIL_COND_V(err != OK, err);
+			r_value |= uint64_t(b & 0x7F) << shift;
+			if (!(b & 0x80)) {
+				return OK;
+			}
+		}
+		ERR_FAIL_V(ERR_INVALID_DATA);
+	}
+
+	Error get_svarint(int64_t &r_value) {
+		uint64_t u;
+		Error err = get_varint(u);
+		r_value = int64_t(u >> 1) ^ -int64_t(u & 1);
+		return err;
+	}
+
+	// Element counts are bounded by the remaining bytes, so malformed input can't request huge allocations.
+	Error get_count(int p_min_element_size, int &r_count) {
+		uint64_t count;
+		Error err = get_varint(count);
+		ERR_FAIL_COND_V(err != OK, err);
+		ERR_FAIL_COND_V(count > uint64_t(len - pos) / p_min_element_size, ERR_INVALID_DATA);
+		r_count = count;
+		return OK;
+	}
+
+	Error get_int(int32_t &r_value) {
+		int64_t v;
+		Error err = get_svarint(v);
+		ERR_FAIL_COND_V(err != OK, err);
+		ERR_FAIL_COND_V(v < INT32_MIN || v > INT32_MAX, ERR_INVALID_DATA);
+		r_value = v;
+		return OK;
+	}
+
+	Error get_float(float &r_value) {
+		ERR_FAIL_COND_V(len - pos < 4, ERR_INVALID_DATA);
+		r_value = decode_float(&buf[pos]);
+		pos += 4;
+		return OK;
+	}
+
+	Error get_double(double &r_value) {
+		ERR_FAIL_COND_V(len - pos < 8, ERR_INVALID_DATA);
+		r_value = decode_double(&buf[pos]);
+		pos += 8;
+		return OK;
+	}
+
+	Error get_reals(bool p_double, real_t *r_values, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			if (p_double) {
+				double d;
+				Error err = get_double(d);
+				ERR_FAIL_COND_V(err != OK, err);
+#ifndef REAL_T_IS_DOUBLE
+				// Doubles from a double precision build may not fit, and converting them would be undefined.
+				if (!Math::is_nan(d) && !Math::is_inf(d)) {
+					d = CLAMP(d, -FLT_MAX, FLT_MAX);
+				}
+#endif
+				r_values[i] = d;
+			} else {
+				float f;
+				Error err = get_float(f);
+				ERR_FAIL_COND_V(err != OK, err);
+				r_values[i] = f;
+			}
+		}
+		return OK;
+	}
+
+	Error get_string(uint8_t p_header, String &r_string) {
+		if (p_header & COMPACT_FLAG) {
+			uint64_t idx;
+			Error err = get_varint(idx);
+			ERR_FAIL_COND_V(err != OK, err);
+			ERR_FAIL_COND_V(idx >= strings.size(), ERR_INVALID_DATA);
+			r_string = strings[idx];
+			return OK;
+		}
+
+		int size;
+		Error err = get_count(1, size);
+		ERR_FAIL_COND_V(err != OK, err);
+		r_string = String();
+		r_string.parse_utf8((const char *)&buf[pos], size);
+		pos += size;
+		strings.push_back(r_string);
+		return OK;
+	}
+
+	Error get_variant(Variant &r_variant, int p_depth);
+};
+
+Error VariantCompactDecoder::get_variant(Variant &r_variant, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Variant is too deep. Bailing.");
+
+	uint8_t header;
+	Error err = get_u8(header);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	const bool flag = header & COMPACT_FLAG;
+	const uint32_t type = header & COMPACT_TYPE_MASK;
+	ERR_FAIL_COND_V(type >= Variant::VARIANT_MAX, ERR_INVALID_DATA);
+
+	switch (type) {
+		case Variant::NIL: {
+			r_variant = Variant();
+		} break;
+		case Variant::BOOL: {
+			r_variant = flag;
+		} break;
+		case Variant::INT: {
+			int64_t v;
+			err = get_svarint(v);
+			r_variant = v;
+		} break;
+		case Variant::FLOAT: {
+			if (flag) {
+				double d;
+				err = get_double(d);
+				r_variant = d;
+			} else {
+				float f;
+				err = get_float(f);
+				r_variant = f;
+			}
+		} break;
+		case Variant::STRING: {
+			String s;
+			err = get_string(header, s);
+			r_variant = s;
+		} break;
+		case Variant::STRING_NAME: {
+			String s;
+			err = get_string(header, s);
+			r_variant = StringName(s);
+		} break;
+		case Variant::NODE_PATH: {
+			String s;
+			err = get_string(header, s);
+			r_variant = NodePath(s);
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v;
+			err = get_reals(flag, v.coord, 2);
+			r_variant = v;
+		} break;
+		case Variant::VECTOR2I: {
+			Vector2i v;
+			for (int i = 0; i < 2 && err == OK; i++) {
+				err = get_int(v.coord[i]);
+			}
+			r_variant = v;
+		} break;
+		case Variant::RECT2: {
+			real_t v[4];
+			err = get_reals(flag, v, 4);
+			r_variant = Rect2(v[0], v[1], v[2], v[3]);
+		} break;
+		case Variant::RECT2I: {
+			int32_t v[4] = {};
+			for (int i = 0; i < 4 && err == OK; i++) {
+				err = get_int(v[i]);
+			}
+			r_variant = Rect2i(v[0], v[1], v[2], v[3]);
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v;
+			err = get_reals(flag, v.coord, 3);
+			r_variant = v;
+		} break;
+		case Variant::VECTOR3I: {
+			Vector3i v;
+			for (int i = 0; i < 3 && err == OK; i++) {
+				err = get_int(v.coord[i]);
+			}
+			r_variant = v;
+		} break;
+		case Variant::TRANSFORM2D: {
+			Transform2D t;
+			for (int i = 0; i < 3 && err == OK; i++) {
+				err = get_reals(flag, t.columns[i].coord, 2);
+			}
+			r_variant = t;
+		} break;
+		case Variant::VECTOR4: {
+			Vector4 v;
+			err = get_reals(flag, v.components, 4);
+			r_variant = v;
+		} break;
+		case Variant::VECTOR4I: {
+			Vector4i v;
+			for (int i = 0; i < 4 && err == OK; i++) {
+				err = get_int(v.coord[i]);
+			}
+			r_variant = v;
+		} break;
+		case Variant::PLANE: {
+			real_t v[4];
+			err = get_reals(flag, v, 4);
+			r_variant = Plane(v[0], v[1], v[2], v[3]);
+		} break;
+		case Variant::QUATERNION: {
+			Quaternion q;
+			err = get_reals(flag, q.components, 4);
+			r_variant = q;
+		} break;
+		case Variant::AABB: {
+			::AABB aabb;
+			err = get_reals(flag, aabb.position.coord, 3);
+			if (err == OK) {
+				err = get_reals(flag, aabb.size.coord, 3);
+			}
+			r_variant = aabb;
+		} break;
+		case Variant::BASIS: {
+			Basis b;
+			for (int i = 0; i < 3 && err == OK; i++) {
+				err = get_reals(flag, b.rows[i].coord, 3);
+			}
+			r_variant = b;
+		} break;
+		case Variant::TRANSFORM3D: {
+			Transform3D t;
+			for (int i = 0; i < 3 && err == OK; i++) {
+				err = get_reals(flag, t.basis.rows[i].coord, 3);
+			}
+			if (err == OK) {
+				err = get_reals(flag, t.origin.coord, 3);
+			}
+			r_variant = t;
+		} break;
+		case Variant::PROJECTION: {
+			Projection p;
+			for (int i = 0; i < 4 && err == OK; i++) {
+				err = get_reals(flag, p.matrix[i].components, 4);
+			}
+			r_variant = p;
+		} break;
+		case Variant::COLOR: {
+			Color c;
+			for (int i = 0; i < 4 && err == OK; i++) {
+				err = get_float(c.components[i]);
+			}
+			r_variant = c;
+		} break;
+		case Variant::RID:
+		case Variant::OBJECT:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			int size;
+			err = get_count(1, size);
+			ERR_FAIL_COND_V(err != OK, err);
+			err = decode_variant(r_variant, &buf[pos], size, nullptr, allow_objects, p_depth);
+			pos += size;
+		} break;
+		case Variant::DICTIONARY: {
+			int count;
+			err = get_count(2, count);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			Dictionary d;
+			for (int i = 0; i < count; i++) {
+				Variant key;
+				err = get_variant(key, p_depth + 1);
+				ERR_FAIL_COND_V(err != OK, err);
+				Variant value;
+				err = get_variant(value, p_depth + 1);
+				ERR_FAIL_COND_V(err != OK, err);
+				d[key] = value;
+			}
+			r_variant = d;
+		} break;
+		case Variant::ARRAY: {
+			int count;
+			err = get_count(1, count);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			Array a;
+			a.resize(count);
+			for (int i = 0; i < count; i++) {
+				err = get_variant(a[i], p_depth + 1);
+				ERR_FAIL_COND_V(err != OK, err);
+			}
+			r_variant = a;
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			int count;
+			err = get_count(1, count);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			Vector<uint8_t> data;
+			data.resize(count);
+			if (count) {
+				memcpy(data.ptrw(), &buf[pos], count);
+			}
+			pos += count;
+			r_variant = data;
+		} break;
+		case Variant::PACKED_INT32_ARRAY: {
+			int count;
+			err = get_count(4, count);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			Vector<int32_t> data;
+			data.resize(count);
+			int32_t *w = data.ptrw();
+			for (int i = 0; i < count; i++) {
+				w[i] = decode_uint32(&buf[pos + i * 4]);
+			}
+			pos += count * 4;
+			r_variant = data;
+		} break;
+		case Variant::PACKED_INT64_ARRAY: {
+			int count;
+			err = get_count(8, count);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			Vector<int64_t> data;
+			data.resize(count);
+			int64_t *w = data.ptrw();
+			for (int i = 0; i < count; i++) {
+				w[i] = decode_uint64(&buf[pos + i * 8]);
+			}
+			pos += count * 8;
+			r_variant = data;
+		} break;
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			int count;
+			err = get_count(4, count);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			Vector<float> data;
+			data.resize(count);
+			float *w = data.ptrw();
+			for (int i = 0; i < count; i++) {
+				w[i] = decode_float(&buf[pos + i * 4]);
+			}
+			pos += count * 4;
+			r_variant = data;
+		} break;
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			int count;
+			err = get_count(8, count);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			Vector<double> data;
+			data.resize(count);
+			double *w = data.ptrw();
+			for (int i = 0; i < count; i++) {
+				w[i] = decode_double(&buf[pos + i * 8]);
+			}
+			pos += count * 8;
+			r_variant = data;
+		} break;
+		case Variant::PACKED_STRING_ARRAY: {
+			int count;
+			err = get_count(2, count);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			Vector<String> data;
+			data.resize(count);
+			String *w = data.ptrw();
+			for (int i = 0; i < count; i++) {
+				uint8_t string_header;
+				err = get_u8(string_header);
+				ERR_FAIL_COND_V(err != OK, err);
+				ERR_FAIL_COND_V((string_header & COMPACT_TYPE_MASK) != Variant::STRING, ERR_INVALID_DATA);
+				err = get_string(string_header, w[i]);
+				ERR_FAIL_COND_V(err != OK, err);
+			}
+			r_variant = data;
+		} break;
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			int count;
+			err = get_count(flag ? 16 : 8, count);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			Vector<Vector2> data;
+			data.resize(count);
+			Vector2 *w = data.ptrw();
+			for (int i = 0; i < count && err == OK; i++) {
+				err = get_reals(flag, w[i].coord, 2);
+			}
+			r_variant = data;
+		} break;
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			int count;
+			err = get_count(flag ? 24 : 12, count);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			Vector<Vector3> data;
+			data.resize(count);
+			Vector3 *w = data.ptrw();
+			for (int i = 0; i < count && err == OK; i++) {
+				err = get_reals(flag, w[i].coord, 3);
+			}
+			r_variant = data;
+		} break;
+		case Variant::PACKED_COLOR_ARRAY: {
+			int count;
+			err = get_count(16, count);
+			ERR_FAIL_COND_V(err != OK, err);
+
+			Vector<Color> data;
+			data.resize(count);
+			Color *w = data.ptrw();
+			for (int i = 0; i < count; i++) {
+				for (int j = 0; j < 4; j++) {
+					w[i].components[j] = decode_float(&buf[pos + (i * 4 + j) * 4]);
+				}
+			}
+			pos += count * 16;
+			r_variant = data;
+		} break;
+		default: {
+			ERR_FAIL_V(ERR_BUG);
+		}
+	}
+
+	ERR_FAIL_COND_V(err != OK, err);
+	return OK;
+}
+
+Error encode_variant_compact(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects) {
+	// Only clear, so callers encoding repeatedly keep the allocation.
+	r_buffer.clear();
+
+	VariantCompactEncoder encoder(r_buffer);
+	encoder.full_objects = p_full_objects;
+
+	return encoder.put_variant(p_variant, 0);
+}
+
+Error encode_variant_compact(const Variant &p_variant, Vector<uint8_t> &r_buffer, bool p_full_objects) {
+	LocalVector<uint8_t> buffer;
+	Error err = encode_variant_compact(p_variant, buffer, p_full_objects);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	r_buffer.resize(buffer.size());
+	if (buffer.size()) {
+		memcpy(r_buffer.ptrw(), buffer.ptr(), buffer.size());
+	}
+	return OK;
+}
+
+Error decode_variant_compact(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects) {
+	ERR_FAIL_COND_V(!p_buffer && p_len > 0, ERR_INVALID_PARAMETER);
+
+	VariantCompactDecoder decoder;
+	decoder.buf = p_buffer;
+	decoder.len = p_len;
+	decoder.allow_objects = p_allow_objects;
+
+	Error err = decoder.get_variant(r_variant, 0);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	if (r_len) {
+		*r_len = decoder.pos;
+	}
+	return OK;
+}
@@ -33,6 +33,7 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 #include "core/variant/variant.h"
 
@@ -215,4 +216,10 @@ public:
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
 
+// Compact alternative to the above: varints, single precision floats when lossless, and a
+// per-message string table. Not compatible with decode_variant().
+Error decode_variant_compact(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false);
+Error encode_variant_compact(const Variant &p_variant, Vector<uint8_t> &r_buffer, bool p_full_objects = false);
+Error encode_variant_compact(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects = false);
+
 #endif // MARSHALLS_H
@@ -46,6 +46,14 @@ int PacketPeer::get_encode_buffer_max_size() const {
 	return encode_buffer_max_size;
 }
 
+void PacketPeer::set_compact_var_encoding(bool p_enabled) {
+	compact_var_encoding = p_enabled;
+}
+
+bool PacketPeer::is_compact_var_encoding() const {
+	return compact_var_encoding;
+}
+
 Error PacketPeer::get_packet_buffer(Vector<uint8_t> &r_buffer) {
 	const uint8_t *buffer;
 	int buffer_size;
@@ -59,10 +67,7 @@ Error PacketPeer::get_packet_buffer(Vector<uint8_t> &r_buffer) {
 		return OK;
 	}
 
-	uint8_t *w = r_buffer.ptrw();
-	for (int i = 0; i < buffer_size; i++) {
-		w[i] = buffer[i];
-	}
+	memcpy(r_buffer.ptrw(), buffer, buffer_size);
 
 	return OK;
 }
@@ -85,10 +90,20 @@ Error PacketPeer::get_var(Variant &r_variant, bool p_allow_objects) {
 		return err;
 	}
 
+	if (compact_var_encoding) {
+		return decode_variant_compact(r_variant, buffer, buffer_size, nullptr, p_allow_objects);
+	}
 	return decode_variant(r_variant, buffer, buffer_size, nullptr, p_allow_objects);
 }
 
 Error PacketPeer::put_var(const Variant &p_packet, bool p_full_objects) {
+	if (compact_var_encoding) {
+		Error err = encode_variant_compact(p_packet, compact_encode_buffer, p_full_objects);
+		ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to encode Variant.");
+		ERR_FAIL_COND_V_MSG(compact_encode_buffer.size() > (uint32_t)encode_buffer_max_size, ERR_OUT_OF_MEMORY, "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via 'set_encode_buffer_max_size'.");
+		return put_packet(compact_encode_buffer.ptr(), compact_encode_buffer.size());
+	}
+
 	int len;
 	Error err = encode_variant(p_packet, nullptr, len, p_full_objects); // compute len first
 	if (err) {
@@ -147,7 +162,11 @@ void PacketPeer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_encode_buffer_max_size"), &PacketPeer::get_encode_buffer_max_size);
 	ClassDB::bind_method(D_METHOD("set_encode_buffer_max_size", "max_size"), &PacketPeer::set_encode_buffer_max_size);
 
+	ClassDB::bind_method(D_METHOD("set_compact_var_encoding", "enabled"), &PacketPeer::set_compact_var_encoding);
+	ClassDB::bind_method(D_METHOD("is_compact_var_encoding"), &PacketPeer::is_compact_var_encoding);
+
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "encode_buffer_max_size"), "set_encode_buffer_max_size", "get_encode_buffer_max_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compact_var_encoding"), "set_compact_var_encoding", "is_compact_var_encoding");
 }
 
 /***************/
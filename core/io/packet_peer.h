@@ -33,6 +33,7 @@
 
 #include "core/io/stream_peer.h"
 #include "core/object/class_db.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/ring_buffer.h"
 
 #include "core/extension/ext_wrappers.gen.inc"
@@ -55,6 +56,8 @@ class PacketPeer : public RefCounted {
 
 	int encode_buffer_max_size = 8 * 1024 * 1024;
 	Vector<uint8_t> encode_buffer;
+	LocalVector<uint8_t> compact_encode_buffer;
+	bool compact_var_encoding = false;
 
 public:
 	virtual int get_available_packet_count() const = 0;
@@ -74,6 +77,9 @@ public:
 	void set_encode_buffer_max_size(int p_max_size);
 	int get_encode_buffer_max_size() const;
 
+	void set_compact_var_encoding(bool p_enabled);
+	bool is_compact_var_encoding() const;
+
 	PacketPeer() {}
 	~PacketPeer() {}
 };
@@ -33,14 +33,19 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
+#include "core/templates/local_vector.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
 #define print_bl(m_what) (void)(m_what)
 
+// Larger files are parsed straight from the file, to avoid holding two copies in memory.
+#define INTERNAL_RESOURCES_BATCH_MAX_SIZE (64 * 1024 * 1024)
+
 enum {
 	//numbering must be different from variant, in case new variant types are added (variant must be always contiguous for jumptable optimization)
 	VARIANT_NIL = 1,
@@ -669,6 +674,50 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
+Ref<FileAccess> ResourceLoaderBinary::_read_internal_resources() {
+	if (internal_resources.is_empty()) {
+		return Ref<FileAccess>();
+	}
+
+	LocalVector<uint64_t> offsets;
+	offsets.resize(internal_resources.size());
+	for (int i = 0; i < internal_resources.size(); i++) {
+		offsets[i] = internal_resources[i].offset;
+	}
+	offsets.sort();
+
+	const uint64_t from = offsets[0];
+	const uint64_t to = f->get_length();
+	if (from >= to || to - from > INTERNAL_RESOURCES_BATCH_MAX_SIZE) {
+		return Ref<FileAccess>();
+	}
+
+	internal_resources_data.resize(to - from);
+	uint8_t *w = internal_resources_data.ptrw();
+
+	// One read per resource, so the file access can service them concurrently.
+	LocalVector<FileAccess::BufferRead> reads;
+	reads.resize(offsets.size());
+	for (uint32_t i = 0; i < offsets.size(); i++) {
+		FileAccess::BufferRead &r = reads[i];
+		r.position = offsets[i];
+		r.length = (i + 1 < offsets.size() ? offsets[i + 1] : to) - offsets[i];
+		r.dst = w + (offsets[i] - from);
+	}
+
+	if (f->get_buffers(reads.ptr(), reads.size()) != OK) {
+		internal_resources_data.clear();
+		return Ref<FileAccess>();
+	}
+
+	Ref<FileAccessMemory> fm;
+	fm.instantiate();
+	fm->open_custom(internal_resources_data.ptr(), internal_resources_data.size());
+	fm->set_big_endian(f->is_big_endian());
+	internal_resources_data_ofs = from;
+	return fm;
+}
+
 Error ResourceLoaderBinary::load() {
 	if (error != OK) {
 		return error;
@@ -713,6 +762,11 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	Ref<FileAccess> fm = _read_internal_resources();
+	if (fm.is_valid()) {
+		f = fm;
+	}
+
 	for (int i = 0; i < internal_resources.size(); i++) {
 		bool main = i == (internal_resources.size() - 1);
 
@@ -748,7 +802,7 @@ Error ResourceLoaderBinary::load() {
 
 		uint64_t offset = internal_resources[i].offset;
 
-		f->seek(offset);
+		f->seek(offset - internal_resources_data_ofs);
 
 		String t = get_unicode_string();
 
@@ -860,6 +914,7 @@ Error ResourceLoaderBinary::load() {
 
 		if (main) {
 			f.unref();
+			internal_resources_data.clear();
 			resource = res;
 			resource->set_as_translation_remapped(translation_remapped);
 			error = OK;
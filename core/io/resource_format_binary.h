@@ -77,6 +77,11 @@ class ResourceLoaderBinary {
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
 
+	// Internal resources are read in one batch and parsed from memory.
+	Vector<uint8_t> internal_resources_data;
+	uint64_t internal_resources_data_ofs = 0;
+	Ref<FileAccess> _read_internal_resources();
+
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
 
@@ -526,6 +526,19 @@ int StreamPeerBuffer::get_available_bytes() const {
 	return data.size() - pointer;
 }
 
+Variant StreamPeerBuffer::get_var(bool p_allow_objects) {
+	// The payload is already in memory, decode it in place instead of copying it out first.
+	int len = get_32();
+	ERR_FAIL_COND_V(len < 0 || len > data.size() - pointer, Variant());
+
+	Variant ret;
+	Error err = decode_variant(ret, data.ptr() + pointer, len, nullptr, p_allow_objects);
+	pointer += len;
+	ERR_FAIL_COND_V_MSG(err != OK, Variant(), "Error when trying to decode Variant.");
+
+	return ret;
+}
+
 void StreamPeerBuffer::seek(int p_pos) {
 	ERR_FAIL_COND(p_pos < 0);
 	ERR_FAIL_COND(p_pos > data.size());
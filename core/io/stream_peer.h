@@ -92,7 +92,7 @@ public:
 	double get_double();
 	String get_string(int p_bytes = -1);
 	String get_utf8_string(int p_bytes = -1);
-	Variant get_var(bool p_allow_objects = false);
+	virtual Variant get_var(bool p_allow_objects = false);
 
 	StreamPeer() {}
 };
@@ -137,6 +137,8 @@ public:
 
 	virtual int get_available_bytes() const override;
 
+	virtual Variant get_var(bool p_allow_objects = false) override;
+
 	void seek(int p_pos);
 	int get_size() const;
 	int get_position() const;
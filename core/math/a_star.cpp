@@ -32,6 +32,7 @@
 
 #include "core/math/geometry_3d.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 
 int64_t AStar3D::get_available_point_id() const {
 	if (points.has(last_free_id)) {
@@ -66,6 +67,7 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 		found_pt->pos = p_pos;
 		found_pt->weight_scale = p_weight_scale;
 	}
+	graph_dirty = true;
 }
 
 Vector3 AStar3D::get_point_position(int64_t p_id) const {
@@ -82,6 +84,7 @@ void AStar3D::set_point_position(int64_t p_id, const Vector3 &p_pos) {
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set point's position. Point with id: %d doesn't exist.", p_id));
 
 	p->pos = p_pos;
+	graph_dirty = true;
 }
 
 real_t AStar3D::get_point_weight_scale(int64_t p_id) const {
@@ -99,6 +102,7 @@ void AStar3D::set_point_weight_scale(int64_t p_id, real_t p_weight_scale) {
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
 
 	p->weight_scale = p_weight_scale;
+	graph_dirty = true;
 }
 
 void AStar3D::remove_point(int64_t p_id) {
@@ -125,6 +129,7 @@ void AStar3D::remove_point(int64_t p_id) {
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
+	graph_dirty = true;
 }
 
 void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
@@ -163,6 +168,7 @@ void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional
 	}
 
 	segments.insert(s);
+	graph_dirty = true;
 }
 
 void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
@@ -202,6 +208,7 @@ void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectio
 		if (s.direction != Segment::NONE) {
 			segments.insert(s);
 		}
+		graph_dirty = true;
 	}
 }
 
@@ -248,6 +255,7 @@ void AStar3D::clear() {
 	}
 	segments.clear();
 	points.clear();
+	graph_dirty = true;
 }
 
 int64_t AStar3D::get_point_count() const {
@@ -512,12 +520,226 @@ Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id) {
 	return path;
 }
 
+TypedArray<PackedInt64Array> AStar3D::get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids) {
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<PackedInt64Array>(), "Can't get id paths. The arrays of start and end points must have the same size.");
+
+	TypedArray<PackedInt64Array> paths;
+	paths.resize(p_from_ids.size());
+
+	// Scripted costs can't be called from several threads, run the queries one by one.
+	if (GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) || GDVIRTUAL_IS_OVERRIDDEN(_compute_cost)) {
+		for (int i = 0; i < p_from_ids.size(); i++) {
+			paths[i] = get_id_path(p_from_ids[i], p_to_ids[i]);
+		}
+		return paths;
+	}
+
+	// The threaded queries always use the default costs, C++ subclasses overriding them should query the paths one by one.
+	const Vector<Vector<int64_t>> results = _get_id_paths_threaded(p_from_ids, p_to_ids);
+	for (int i = 0; i < results.size(); i++) {
+		paths[i] = results[i];
+	}
+	return paths;
+}
+
+void AStar3D::_update_graph() {
+	if (!graph_dirty) {
+		return;
+	}
+
+	const uint32_t point_count = points.get_num_elements();
+	graph.indices.clear();
+	graph.indices.reserve(point_count);
+	graph.ids.resize(point_count);
+	graph.positions.resize(point_count);
+	graph.weight_scales.resize(point_count);
+	graph.enabled.resize(point_count);
+	graph.neighbour_offsets.resize(point_count + 1);
+	graph.neighbours.clear();
+
+	uint32_t index = 0;
+	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		const Point *p = *(it.value);
+		graph.indices.insert(p->id, index);
+		graph.ids[index] = p->id;
+		graph.positions[index] = p->pos;
+		graph.weight_scales[index] = p->weight_scale;
+		graph.enabled[index] = p->enabled;
+		index++;
+	}
+
+	index = 0;
+	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
+		const Point *p = *(it.value);
+		graph.neighbour_offsets[index++] = graph.neighbours.size();
+		for (OAHashMap<int64_t, Point *>::Iterator nit = p->neighbours.iter(); nit.valid; nit = p->neighbours.next_iter(nit)) {
+			graph.neighbours.push_back(graph.indices[*(nit.key)]);
+		}
+	}
+	graph.neighbour_offsets[point_count] = graph.neighbours.size();
+
+	graph_dirty = false;
+}
+
+bool AStar3D::_solve_graph(uint32_t p_begin, uint32_t p_end, QueryState &r_state) const {
+	if (!graph.enabled[p_end]) {
+		return false;
+	}
+
+	const uint32_t point_count = graph.ids.size();
+	if (r_state.g_scores.size() != point_count) {
+		r_state.g_scores.resize(point_count);
+		r_state.prev_points.resize(point_count);
+		r_state.open_passes.resize(point_count);
+		r_state.closed_passes.resize(point_count);
+		for (uint32_t i = 0; i < point_count; i++) {
+			r_state.open_passes[i] = 0;
+			r_state.closed_passes[i] = 0;
+		}
+		r_state.pass = 0;
+	}
+	r_state.pass++;
+	const uint64_t query_pass = r_state.pass;
+
+	LocalVector<OpenPoint> &open_list = r_state.open_list;
+	open_list.clear();
+	SortArray<OpenPoint, SortOpenPoints> sorter;
+
+	const Vector3 &end_pos = graph.positions[p_end];
+
+	r_state.g_scores[p_begin] = 0;
+	r_state.open_passes[p_begin] = query_pass;
+	open_list.push_back({ p_begin, 0, graph.positions[p_begin].distance_to(end_pos) });
+
+	while (!open_list.is_empty()) {
+		const OpenPoint p = open_list[0]; // The currently processed point.
+
+		if (p.index == p_end) {
+			return true;
+		}
+
+		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
+		open_list.remove_at(open_list.size() - 1);
+		if (r_state.closed_passes[p.index] == query_pass) {
+			continue; // Outdated entry, the point was reached again with a better score.
+		}
+		r_state.closed_passes[p.index] = query_pass; // Mark the point as closed.
+
+		const Vector3 &pos = graph.positions[p.index];
+		for (uint32_t i = graph.neighbour_offsets[p.index]; i < graph.neighbour_offsets[p.index + 1]; i++) {
+			const uint32_t e = graph.neighbours[i]; // The neighbour point.
+
+			if (!graph.enabled[e] || r_state.closed_passes[e] == query_pass) {
+				continue;
+			}
+
+			real_t tentative_g_score = p.g_score + pos.distance_to(graph.positions[e]) * graph.weight_scales[e];
+
+			if (r_state.open_passes[e] != query_pass) { // The point wasn't inside the open list.
+				r_state.open_passes[e] = query_pass;
+			} else if (tentative_g_score >= r_state.g_scores[e]) { // The new path is worse than the previous.
+				continue;
+			}
+
+			r_state.prev_points[e] = p.index;
+			r_state.g_scores[e] = tentative_g_score;
+
+			OpenPoint open_point = { e, tentative_g_score, tentative_g_score + graph.positions[e].distance_to(end_pos) };
+			open_list.push_back(open_point);
+			sorter.push_heap(0, open_list.size() - 1, 0, open_point, open_list.ptr());
+		}
+	}
+
+	return false;
+}
+
+Vector<int64_t> AStar3D::_get_graph_id_path(int64_t p_from_id, int64_t p_to_id, QueryState &r_state) const {
+	const uint32_t *a = graph.indices.getptr(p_from_id);
+	ERR_FAIL_COND_V_MSG(!a, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
+
+	const uint32_t *b = graph.indices.getptr(p_to_id);
+	ERR_FAIL_COND_V_MSG(!b, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
+
+	const uint32_t begin_point = *a;
+	const uint32_t end_point = *b;
+
+	if (begin_point == end_point) {
+		Vector<int64_t> ret;
+		ret.push_back(p_from_id);
+		return ret;
+	}
+
+	if (!_solve_graph(begin_point, end_point, r_state)) {
+		return Vector<int64_t>();
+	}
+
+	uint32_t p = end_point;
+	int64_t pc = 1; // Begin point
+	while (p != begin_point) {
+		pc++;
+		p = r_state.prev_points[p];
+	}
+
+	Vector<int64_t> path;
+	path.resize(pc);
+
+	{
+		int64_t *w = path.ptrw();
+
+		p = end_point;
+		int64_t idx = pc - 1;
+		while (p != begin_point) {
+			w[idx--] = graph.ids[p];
+			p = r_state.prev_points[p];
+		}
+
+		w[0] = graph.ids[p]; // Assign first
+	}
+
+	return path;
+}
+
+void AStar3D::_get_id_paths_chunk(uint32_t p_chunk, PathBatch *p_batch) {
+	QueryState state;
+	const uint32_t from = p_chunk * p_batch->chunk_size;
+	const uint32_t to = MIN(from + p_batch->chunk_size, p_batch->path_count);
+	for (uint32_t i = from; i < to; i++) {
+		p_batch->paths[i] = _get_graph_id_path(p_batch->from_ids[i], p_batch->to_ids[i], state);
+	}
+}
+
+Vector<Vector<int64_t>> AStar3D::_get_id_paths_threaded(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids) {
+	Vector<Vector<int64_t>> paths;
+	paths.resize(p_from_ids.size());
+	if (p_from_ids.is_empty()) {
+		return paths;
+	}
+
+	_update_graph();
+
+	PathBatch batch;
+	batch.from_ids = p_from_ids.ptr();
+	batch.to_ids = p_to_ids.ptr();
+	batch.paths = paths.ptrw();
+	batch.path_count = p_from_ids.size();
+
+	// Split the queries in a few chunks per thread, each chunk reuses its search state between its queries.
+	const uint32_t chunk_count = MIN(batch.path_count, uint32_t(MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * 4));
+	batch.chunk_size = (batch.path_count + chunk_count - 1) / chunk_count;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AStar3D::_get_id_paths_chunk, &batch, chunk_count, -1, true, SNAME("AStarIdPaths"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	return paths;
+}
+
 void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
 	Point *p;
 	bool p_exists = points.lookup(p_id, p);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set if point is disabled. Point with id: %d doesn't exist.", p_id));
 
 	p->enabled = !p_disabled;
+	graph_dirty = true;
 }
 
 bool AStar3D::is_point_disabled(int64_t p_id) const {
@@ -557,6 +779,7 @@ void AStar3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStar3D::get_point_path);
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStar3D::get_id_path);
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids"), &AStar3D::get_id_paths);
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -785,6 +1008,28 @@ Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id) {
 	return path;
 }
 
+TypedArray<PackedInt64Array> AStar2D::get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids) {
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<PackedInt64Array>(), "Can't get id paths. The arrays of start and end points must have the same size.");
+
+	TypedArray<PackedInt64Array> paths;
+	paths.resize(p_from_ids.size());
+
+	// Scripted costs can't be called from several threads, run the queries one by one.
+	if (GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) || GDVIRTUAL_IS_OVERRIDDEN(_compute_cost)) {
+		for (int i = 0; i < p_from_ids.size(); i++) {
+			paths[i] = get_id_path(p_from_ids[i], p_to_ids[i]);
+		}
+		return paths;
+	}
+
+	// The points are stored with a zero Z, so the default costs of AStar3D are the same.
+	const Vector<Vector<int64_t>> results = astar._get_id_paths_threaded(p_from_ids, p_to_ids);
+	for (int i = 0; i < results.size(); i++) {
+		paths[i] = results[i];
+	}
+	return paths;
+}
+
 bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point) {
 	astar.pass++;
 
@@ -876,6 +1121,7 @@ void AStar2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStar2D::get_point_path);
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStar2D::get_id_path);
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids"), &AStar2D::get_id_paths);
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -34,7 +34,9 @@
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
+#include "core/variant/typed_array.h"
 
 /**
 	A* pathfinding algorithm.
@@ -105,14 +107,74 @@ class AStar3D : public RefCounted {
 		}
 	};
 
+	// Compact copy of the graph, with the connections stored as one adjacency
+	// array (CSR). Used by the batched queries, which keep their search state
+	// outside of the points so they can run concurrently.
+	struct Graph {
+		HashMap<int64_t, uint32_t> indices;
+		LocalVector<int64_t> ids;
+		LocalVector<Vector3> positions;
+		LocalVector<real_t> weight_scales;
+		LocalVector<bool> enabled;
+		LocalVector<uint32_t> neighbour_offsets; // Connections of point i are in [neighbour_offsets[i], neighbour_offsets[i + 1]).
+		LocalVector<uint32_t> neighbours;
+	};
+
+	// Entry of the open list of a batched query. The scores are copied, so a
+	// point reached again with a better score is pushed again instead of being searched for.
+	struct OpenPoint {
+		uint32_t index = 0;
+		real_t g_score = 0;
+		real_t f_score = 0;
+	};
+
+	struct SortOpenPoints {
+		_FORCE_INLINE_ bool operator()(const OpenPoint &A, const OpenPoint &B) const { // Returns true when the Point A is worse than Point B.
+			if (A.f_score > B.f_score) {
+				return true;
+			} else if (A.f_score < B.f_score) {
+				return false;
+			} else {
+				return A.g_score < B.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+			}
+		}
+	};
+
+	// Search state of a batched query, reused between the queries run by the same task.
+	struct QueryState {
+		LocalVector<real_t> g_scores;
+		LocalVector<uint32_t> prev_points;
+		LocalVector<uint64_t> open_passes;
+		LocalVector<uint64_t> closed_passes;
+		LocalVector<OpenPoint> open_list;
+		uint64_t pass = 0;
+	};
+
+	struct PathBatch {
+		const int64_t *from_ids = nullptr;
+		const int64_t *to_ids = nullptr;
+		Vector<int64_t> *paths = nullptr;
+		uint32_t path_count = 0;
+		uint32_t chunk_size = 0;
+	};
+
 	int64_t last_free_id = 0;
 	uint64_t pass = 1;
 
 	OAHashMap<int64_t, Point *> points;
 	HashSet<Segment, Segment> segments;
 
+	Graph graph;
+	bool graph_dirty = true;
+
 	bool _solve(Point *begin_point, Point *end_point);
 
+	void _update_graph();
+	bool _solve_graph(uint32_t p_begin, uint32_t p_end, QueryState &r_state) const;
+	Vector<int64_t> _get_graph_id_path(int64_t p_from_id, int64_t p_to_id, QueryState &r_state) const;
+	void _get_id_paths_chunk(uint32_t p_chunk, PathBatch *p_batch);
+	Vector<Vector<int64_t>> _get_id_paths_threaded(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids);
+
 protected:
 	static void _bind_methods();
 
@@ -152,6 +214,7 @@ public:
 
 	Vector<Vector3> get_point_path(int64_t p_from_id, int64_t p_to_id);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id);
+	TypedArray<PackedInt64Array> get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids);
 
 	AStar3D() {}
 	~AStar3D();
@@ -202,6 +265,7 @@ public:
 
 	Vector<Vector2> get_point_path(int64_t p_from_id, int64_t p_to_id);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id);
+	TypedArray<PackedInt64Array> get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids);
 
 	AStar2D() {}
 	~AStar2D() {}
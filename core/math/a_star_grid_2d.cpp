@@ -93,12 +93,19 @@ Size2 AStarGrid2D::get_cell_size() const {
 
 void AStarGrid2D::update() {
 	points.clear();
+	points.resize(size.y);
 	for (int64_t y = 0; y < size.y; y++) {
-		LocalVector<Point> line;
+		LocalVector<Point> &line = points[y];
+		line.resize(size.x);
 		for (int64_t x = 0; x < size.x; x++) {
-			line.push_back(Point(Vector2i(x, y), offset + Vector2(x, y) * cell_size));
+			line[x] = Point(Vector2i(x, y), offset + Vector2(x, y) * cell_size);
 		}
-		points.push_back(line);
+	}
+
+	solid_mask_stride = (size.x + 63) / 64;
+	solid_mask.resize(size.y * solid_mask_stride);
+	if (solid_mask.size() > 0) {
+		memset(solid_mask.ptr(), 0, solid_mask.size() * sizeof(uint64_t));
 	}
 	dirty = false;
 }
@@ -144,112 +151,151 @@ AStarGrid2D::Heuristic AStarGrid2D::get_default_heuristic() const {
 void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is disabled. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.width, p_id.y, size.height));
-	points[p_id.y][p_id.x].solid = p_solid;
+	uint64_t &word = solid_mask[p_id.y * solid_mask_stride + (p_id.x >> 6)];
+	const uint64_t bit = uint64_t(1) << (p_id.x & 63);
+	if (p_solid) {
+		word |= bit;
+	} else {
+		word &= ~bit;
+	}
 }
 
 bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, false, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), false, vformat("Can't get if point is disabled. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.width, p_id.y, size.height));
-	return points[p_id.y][p_id.x].solid;
+	return _is_solid_unchecked(p_id.x, p_id.y);
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
-	if (!p_to || p_to->solid) {
-		return nullptr;
-	}
-	if (p_to == end) {
-		return p_to;
+void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
+	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
+
+	const Rect2i safe_region = p_region.intersection(Rect2i(Vector2i(), size));
+	const int64_t from_x = safe_region.position.x;
+	const int64_t end_x = safe_region.get_end().x;
+	for (int64_t y = safe_region.position.y; y < safe_region.get_end().y; y++) {
+		uint64_t *row = &solid_mask[y * solid_mask_stride];
+		// Whole words at once, only the ends of the row need a partial mask.
+		for (int64_t x = from_x; x < end_x;) {
+			const int64_t bit = x & 63;
+			const int64_t count = MIN(64 - bit, end_x - x);
+			const uint64_t mask = (count == 64 ? ~uint64_t(0) : ((uint64_t(1) << count) - 1)) << bit;
+			if (p_solid) {
+				row[x >> 6] |= mask;
+			} else {
+				row[x >> 6] &= ~mask;
+			}
+			x += count;
+		}
 	}
+}
 
-	int64_t from_x = p_from->id.x;
-	int64_t from_y = p_from->id.y;
+AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
+	// Keeps going in the same direction in a loop, only the side scans of the
+	// diagonal moves recurse.
+	while (true) {
+		if (!p_to || _is_solid(p_to)) {
+			return nullptr;
+		}
+		if (p_to == end) {
+			return p_to;
+		}
 
-	int64_t to_x = p_to->id.x;
-	int64_t to_y = p_to->id.y;
+		int64_t from_x = p_from->id.x;
+		int64_t from_y = p_from->id.y;
 
-	int64_t dx = to_x - from_x;
-	int64_t dy = to_y - from_y;
+		int64_t to_x = p_to->id.x;
+		int64_t to_y = p_to->id.y;
 
-	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
-		if (dx != 0 && dy != 0) {
-			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
-			}
-		} else {
-			if (dx != 0) {
-				if ((_is_walkable(to_x + dx, to_y + 1) && !_is_walkable(to_x, to_y + 1)) || (_is_walkable(to_x + dx, to_y - 1) && !_is_walkable(to_x, to_y - 1))) {
+		int64_t dx = to_x - from_x;
+		int64_t dy = to_y - from_y;
+
+		if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
+			if (dx != 0 && dy != 0) {
+				if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
 					return p_to;
 				}
-			} else {
-				if ((_is_walkable(to_x + 1, to_y + dy) && !_is_walkable(to_x + 1, to_y)) || (_is_walkable(to_x - 1, to_y + dy) && !_is_walkable(to_x - 1, to_y))) {
+				if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
+					return p_to;
+				}
+				if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
 					return p_to;
 				}
+			} else {
+				if (dx != 0) {
+					if ((_is_walkable(to_x + dx, to_y + 1) && !_is_walkable(to_x, to_y + 1)) || (_is_walkable(to_x + dx, to_y - 1) && !_is_walkable(to_x, to_y - 1))) {
+						return p_to;
+					}
+				} else {
+					if ((_is_walkable(to_x + 1, to_y + dy) && !_is_walkable(to_x + 1, to_y)) || (_is_walkable(to_x - 1, to_y + dy) && !_is_walkable(to_x - 1, to_y))) {
+						return p_to;
+					}
+				}
 			}
-		}
-		if (_is_walkable(to_x + dx, to_y + dy) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || (_is_walkable(to_x + dx, to_y) || _is_walkable(to_x, to_y + dy)))) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
-		}
-	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
-		if (dx != 0 && dy != 0) {
-			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
-				return p_to;
+			if (_is_walkable(to_x + dx, to_y + dy) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || (_is_walkable(to_x + dx, to_y) || _is_walkable(to_x, to_y + dy)))) {
+				p_from = p_to;
+				p_to = _get_point(to_x + dx, to_y + dy);
+				continue;
 			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
-				return p_to;
+		} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
+			if (dx != 0 && dy != 0) {
+				if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
+					return p_to;
+				}
+				if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
+					return p_to;
+				}
+				if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
+					return p_to;
+				}
+			} else {
+				if (dx != 0) {
+					if ((_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1)) || (_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1))) {
+						return p_to;
+					}
+				} else {
+					if ((_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy)) || (_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy))) {
+						return p_to;
+					}
+				}
 			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
+			if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
+				p_from = p_to;
+				p_to = _get_point(to_x + dx, to_y + dy);
+				continue;
 			}
-		} else {
+		} else { // DIAGONAL_MODE_NEVER
 			if (dx != 0) {
-				if ((_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1)) || (_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1))) {
+				if (!_is_walkable(to_x + dx, to_y)) {
+					return p_to;
+				}
+				if (_jump(p_to, _get_point(to_x, to_y + 1)) != nullptr) {
+					return p_to;
+				}
+				if (_jump(p_to, _get_point(to_x, to_y - 1)) != nullptr) {
 					return p_to;
 				}
 			} else {
-				if ((_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy)) || (_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy))) {
+				if (!_is_walkable(to_x, to_y + dy)) {
+					return p_to;
+				}
+				if (_jump(p_to, _get_point(to_x + 1, to_y)) != nullptr) {
+					return p_to;
+				}
+				if (_jump(p_to, _get_point(to_x - 1, to_y)) != nullptr) {
 					return p_to;
 				}
 			}
-		}
-		if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
-		}
-	} else { // DIAGONAL_MODE_NEVER
-		if (dx != 0) {
-			if (!_is_walkable(to_x + dx, to_y)) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x, to_y + 1)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x, to_y - 1)) != nullptr) {
-				return p_to;
-			}
-		} else {
-			if (!_is_walkable(to_x, to_y + dy)) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + 1, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x - 1, to_y)) != nullptr) {
-				return p_to;
+			if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
+				p_from = p_to;
+				p_to = _get_point(to_x + dx, to_y + dy);
+				continue;
 			}
 		}
-		if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
-		}
+		return nullptr;
 	}
-	return nullptr;
 }
 
-void AStarGrid2D::_get_nbors(Point *p_point, List<Point *> &r_nbors) {
+void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 	bool ts0 = false, td0 = false,
 		 ts1 = false, td1 = false,
 		 ts2 = false, td2 = false,
@@ -297,19 +343,19 @@ void AStarGrid2D::_get_nbors(Point *p_point, List<Point *> &r_nbors) {
 		}
 	}
 
-	if (top && !top->solid) {
+	if (top && !_is_solid(top)) {
 		r_nbors.push_back(top);
 		ts0 = true;
 	}
-	if (right && !right->solid) {
+	if (right && !_is_solid(right)) {
 		r_nbors.push_back(right);
 		ts1 = true;
 	}
-	if (bottom && !bottom->solid) {
+	if (bottom && !_is_solid(bottom)) {
 		r_nbors.push_back(bottom);
 		ts2 = true;
 	}
-	if (left && !left->solid) {
+	if (left && !_is_solid(left)) {
 		r_nbors.push_back(left);
 		ts3 = true;
 	}
@@ -339,16 +385,16 @@ void AStarGrid2D::_get_nbors(Point *p_point, List<Point *> &r_nbors) {
 			break;
 	}
 
-	if (td0 && (top_left && !top_left->solid)) {
+	if (td0 && (top_left && !_is_solid(top_left))) {
 		r_nbors.push_back(top_left);
 	}
-	if (td1 && (top_right && !top_right->solid)) {
+	if (td1 && (top_right && !_is_solid(top_right))) {
 		r_nbors.push_back(top_right);
 	}
-	if (td2 && (bottom_right && !bottom_right->solid)) {
+	if (td2 && (bottom_right && !_is_solid(bottom_right))) {
 		r_nbors.push_back(bottom_right);
 	}
-	if (td3 && (bottom_left && !bottom_left->solid)) {
+	if (td3 && (bottom_left && !_is_solid(bottom_left))) {
 		r_nbors.push_back(bottom_left);
 	}
 }
@@ -356,54 +402,55 @@ void AStarGrid2D::_get_nbors(Point *p_point, List<Point *> &r_nbors) {
 bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 	pass++;
 
-	if (p_end_point->solid) {
+	if (_is_solid(p_end_point)) {
 		return false;
 	}
 
 	bool found_route = false;
 
-	Vector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	open_list.clear();
+	SortArray<OpenPoint, SortPoints> sorter;
 
 	p_begin_point->g_score = 0;
 	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	open_list.push_back(p_begin_point);
+	p_begin_point->open_pass = pass;
+	open_list.push_back({ p_begin_point, p_begin_point->g_score, p_begin_point->f_score });
 	end = p_end_point;
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		Point *p = open_list[0].point; // The currently processed point.
 
 		if (p == p_end_point) {
 			found_route = true;
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptrw()); // Remove the current point from the open list.
+		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
 		open_list.remove_at(open_list.size() - 1);
+		if (p->closed_pass == pass) {
+			continue; // Outdated entry, the point was reached again with a better score.
+		}
 		p->closed_pass = pass; // Mark the point as closed.
 
-		List<Point *> nbors;
+		nbors.clear();
 		_get_nbors(p, nbors);
-		for (List<Point *>::Element *E = nbors.front(); E; E = E->next()) {
-			Point *e = E->get(); // The neighbour point.
+		for (uint32_t i = 0; i < nbors.size(); i++) {
+			Point *e = nbors[i]; // The neighbour point.
 			if (jumping_enabled) {
 				e = _jump(p, e);
 				if (!e || e->closed_pass == pass) {
 					continue;
 				}
 			} else {
-				if (e->solid || e->closed_pass == pass) {
+				if (_is_solid(e) || e->closed_pass == pass) {
 					continue;
 				}
 			}
 
 			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id);
-			bool new_point = false;
 
 			if (e->open_pass != pass) { // The point wasn't inside the open list.
 				e->open_pass = pass;
-				open_list.push_back(e);
-				new_point = true;
 			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
 				continue;
 			}
@@ -412,11 +459,9 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 			e->g_score = tentative_g_score;
 			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
 
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptrw());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptrw());
-			}
+			OpenPoint open_point = { e, e->g_score, e->f_score };
+			open_list.push_back(open_point);
+			sorter.push_heap(0, open_list.size() - 1, 0, open_point, open_list.ptr());
 		}
 	}
 
@@ -441,6 +486,8 @@ real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_t
 
 void AStarGrid2D::clear() {
 	points.clear();
+	solid_mask.clear();
+	solid_mask_stride = 0;
 	size = Vector2i();
 }
 
@@ -559,6 +606,7 @@ void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_default_heuristic"), &AStarGrid2D::get_default_heuristic);
 	ClassDB::bind_method(D_METHOD("set_point_solid", "id", "solid"), &AStarGrid2D::set_point_solid, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("is_point_solid", "id"), &AStarGrid2D::is_point_solid);
+	ClassDB::bind_method(D_METHOD("fill_solid_region", "region", "solid"), &AStarGrid2D::fill_solid_region, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("clear"), &AStarGrid2D::clear);
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStarGrid2D::get_point_path);
@@ -70,7 +70,6 @@ private:
 	struct Point {
 		Vector2i id;
 
-		bool solid = false;
 		Vector2 pos;
 
 		// Used for pathfinding.
@@ -86,14 +85,22 @@ private:
 				id(p_id), pos(p_pos) {}
 	};
 
+	// Entry of the open list. The scores are copied, so a point reached again
+	// with a better score is pushed again instead of being searched for.
+	struct OpenPoint {
+		Point *point = nullptr;
+		real_t g_score = 0;
+		real_t f_score = 0;
+	};
+
 	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+		_FORCE_INLINE_ bool operator()(const OpenPoint &A, const OpenPoint &B) const { // Returns true when the Point A is worse than Point B.
+			if (A.f_score > B.f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (A.f_score < B.f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return A.g_score < B.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
@@ -101,12 +108,28 @@ private:
 	LocalVector<LocalVector<Point>> points;
 	Point *end = nullptr;
 
+	// One bit per point, set when it is solid.
+	LocalVector<uint64_t> solid_mask;
+	int64_t solid_mask_stride = 0;
+
+	// Kept between the queries to avoid allocating them each time.
+	LocalVector<OpenPoint> open_list;
+	LocalVector<Point *> nbors;
+
 	uint64_t pass = 1;
 
 private: // Internal routines.
+	_FORCE_INLINE_ bool _is_solid_unchecked(int64_t p_x, int64_t p_y) const {
+		return solid_mask[p_y * solid_mask_stride + (p_x >> 6)] & (uint64_t(1) << (p_x & 63));
+	}
+
+	_FORCE_INLINE_ bool _is_solid(const Point *p_point) const {
+		return _is_solid_unchecked(p_point->id.x, p_point->id.y);
+	}
+
 	_FORCE_INLINE_ bool _is_walkable(int64_t p_x, int64_t p_y) const {
 		if (p_x >= 0 && p_y >= 0 && p_x < size.width && p_y < size.height) {
-			return !points[p_y][p_x].solid;
+			return !_is_solid_unchecked(p_x, p_y);
 		}
 		return false;
 	}
@@ -122,7 +145,7 @@ private: // Internal routines.
 		return &points[p_y][p_x];
 	}
 
-	void _get_nbors(Point *p_point, List<Point *> &r_nbors);
+	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
 	Point *_jump(Point *p_from, Point *p_to);
 	bool _solve(Point *p_begin_point, Point *p_end_point);
 
@@ -165,6 +188,7 @@ public:
 
 	void set_point_solid(const Vector2i &p_id, bool p_solid = true);
 	bool is_point_solid(const Vector2i &p_id) const;
+	void fill_solid_region(const Rect2i &p_region, bool p_solid = true);
 
 	void clear();
 
@@ -52,6 +52,7 @@
 // and pairable_mask is either 0 if static, or set to all if non static
 
 #include "bvh_tree.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -71,6 +72,13 @@ public:
 		_thread_safe = p_enable;
 	}
 
+	// When enabled, the tree queries for pairing large numbers of changed items run on the
+	// WorkerThreadPool. Pair and unpair callbacks are still sent from the calling thread,
+	// in the same order as the single threaded version.
+	void params_set_parallel_pairing(bool p_enable) {
+		_parallel_pairing = p_enable;
+	}
+
 	// these 2 are crucial for fine tuning, and can be applied manually
 	// see the variable declarations for more info.
 	void params_set_node_expansion(real_t p_value) {
@@ -344,9 +352,42 @@ public:
 		}
 	}
 
+	// Scratch memory of a cull test. Cull tests given their own buffer can run
+	// concurrently, as long as the tree isn't modified meanwhile.
+	typedef LocalVector<uint32_t, uint32_t, true> CullBuffer;
+
 	// cull tests
-	int cull_aabb(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
+	int cull_aabb(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr, CullBuffer *r_buffer = nullptr) {
 		BVH_LOCKED_FUNCTION
+		return cull_aabb_unlocked(p_aabb, p_result_array, p_result_max, p_tester, p_tree_collision_mask, p_subindex_array, r_buffer);
+	}
+
+	int cull_segment(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr, CullBuffer *r_buffer = nullptr) {
+		BVH_LOCKED_FUNCTION
+		return cull_segment_unlocked(p_from, p_to, p_result_array, p_result_max, p_tester, p_tree_collision_mask, p_subindex_array, r_buffer);
+	}
+
+	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr, CullBuffer *r_buffer = nullptr) {
+		BVH_LOCKED_FUNCTION
+		return cull_point_unlocked(p_point, p_result_array, p_result_max, p_tester, p_tree_collision_mask, p_subindex_array, r_buffer);
+	}
+
+	// A batch of cull tests spread over several threads takes the lock once with
+	// cull_lock(), then each thread runs the unlocked tests with its own buffer
+	// until cull_unlock(). The tree must not be modified in between.
+	void cull_lock() {
+		if (BVH_THREAD_SAFE && _thread_safe) {
+			_mutex.lock();
+		}
+	}
+
+	void cull_unlock() {
+		if (BVH_THREAD_SAFE && _thread_safe) {
+			_mutex.unlock();
+		}
+	}
+
+	int cull_aabb_unlocked(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr, CullBuffer *r_buffer = nullptr) {
 		typename BVHTREE_CLASS::CullParams params;
 
 		params.result_count_overall = 0;
@@ -354,6 +395,7 @@ public:
 		params.result_array = p_result_array;
 		params.subindex_array = p_subindex_array;
 		params.tree_collision_mask = p_tree_collision_mask;
+		params.hits = r_buffer;
 		params.abb.from(p_aabb);
 		params.tester = p_tester;
 
@@ -362,8 +404,7 @@ public:
 		return params.result_count_overall;
 	}
 
-	int cull_segment(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
-		BVH_LOCKED_FUNCTION
+	int cull_segment_unlocked(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr, CullBuffer *r_buffer = nullptr) {
 		typename BVHTREE_CLASS::CullParams params;
 
 		params.result_count_overall = 0;
@@ -372,6 +413,7 @@ public:
 		params.subindex_array = p_subindex_array;
 		params.tester = p_tester;
 		params.tree_collision_mask = p_tree_collision_mask;
+		params.hits = r_buffer;
 
 		params.segment.from = p_from;
 		params.segment.to = p_to;
@@ -381,8 +423,7 @@ public:
 		return params.result_count_overall;
 	}
 
-	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
-		BVH_LOCKED_FUNCTION
+	int cull_point_unlocked(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr, CullBuffer *r_buffer = nullptr) {
 		typename BVHTREE_CLASS::CullParams params;
 
 		params.result_count_overall = 0;
@@ -391,6 +432,7 @@ public:
 		params.subindex_array = p_subindex_array;
 		params.tester = p_tester;
 		params.tree_collision_mask = p_tree_collision_mask;
+		params.hits = r_buffer;
 
 		params.point = p_point;
 
@@ -435,6 +477,11 @@ private:
 			return;
 		}
 
+		if (USE_PAIRS && _parallel_pairing && !p_full_check && changed_items.size() >= PARALLEL_PAIRING_THRESHOLD && WorkerThreadPool::get_singleton()) {
+			_check_for_collisions_parallel();
+			return;
+		}
+
 		BOUNDS bb;
 
 		typename BVHTREE_CLASS::CullParams params;
@@ -484,6 +531,69 @@ private:
 		_reset();
 	}
 
+	// Finds the items overlapping a changed item, only reads the tree.
+	void _find_enterers(uint32_t p_index, void *p_userdata) {
+		const BVHHandle &h = changed_items[p_index];
+		LocalVector<uint32_t, uint32_t, true> &hits = _changed_item_hits[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		params.hits = &hits;
+
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+		tree.cull_aabb(params, false);
+
+		// Drop the hits that can't pair, so less work is left for the serial part.
+		const typename BVHTREE_CLASS::ItemExtra &exa = _get_extra(h);
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < hits.size(); i++) {
+			uint32_t ref_id = hits[i];
+			if (ref_id == h.id()) {
+				continue;
+			}
+			const typename BVHTREE_CLASS::ItemExtra &exb = tree._extra[ref_id];
+			if ((exa.userdata == exb.userdata && exa.userdata) || !USER_PAIR_TEST_FUNCTION::user_pair_check(exa.userdata, exb.userdata)) {
+				continue;
+			}
+			hits[count++] = ref_id;
+		}
+		hits.resize(count);
+	}
+
+	void _check_for_collisions_parallel() {
+		uint32_t item_count = changed_items.size();
+
+		// Hit buffers are kept between ticks so they don't need to be allocated again.
+		if (_changed_item_hits.size() < item_count) {
+			_changed_item_hits.resize(item_count);
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_find_enterers, (void *)nullptr, item_count, -1, true, SNAME("BVHPairing"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Merge in changed item order, so callbacks are deterministic.
+		for (uint32_t n = 0; n < item_count; n++) {
+			const BVHHandle &h = changed_items[n];
+
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+			_find_leavers(h, abb, false);
+
+			const LocalVector<uint32_t, uint32_t, true> &hits = _changed_item_hits[n];
+			for (uint32_t i = 0; i < hits.size(); i++) {
+				BVHHandle h_collidee;
+				h_collidee.set_id(hits[i]);
+				_collide(h, h_collidee);
+			}
+		}
+
+		_reset();
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -777,6 +887,11 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// Below this, dispatching to the thread pool costs more than it saves.
+	static const uint32_t PARALLEL_PAIRING_THRESHOLD = 128;
+	bool _parallel_pairing = false;
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> _changed_item_hits; // Indexed like changed_items.
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
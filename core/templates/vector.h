@@ -170,6 +170,11 @@ public:
 
 		ERR_FAIL_COND_V(begin > end, result);
 
+		if (begin == 0 && end == s) {
+			// Whole range, share the buffer (copy-on-write) instead of copying it.
+			return *this;
+		}
+
 		int result_size = end - begin;
 		result.resize(result_size);
 
@@ -32,6 +32,7 @@
 
 #if defined(UNIX_ENABLED) || defined(LIBC_FILEIO_ENABLED)
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
@@ -245,6 +246,60 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+void FileAccessUnix::_read_at_thread(uint32_t p_index, BufferRead *p_reads) const {
+	BufferRead &r = p_reads[p_index];
+	r.read = 0;
+#if defined(UNIX_ENABLED)
+	if (!r.dst) {
+		return;
+	}
+
+	int fd = fileno(f);
+	while (r.read < r.length) {
+		ssize_t res = pread(fd, r.dst + r.read, r.length - r.read, r.position + r.read);
+		if (res < 0 && errno == EINTR) {
+			continue;
+		}
+		if (res <= 0) {
+			break;
+		}
+		r.read += res;
+	}
+#endif
+}
+
+Error FileAccessUnix::get_buffers(BufferRead *p_reads, uint32_t p_count) const {
+#if defined(UNIX_ENABLED)
+	ERR_FAIL_COND_V_MSG(!f, ERR_FILE_CANT_READ, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_reads && p_count > 0, ERR_INVALID_PARAMETER);
+
+	if (flags & WRITE) {
+		// Positional reads bypass the stdio buffer, make sure pending writes are visible.
+		fflush(f);
+	}
+
+	// pread() does not touch the shared file offset, so the batch can be split across worker threads.
+	const uint32_t min_threaded_reads = 8;
+	if (p_count >= min_threaded_reads && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &FileAccessUnix::_read_at_thread, p_reads, p_count, -1, true, SNAME("FileAccessUnixBatchRead"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < p_count; i++) {
+			_read_at_thread(i, p_reads);
+		}
+	}
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		if (p_reads[i].read != p_reads[i].length) {
+			return ERR_FILE_EOF;
+		}
+	}
+	return OK;
+#else
+	return FileAccess::get_buffers(p_reads, p_count);
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -50,6 +50,7 @@ class FileAccessUnix : public FileAccess {
 	String path_src;
 
 	void _close();
+	void _read_at_thread(uint32_t p_index, BufferRead *p_reads) const;
 
 public:
 	static CloseNotificationFunc close_notification_func;
@@ -69,6 +70,7 @@ public:
 
 	virtual uint8_t get_8() const override; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Error get_buffers(BufferRead *p_reads, uint32_t p_count) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -315,9 +315,10 @@ void EditorFileSystem::_scan_filesystem() {
 	new_filesystem = memnew(EditorFileSystemDirectory);
 	new_filesystem->parent = nullptr;
 
-	Ref<DirAccess> d = DirAccess::create(DirAccess::ACCESS_RESOURCES);
-	d->change_dir("res://");
-	_scan_new_dir(new_filesystem, d, sp);
+	ScannedDirectory sd;
+	sd.full_path = "res://";
+	_scan_dir_tree_parallel(&sd, sp.get_sub(0, 2));
+	_scan_new_dir(new_filesystem, &sd, sp.get_sub(1, 2));
 
 	file_cache.clear(); //clear caches, no longer needed
 
@@ -722,7 +723,9 @@ void EditorFileSystem::scan() {
 
 void EditorFileSystem::ScanProgress::update(int p_current, int p_total) const {
 	float ratio = low + ((hi - low) / p_total) * p_current;
-	progress->step(ratio * 1000);
+	if (progress) {
+		progress->step(ratio * 1000);
+	}
 	EditorFileSystem::singleton->scan_total = ratio;
 }
 
@@ -730,11 +733,23 @@ EditorFileSystem::ScanProgress EditorFileSystem::ScanProgress::get_sub(int p_cur
 	ScanProgress sp = *this;
 	float slice = (sp.hi - sp.low) / p_total;
 	sp.low += slice * p_current;
-	sp.hi = slice;
+	sp.hi = sp.low + slice;
 	return sp;
 }
 
-void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAccess> &da, const ScanProgress &p_progress) {
+EditorFileSystem::ScannedDirectory::~ScannedDirectory() {
+	for (ScannedDirectory *sd : subdirs) {
+		memdelete(sd);
+	}
+}
+
+void EditorFileSystem::_scan_dir_list(ScannedDirectory *p_dir) {
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_RESOURCES);
+	if (da->change_dir(p_dir->full_path) != OK) {
+		ERR_PRINT("Cannot go into subdir '" + p_dir->full_path + "'.");
+		return;
+	}
+
 	List<String> dirs;
 	List<String> files;
 
@@ -774,65 +789,122 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAc
 	dirs.sort_custom<NaturalNoCaseComparator>();
 	files.sort_custom<NaturalNoCaseComparator>();
 
-	int total = dirs.size() + files.size();
-	int idx = 0;
-
-	for (List<String>::Element *E = dirs.front(); E; E = E->next(), idx++) {
-		if (da->change_dir(E->get()) == OK) {
+	for (const String &E : dirs) {
+		if (da->change_dir(E) == OK) {
 			String d = da->get_current_dir();
+			da->change_dir(cd);
 
 			if (d == cd || !d.begins_with(cd)) {
-				da->change_dir(cd); //avoid recursion
-			} else {
-				EditorFileSystemDirectory *efd = memnew(EditorFileSystemDirectory);
+				continue; //avoid recursion
+			}
 
-				efd->parent = p_dir;
-				efd->name = E->get();
+			ScannedDirectory *sd = memnew(ScannedDirectory);
+			sd->name = E;
+			sd->full_path = d;
+			p_dir->subdirs.push_back(sd);
+		} else {
+			ERR_PRINT("Cannot go into subdir '" + E + "'.");
+		}
+	}
 
-				_scan_new_dir(efd, da, p_progress.get_sub(idx, total));
+	// Stat the files here as well, as this is what dominates the scan on large projects.
+	for (const String &E : files) {
+		String ext = E.get_extension().to_lower();
+		if (!valid_extensions.has(ext)) {
+			continue; //invalid
+		}
 
-				int idx2 = 0;
-				for (int i = 0; i < p_dir->subdirs.size(); i++) {
-					if (efd->name.naturalnocasecmp_to(p_dir->subdirs[i]->name) < 0) {
-						break;
-					}
-					idx2++;
-				}
-				if (idx2 == p_dir->subdirs.size()) {
-					p_dir->subdirs.push_back(efd);
-				} else {
-					p_dir->subdirs.insert(idx2, efd);
-				}
+		ScannedDirectory::File file;
+		file.name = E;
 
-				da->change_dir("..");
+		String path = cd.path_join(E);
+		file.modified_time = FileAccess::get_modified_time(path);
+		if (import_extensions.has(ext) && FileAccess::exists(path + ".import")) {
+			file.import_modified_time = FileAccess::get_modified_time(path + ".import");
+		}
+		p_dir->files.push_back(file);
+	}
+}
+
+void EditorFileSystem::_scan_dir_tree(ScannedDirectory *p_dir) {
+	_scan_dir_list(p_dir);
+	for (ScannedDirectory *sd : p_dir->subdirs) {
+		_scan_dir_tree(sd);
+	}
+}
+
+void EditorFileSystem::_scan_dir_tree_thread(uint32_t p_index, ScannedDirectory **p_dirs) {
+	_scan_dir_tree(p_dirs[p_index]);
+}
+
+void EditorFileSystem::_scan_dir_tree_parallel(ScannedDirectory *p_root, const ScanProgress &p_progress) {
+	// List the top of the tree breadth-first until there are enough subtrees
+	// to keep all worker threads busy, then scan those concurrently.
+	const uint32_t min_subtrees = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * 4;
+
+	LocalVector<ScannedDirectory *> pending;
+	pending.push_back(p_root);
+	while (pending.size() > 0 && pending.size() < min_subtrees) {
+		LocalVector<ScannedDirectory *> next;
+		for (uint32_t i = 0; i < pending.size(); i++) {
+			_scan_dir_list(pending[i]);
+			for (ScannedDirectory *sub : pending[i]->subdirs) {
+				next.push_back(sub);
 			}
-		} else {
-			ERR_PRINT("Cannot go into subdir '" + E->get() + "'.");
 		}
+		pending = next;
+	}
+
+	if (pending.size() == 0) {
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_scan_dir_tree_thread, pending.ptr(), pending.size(), -1, false, SNAME("EditorFileSystemScan"));
+	while (!WorkerThreadPool::get_singleton()->is_group_task_completed(group_task)) {
+		p_progress.update(WorkerThreadPool::get_singleton()->get_group_processed_element_count(group_task), pending.size());
+		OS::get_singleton()->delay_usec(1000);
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	p_progress.update(pending.size(), pending.size());
+}
+
+void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, ScannedDirectory *p_scan_dir, const ScanProgress &p_progress) {
+	String cd = p_scan_dir->full_path;
+
+	p_dir->modified_time = p_scan_dir->modified_time;
+
+	int total = p_scan_dir->subdirs.size() + p_scan_dir->files.size();
+	int idx = 0;
+
+	for (ScannedDirectory *sd : p_scan_dir->subdirs) {
+		EditorFileSystemDirectory *efd = memnew(EditorFileSystemDirectory);
+
+		efd->parent = p_dir;
+		efd->name = sd->name;
+
+		_scan_new_dir(efd, sd, p_progress.get_sub(idx, total));
+
+		// Subdirectories are already sorted by the listing.
+		p_dir->subdirs.push_back(efd);
 
 		p_progress.update(idx, total);
+		idx++;
 	}
 
-	for (List<String>::Element *E = files.front(); E; E = E->next(), idx++) {
-		String ext = E->get().get_extension().to_lower();
-		if (!valid_extensions.has(ext)) {
-			continue; //invalid
-		}
+	for (const ScannedDirectory::File &E : p_scan_dir->files) {
+		String ext = E.name.get_extension().to_lower();
 
 		EditorFileSystemDirectory::FileInfo *fi = memnew(EditorFileSystemDirectory::FileInfo);
-		fi->file = E->get();
+		fi->file = E.name;
 
 		String path = cd.path_join(fi->file);
 
 		FileCache *fc = file_cache.getptr(path);
-		uint64_t mt = FileAccess::get_modified_time(path);
+		uint64_t mt = E.modified_time;
 
 		if (import_extensions.has(ext)) {
 			//is imported
-			uint64_t import_mt = 0;
-			if (FileAccess::exists(path + ".import")) {
-				import_mt = FileAccess::get_modified_time(path + ".import");
-			}
+			uint64_t import_mt = E.import_modified_time;
 
 			if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport(path, true)) {
 				fi->type = fc->type;
@@ -851,7 +923,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAc
 					ItemAction ia;
 					ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
 					ia.dir = p_dir;
-					ia.file = E->get();
+					ia.file = E.name;
 					scan_actions.push_back(ia);
 				}
 
@@ -879,7 +951,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAc
 				ItemAction ia;
 				ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
 				ia.dir = p_dir;
-				ia.file = E->get();
+				ia.file = E.name;
 				scan_actions.push_back(ia);
 			}
 		} else {
@@ -933,6 +1005,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAc
 
 		p_dir->files.push_back(fi);
 		p_progress.update(idx, total);
+		idx++;
 	}
 }
 
@@ -990,9 +1063,11 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 
 					efd->parent = p_dir;
 					efd->name = f;
-					Ref<DirAccess> d = DirAccess::create(DirAccess::ACCESS_RESOURCES);
-					d->change_dir(cd.path_join(f));
-					_scan_new_dir(efd, d, p_progress.get_sub(1, 1));
+					ScannedDirectory sd;
+					sd.name = f;
+					sd.full_path = cd.path_join(f);
+					_scan_dir_tree_parallel(&sd, p_progress.get_sub(0, 2));
+					_scan_new_dir(efd, &sd, p_progress.get_sub(1, 2));
 
 					ItemAction ia;
 					ia.action = ItemAction::ACTION_DIR_ADD;
@@ -2118,23 +2193,35 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 	int from = 0;
 	for (int i = 0; i < reimport_files.size(); i++) {
 		if (use_threads && reimport_files[i].threaded) {
-			if (i + 1 == reimport_files.size() || reimport_files[i + 1].importer != reimport_files[from].importer) {
+			// Threaded importers sharing the same import order don't depend on each other,
+			// so the whole run is imported in a single batch instead of one batch per importer.
+			if (i + 1 == reimport_files.size() || !reimport_files[i + 1].threaded || reimport_files[i + 1].order != reimport_files[from].order) {
 				if (from - i == 0) {
 					//single file, do not use threads
 					pr.step(reimport_files[i].path.get_file(), i);
 					_reimport_file(reimport_files[i].path);
 				} else {
-					Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(reimport_files[from].importer);
-					ERR_CONTINUE(!importer.is_valid());
-
-					importer->import_threaded_begin();
+					LocalVector<Ref<ResourceImporter>> importers;
+					String importer_names;
+					for (int j = from; j <= i; j++) {
+						if (j > from && reimport_files[j].importer == reimport_files[j - 1].importer) {
+							continue; // Sorted by importer within the same order.
+						}
+						Ref<ResourceImporter> importer = ResourceFormatImporter::get_singleton()->get_importer_by_name(reimport_files[j].importer);
+						ERR_CONTINUE(!importer.is_valid());
+						importer->import_threaded_begin();
+						importers.push_back(importer);
+						importer_names += (importer_names.is_empty() ? "" : ", ") + reimport_files[j].importer;
+					}
 
 					ImportThreadData data;
 					data.max_index = from;
 					data.reimport_from = from;
 					data.reimport_files = reimport_files.ptr();
 
-					WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_reimport_thread, &data, i - from + 1, -1, false, vformat(TTR("Import resources of type: %s"), reimport_files[from].importer));
+					// The pool never runs more tasks than it has threads, which also bounds how many
+					// imported resources are held in memory at once.
+					WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_reimport_thread, &data, i - from + 1, -1, false, vformat(TTR("Import resources of type: %s"), importer_names));
 					int current_index = from - 1;
 					do {
 						if (current_index < data.max_index) {
@@ -2146,7 +2233,9 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-					importer->import_threaded_end();
+					for (uint32_t j = 0; j < importers.size(); j++) {
+						importers[j]->import_threaded_end();
+					}
 				}
 
 				from = i + 1;
@@ -2155,6 +2244,7 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 		} else {
 			pr.step(reimport_files[i].path.get_file(), i);
 			_reimport_file(reimport_files[i].path);
+			from = i + 1;
 		}
 	}
 
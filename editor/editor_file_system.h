@@ -144,6 +144,8 @@ class EditorFileSystem : public Node {
 
 	_THREAD_SAFE_CLASS_
 
+	friend class TestEditorFileSystem;
+
 	struct ItemAction {
 		enum Action {
 			ACTION_NONE,
@@ -224,7 +226,27 @@ class EditorFileSystem : public Node {
 	HashSet<String> valid_extensions;
 	HashSet<String> import_extensions;
 
-	void _scan_new_dir(EditorFileSystemDirectory *p_dir, Ref<DirAccess> &da, const ScanProgress &p_progress);
+	struct ScannedDirectory {
+		struct File {
+			String name;
+			uint64_t modified_time = 0;
+			uint64_t import_modified_time = 0;
+		};
+
+		String name;
+		String full_path;
+		uint64_t modified_time = 0;
+		Vector<ScannedDirectory *> subdirs;
+		Vector<File> files;
+
+		~ScannedDirectory();
+	};
+
+	void _scan_dir_list(ScannedDirectory *p_dir);
+	void _scan_dir_tree(ScannedDirectory *p_dir);
+	void _scan_dir_tree_thread(uint32_t p_index, ScannedDirectory **p_dirs);
+	void _scan_dir_tree_parallel(ScannedDirectory *p_root, const ScanProgress &p_progress);
+	void _scan_new_dir(EditorFileSystemDirectory *p_dir, ScannedDirectory *p_scan_dir, const ScanProgress &p_progress);
 
 	Thread thread_sources;
 	bool scanning_changes = false;
@@ -224,6 +224,27 @@ real_t GodotNavigationServer::map_get_link_connection_radius(RID p_map) const {
 	return map->get_link_connection_radius();
 }
 
+COMMAND_2(map_set_cluster_size, RID, p_map, real_t, p_cluster_size) {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND(map == nullptr);
+
+	map->set_cluster_size(p_cluster_size);
+}
+
+real_t GodotNavigationServer::map_get_cluster_size(RID p_map) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND_V(map == nullptr, 0);
+
+	return map->get_cluster_size();
+}
+
+COMMAND_2(map_set_avoidance_callback, RID, p_map, Callable, p_callback) {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND(map == nullptr);
+
+	map->set_avoidance_callback(p_callback);
+}
+
 Vector<Vector3> GodotNavigationServer::map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) const {
 	const NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_COND_V(map == nullptr, Vector<Vector3>());
@@ -231,6 +252,22 @@ Vector<Vector3> GodotNavigationServer::map_get_path(RID p_map, Vector3 p_origin,
 	return map->get_path(p_origin, p_destination, p_optimize, p_navigation_layers);
 }
 
+TypedArray<PackedVector3Array> GodotNavigationServer::map_get_paths(RID p_map, const Vector<Vector3> &p_origins, const Vector<Vector3> &p_destinations, bool p_optimize, uint32_t p_navigation_layers) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_COND_V(map == nullptr, TypedArray<PackedVector3Array>());
+	ERR_FAIL_COND_V_MSG(p_origins.size() != p_destinations.size(), TypedArray<PackedVector3Array>(), "The origins and destinations must have the same size.");
+
+	Vector<Vector<Vector3>> paths;
+	map->get_paths(p_origins, p_destinations, p_optimize, p_navigation_layers, paths);
+
+	TypedArray<PackedVector3Array> ret;
+	ret.resize(paths.size());
+	for (int i = 0; i < paths.size(); i++) {
+		ret[i] = paths[i];
+	}
+	return ret;
+}
+
 Vector3 GodotNavigationServer::map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
 	const NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_COND_V(map == nullptr, Vector3());
@@ -424,6 +461,15 @@ void GodotNavigationServer::region_bake_navmesh(Ref<NavigationMesh> r_mesh, Node
 #endif
 }
 
+void GodotNavigationServer::region_bake_navmesh_tiles(Ref<NavigationMesh> r_mesh, Node *p_node, const TypedArray<AABB> &p_changed_aabbs) const {
+	ERR_FAIL_COND(r_mesh.is_null());
+	ERR_FAIL_COND(p_node == nullptr);
+
+#ifndef _3D_DISABLED
+	NavigationMeshGenerator::get_singleton()->bake_tiles(r_mesh, p_node, p_changed_aabbs);
+#endif
+}
+
 int GodotNavigationServer::region_get_connections_count(RID p_region) const {
 	NavRegion *region = region_owner.get_or_null(p_region);
 	ERR_FAIL_COND_V(!region, 0);
@@ -684,7 +730,10 @@ COMMAND_4(agent_set_callback, RID, p_agent, Object *, p_receiver, StringName, p_
 
 	if (agent->get_map()) {
 		if (p_receiver == nullptr) {
-			agent->get_map()->remove_agent_as_controlled(agent);
+			// Agents stay controlled while their map has an avoidance callback.
+			if (!agent->get_map()->get_avoidance_callback().is_valid()) {
+				agent->get_map()->remove_agent_as_controlled(agent);
+			}
 		} else {
 			agent->get_map()->set_agent_as_controlled(agent);
 		}
@@ -0,0 +1,160 @@
+/*************************************************************************/
+/*  nav_agent_grid.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "nav_agent_grid.h"
+
+#include "rvo_agent.h"
+
+void NavAgentGrid::_insert(uint32_t p_agent, const Vector2i &p_cell) {
+	LocalVector<uint32_t> *cell = cells.getptr(p_cell);
+	if (!cell) {
+		cell = &cells.insert(p_cell, LocalVector<uint32_t>())->value;
+	}
+	agent_cells[p_agent] = p_cell;
+	agent_slots[p_agent] = cell->size();
+	cell->push_back(p_agent);
+}
+
+void NavAgentGrid::_remove(uint32_t p_agent) {
+	LocalVector<uint32_t> *cell = cells.getptr(agent_cells[p_agent]);
+	ERR_FAIL_NULL(cell);
+
+	// Swap with the last agent of the cell, keeping the slots in sync.
+	const uint32_t slot = agent_slots[p_agent];
+	const uint32_t last = (*cell)[cell->size() - 1];
+	(*cell)[slot] = last;
+	agent_slots[last] = slot;
+	cell->resize(cell->size() - 1);
+
+	if (cell->is_empty()) {
+		cells.erase(agent_cells[p_agent]);
+	}
+}
+
+void NavAgentGrid::_rebuild(const LocalVector<RvoAgent *> &p_agents) {
+	cells.clear();
+	agent_cells.resize(p_agents.size());
+	agent_slots.resize(p_agents.size());
+
+	// Cells as large as the furthest neighbor distance keep every search within
+	// the 3x3 cells around the agent.
+	built_neighbor_dist = max_neighbor_dist;
+	cell_size = max_neighbor_dist > 0.0 ? max_neighbor_dist : 1.0;
+
+	for (uint32_t i = 0; i < p_agents.size(); i++) {
+		_insert(i, _get_cell(positions[i]));
+	}
+}
+
+void NavAgentGrid::_search_cell(const Vector2i &p_cell, RVO::Agent *p_agent, const Vector3 &p_position, float &r_range_sq) const {
+	const LocalVector<uint32_t> *cell = cells.getptr(p_cell);
+	if (!cell) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < cell->size(); i++) {
+		const uint32_t other = (*cell)[i];
+		if (p_position.distance_squared_to(positions[other]) < r_range_sq) {
+			p_agent->insertAgentNeighbor(rvo_agents[other], r_range_sq);
+		}
+	}
+}
+
+void NavAgentGrid::clear() {
+	dirty = true;
+}
+
+void NavAgentGrid::update(const LocalVector<RvoAgent *> &p_agents) {
+	positions.resize(p_agents.size());
+	rvo_agents.resize(p_agents.size());
+	max_neighbor_dist = 0.0;
+	for (uint32_t i = 0; i < p_agents.size(); i++) {
+		RVO::Agent *agent = p_agents[i]->get_agent();
+		rvo_agents[i] = agent;
+		positions[i] = Vector3(agent->position_.x(), agent->position_.y(), agent->position_.z());
+		max_neighbor_dist = MAX(max_neighbor_dist, agent->neighborDist_);
+	}
+
+	if (dirty || agent_cells.size() != p_agents.size() || max_neighbor_dist != built_neighbor_dist) {
+		_rebuild(p_agents);
+		dirty = false;
+		return;
+	}
+
+	for (uint32_t i = 0; i < p_agents.size(); i++) {
+		const Vector2i cell = _get_cell(positions[i]);
+		if (cell != agent_cells[i]) {
+			_remove(i);
+			_insert(i, cell);
+		}
+	}
+}
+
+void NavAgentGrid::compute_neighbors(RVO::Agent *p_agent) const {
+	p_agent->agentNeighbors_.clear();
+	if (p_agent->maxNeighbors_ == 0) {
+		return;
+	}
+
+	float range_sq = p_agent->neighborDist_ * p_agent->neighborDist_;
+	const Vector3 position(p_agent->position_.x(), p_agent->position_.y(), p_agent->position_.z());
+	const Vector2i center = _get_cell(position);
+	const int64_t max_ring = Math::ceil(p_agent->neighborDist_ / cell_size);
+
+	if ((2 * max_ring + 1) * (2 * max_ring + 1) > (int64_t)cells.size()) {
+		// Fewer agent cells than cells in range, go through them instead.
+		for (const KeyValue<Vector2i, LocalVector<uint32_t>> &E : cells) {
+			const Vector2i offset = (E.key - center).abs();
+			if (offset.x <= max_ring && offset.y <= max_ring) {
+				_search_cell(E.key, p_agent, position, range_sq);
+			}
+		}
+		return;
+	}
+
+	// Go through the rings of cells around the agent, until the closest cell
+	// of a ring is further than the furthest neighbor found so far.
+	_search_cell(center, p_agent, position, range_sq);
+	for (int ring = 1; ring <= max_ring; ring++) {
+		const real_t ring_distance = (ring - 1) * cell_size;
+		if (ring_distance * ring_distance >= range_sq) {
+			break;
+		}
+
+		for (int x = -ring; x <= ring; x++) {
+			_search_cell(center + Vector2i(x, -ring), p_agent, position, range_sq);
+			_search_cell(center + Vector2i(x, ring), p_agent, position, range_sq);
+		}
+		for (int y = -ring + 1; y < ring; y++) {
+			_search_cell(center + Vector2i(-ring, y), p_agent, position, range_sq);
+			_search_cell(center + Vector2i(ring, y), p_agent, position, range_sq);
+		}
+	}
+}
@@ -0,0 +1,86 @@
+/*************************************************************************/
+/*  nav_agent_grid.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NAV_AGENT_GRID_H
+#define NAV_AGENT_GRID_H
+
+#include "core/math/vector2i.h"
+#include "core/math/vector3.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+#include <Agent.h>
+
+class RvoAgent;
+
+/// Spatial hash of the avoidance agents of a map, used to find their neighbors.
+///
+/// The agents are bucketed by the cell of the horizontal grid containing their
+/// position. Their positions are packed in a flat array, so the search for
+/// neighbors only touches the agents that are actually in range.
+///
+/// Each update only moves the agents that changed cell, the grid is built
+/// again when the agents of the map or their largest neighbor distance change.
+class NavAgentGrid {
+	real_t cell_size = 1.0;
+	float max_neighbor_dist = 0.0;
+	float built_neighbor_dist = 0.0; // Neighbor distance the cells were sized for.
+	bool dirty = true;
+
+	LocalVector<Vector3> positions;
+	LocalVector<RVO::Agent *> rvo_agents;
+
+	LocalVector<Vector2i> agent_cells;
+	LocalVector<uint32_t> agent_slots;
+	HashMap<Vector2i, LocalVector<uint32_t>> cells;
+
+	_FORCE_INLINE_ Vector2i _get_cell(const Vector3 &p_position) const {
+		return Vector2i(Math::floor(p_position.x / cell_size), Math::floor(p_position.z / cell_size));
+	}
+
+	void _insert(uint32_t p_agent, const Vector2i &p_cell);
+	void _remove(uint32_t p_agent);
+	void _rebuild(const LocalVector<RvoAgent *> &p_agents);
+	void _search_cell(const Vector2i &p_cell, RVO::Agent *p_agent, const Vector3 &p_position, float &r_range_sq) const;
+
+public:
+	real_t get_cell_size() const { return cell_size; }
+
+	/// Forces the grid to be built again on the next update.
+	void clear();
+
+	/// Gathers the position of the agents and moves them to their new cell.
+	void update(const LocalVector<RvoAgent *> &p_agents);
+
+	/// Fills the neighbors of `p_agent` like `RVO::Agent::computeNeighbors`.
+	void compute_neighbors(RVO::Agent *p_agent) const;
+};
+
+#endif // NAV_AGENT_GRID_H
@@ -0,0 +1,349 @@
+/*************************************************************************/
+/*  nav_cluster_graph.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "nav_cluster_graph.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/sort_array.h"
+#include "nav_base.h"
+
+typedef SortArray<gd::ClusterSearchItem, gd::ClusterSearchItemCompare> ClusterSearchHeap;
+
+void NavClusterGraph::clear() {
+	clusters.clear();
+	entrances.clear();
+	navigation_layers = 0;
+}
+
+void NavClusterGraph::build(LocalVector<gd::Polygon> &p_polygons, LocalVector<gd::Polygon> &p_link_polygons) {
+	clear();
+	if (cluster_size <= 0.0) {
+		return;
+	}
+
+	// Group the polygons by the grid cell containing their center.
+	HashMap<Vector3i, uint32_t> cluster_ids;
+	LocalVector<gd::Polygon> *polygon_lists[2] = { &p_polygons, &p_link_polygons };
+	for (int l = 0; l < 2; l++) {
+		LocalVector<gd::Polygon> &polygons = *polygon_lists[l];
+		for (uint32_t i = 0; i < polygons.size(); i++) {
+			gd::Polygon &polygon = polygons[i];
+			const Vector3i cell(
+					Math::floor(polygon.center.x / cluster_size),
+					Math::floor(polygon.center.y / cluster_size),
+					Math::floor(polygon.center.z / cluster_size));
+
+			HashMap<Vector3i, uint32_t>::Iterator E = cluster_ids.find(cell);
+			if (!E) {
+				E = cluster_ids.insert(cell, clusters.size());
+				clusters.push_back(Cluster());
+			}
+
+			Cluster &cluster = clusters[E->value];
+			polygon.cluster = E->value;
+			polygon.cluster_index = cluster.polygons.size();
+			cluster.polygons.push_back(&polygon);
+			navigation_layers |= polygon.owner->get_navigation_layers();
+		}
+	}
+
+	// Create the entrances from the connections between polygons of different clusters.
+	HashMap<uint64_t, uint32_t> entrance_ids;
+	HashSet<uint64_t> crossings;
+	for (uint32_t c = 0; c < clusters.size(); c++) {
+		for (uint32_t i = 0; i < clusters[c].polygons.size(); i++) {
+			const gd::Polygon *polygon = clusters[c].polygons[i];
+			for (uint32_t e = 0; e < polygon->edges.size(); e++) {
+				const Vector<gd::Edge::Connection> &connections = polygon->edges[e].connections;
+				for (int j = 0; j < connections.size(); j++) {
+					const gd::Polygon *other = connections[j].polygon;
+					if (other->cluster == c) {
+						continue;
+					}
+
+					const uint32_t from = _get_entrance(entrance_ids, c, other->cluster);
+					const uint32_t to = _get_entrance(entrance_ids, other->cluster, c);
+					if (entrances[from].polygons.find(polygon) == -1) {
+						entrances[from].polygons.push_back(polygon);
+					}
+					if (entrances[to].polygons.find(other) == -1) {
+						entrances[to].polygons.push_back(other);
+					}
+
+					const uint64_t crossing = (uint64_t(from) << 32) | to;
+					if (!crossings.has(crossing)) {
+						crossings.insert(crossing);
+						Edge edge;
+						edge.to = to;
+						entrances[from].edges.push_back(edge);
+					}
+				}
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < entrances.size(); i++) {
+		Entrance &entrance = entrances[i];
+		Vector3 position;
+		for (uint32_t j = 0; j < entrance.polygons.size(); j++) {
+			position += entrance.polygons[j]->center;
+		}
+		entrance.position = position / real_t(entrance.polygons.size());
+	}
+
+	for (uint32_t i = 0; i < entrances.size(); i++) {
+		Entrance &entrance = entrances[i];
+		for (uint32_t j = 0; j < entrance.edges.size(); j++) {
+			entrance.edges[j].cost = entrance.position.distance_to(entrances[entrance.edges[j].to].position);
+		}
+	}
+
+	// Link the entrances of each cluster, the clusters are independent.
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavClusterGraph::_build_cluster_edges, (void *)nullptr, clusters.size(), -1, true, SNAME("NavigationClusterGraph"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+uint32_t NavClusterGraph::_get_entrance(HashMap<uint64_t, uint32_t> &r_entrance_ids, uint32_t p_cluster, uint32_t p_neighbour) {
+	const uint64_t key = (uint64_t(p_cluster) << 32) | p_neighbour;
+	HashMap<uint64_t, uint32_t>::Iterator E = r_entrance_ids.find(key);
+	if (E) {
+		return E->value;
+	}
+
+	const uint32_t id = entrances.size();
+	r_entrance_ids.insert(key, id);
+	entrances.push_back(Entrance());
+	entrances[id].cluster = p_cluster;
+	clusters[p_cluster].entrances.push_back(id);
+	return id;
+}
+
+void NavClusterGraph::_build_cluster_edges(uint32_t p_cluster, void *p_userdata) {
+	const Cluster &cluster = clusters[p_cluster];
+	LocalVector<float> costs;
+	LocalVector<gd::ClusterSearchItem> open;
+	costs.resize(cluster.polygons.size());
+
+	for (uint32_t i = 0; i < cluster.entrances.size(); i++) {
+		// Costs from the polygons of this entrance to every polygon of the cluster.
+		Entrance &entrance = entrances[cluster.entrances[i]];
+		for (uint32_t j = 0; j < costs.size(); j++) {
+			costs[j] = INFINITY;
+		}
+		open.clear();
+		for (uint32_t j = 0; j < entrance.polygons.size(); j++) {
+			gd::ClusterSearchItem item;
+			item.index = entrance.polygons[j]->cluster_index;
+			costs[item.index] = 0.0;
+			open.push_back(item);
+		}
+		_compute_cluster_costs(p_cluster, costs, open);
+
+		for (uint32_t j = 0; j < cluster.entrances.size(); j++) {
+			if (j == i) {
+				continue;
+			}
+
+			const Entrance &other = entrances[cluster.entrances[j]];
+			Edge edge;
+			edge.to = cluster.entrances[j];
+			edge.cost = INFINITY;
+			for (uint32_t k = 0; k < other.polygons.size(); k++) {
+				edge.cost = MIN(edge.cost, costs[other.polygons[k]->cluster_index]);
+			}
+			// Unreachable from this entrance inside the cluster.
+			if (edge.cost < INFINITY) {
+				entrance.edges.push_back(edge);
+			}
+		}
+	}
+}
+
+void NavClusterGraph::_compute_cluster_costs(uint32_t p_cluster, LocalVector<float> &r_costs, LocalVector<gd::ClusterSearchItem> &r_open) const {
+	// Dijkstra over the polygons of the cluster, from the ones already in the open list.
+	const Cluster &cluster = clusters[p_cluster];
+	ClusterSearchHeap heap;
+	for (uint32_t i = 1; i < r_open.size(); i++) {
+		heap.push_heap(0, i, 0, r_open[i], r_open.ptr());
+	}
+
+	while (!r_open.is_empty()) {
+		heap.pop_heap(0, r_open.size(), r_open.ptr());
+		const gd::ClusterSearchItem item = r_open[r_open.size() - 1];
+		r_open.remove_at(r_open.size() - 1);
+		if (item.cost > r_costs[item.index]) {
+			// Already reached with a lower cost.
+			continue;
+		}
+
+		const gd::Polygon *polygon = cluster.polygons[item.index];
+		const float travel_cost = polygon->owner->get_travel_cost();
+		for (uint32_t e = 0; e < polygon->edges.size(); e++) {
+			const Vector<gd::Edge::Connection> &connections = polygon->edges[e].connections;
+			for (int j = 0; j < connections.size(); j++) {
+				const gd::Polygon *other = connections[j].polygon;
+				if (other->cluster != p_cluster) {
+					continue;
+				}
+
+				const float cost = item.cost + polygon->center.distance_to(other->center) * travel_cost;
+				if (cost < r_costs[other->cluster_index]) {
+					r_costs[other->cluster_index] = cost;
+					gd::ClusterSearchItem next;
+					next.cost = cost;
+					next.index = other->cluster_index;
+					r_open.push_back(next);
+					heap.push_heap(0, r_open.size() - 1, 0, next, r_open.ptr());
+				}
+			}
+		}
+	}
+}
+
+bool NavClusterGraph::find_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, gd::PathQueryScratch &r_scratch) const {
+	// The entrance costs are only valid when every polygon can be used.
+	if (clusters.is_empty() || (p_navigation_layers & navigation_layers) != navigation_layers) {
+		return false;
+	}
+
+	const uint32_t begin_cluster = p_begin_poly->cluster;
+	const uint32_t end_cluster = p_end_poly->cluster;
+	if (begin_cluster == end_cluster) {
+		return false;
+	}
+
+	r_scratch.stamp++;
+	if (r_scratch.stamp == 0 || r_scratch.cluster_stamps.size() != clusters.size() || r_scratch.entrance_stamps.size() != entrances.size()) {
+		r_scratch.cluster_stamps.resize(clusters.size());
+		for (uint32_t i = 0; i < clusters.size(); i++) {
+			r_scratch.cluster_stamps[i] = 0;
+		}
+		r_scratch.entrance_stamps.resize(entrances.size());
+		r_scratch.entrance_costs.resize(entrances.size());
+		r_scratch.entrance_parents.resize(entrances.size());
+		for (uint32_t i = 0; i < entrances.size(); i++) {
+			r_scratch.entrance_stamps[i] = 0;
+		}
+		r_scratch.stamp = 1;
+	}
+	const uint32_t stamp = r_scratch.stamp;
+
+	// Costs from the begin point to the polygons of its cluster.
+	const Cluster &cluster = clusters[begin_cluster];
+	LocalVector<float> &polygon_costs = r_scratch.polygon_costs;
+	LocalVector<gd::ClusterSearchItem> &open = r_scratch.open;
+	polygon_costs.resize(cluster.polygons.size());
+	for (uint32_t i = 0; i < polygon_costs.size(); i++) {
+		polygon_costs[i] = INFINITY;
+	}
+	gd::ClusterSearchItem begin_item;
+	begin_item.cost = p_begin_point.distance_to(p_begin_poly->center) * p_begin_poly->owner->get_travel_cost();
+	begin_item.index = p_begin_poly->cluster_index;
+	polygon_costs[begin_item.index] = begin_item.cost;
+	open.clear();
+	open.push_back(begin_item);
+	_compute_cluster_costs(begin_cluster, polygon_costs, open);
+
+	// A* over the entrances, starting from the ones of the begin cluster.
+	ClusterSearchHeap heap;
+	for (uint32_t i = 0; i < cluster.entrances.size(); i++) {
+		const uint32_t id = cluster.entrances[i];
+		const Entrance &entrance = entrances[id];
+		float cost = INFINITY;
+		for (uint32_t j = 0; j < entrance.polygons.size(); j++) {
+			cost = MIN(cost, polygon_costs[entrance.polygons[j]->cluster_index]);
+		}
+		if (cost == INFINITY) {
+			continue;
+		}
+
+		r_scratch.entrance_stamps[id] = stamp;
+		r_scratch.entrance_costs[id] = cost;
+		r_scratch.entrance_parents[id] = UINT32_MAX;
+		gd::ClusterSearchItem item;
+		item.cost = cost + entrance.position.distance_to(p_end_point);
+		item.index = id;
+		open.push_back(item);
+		heap.push_heap(0, open.size() - 1, 0, item, open.ptr());
+	}
+
+	float best_cost = INFINITY;
+	uint32_t best_entrance = UINT32_MAX;
+	while (!open.is_empty()) {
+		heap.pop_heap(0, open.size(), open.ptr());
+		const gd::ClusterSearchItem item = open[open.size() - 1];
+		open.remove_at(open.size() - 1);
+		if (item.cost >= best_cost) {
+			break;
+		}
+
+		const Entrance &entrance = entrances[item.index];
+		const float cost = r_scratch.entrance_costs[item.index];
+		if (item.cost > cost + entrance.position.distance_to(p_end_point)) {
+			// Already reached with a lower cost.
+			continue;
+		}
+
+		if (entrance.cluster == end_cluster) {
+			best_cost = item.cost;
+			best_entrance = item.index;
+			continue;
+		}
+
+		for (uint32_t i = 0; i < entrance.edges.size(); i++) {
+			const Edge &edge = entrance.edges[i];
+			const float next_cost = cost + edge.cost;
+			if (r_scratch.entrance_stamps[edge.to] == stamp && next_cost >= r_scratch.entrance_costs[edge.to]) {
+				continue;
+			}
+
+			r_scratch.entrance_stamps[edge.to] = stamp;
+			r_scratch.entrance_costs[edge.to] = next_cost;
+			r_scratch.entrance_parents[edge.to] = item.index;
+			gd::ClusterSearchItem next;
+			next.cost = next_cost + entrances[edge.to].position.distance_to(p_end_point);
+			next.index = edge.to;
+			open.push_back(next);
+			heap.push_heap(0, open.size() - 1, 0, next, open.ptr());
+		}
+	}
+
+	if (best_entrance == UINT32_MAX) {
+		return false;
+	}
+
+	// The corridor is made of the clusters of the entrances on the way.
+	r_scratch.cluster_stamps[begin_cluster] = stamp;
+	for (uint32_t id = best_entrance; id != UINT32_MAX; id = r_scratch.entrance_parents[id]) {
+		r_scratch.cluster_stamps[entrances[id].cluster] = stamp;
+	}
+	return true;
+}
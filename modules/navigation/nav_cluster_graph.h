@@ -0,0 +1,91 @@
+/*************************************************************************/
+/*  nav_cluster_graph.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NAV_CLUSTER_GRAPH_H
+#define NAV_CLUSTER_GRAPH_H
+
+#include "core/templates/hash_map.h"
+#include "nav_utils.h"
+
+/// Abstract graph of a navigation map, used to speed up long path queries.
+///
+/// The map polygons are grouped in clusters, by the grid cell containing their
+/// center. The nodes of the graph are the cluster entrances: the polygons of a
+/// cluster that are connected to a given neighbour cluster. Entrances of
+/// neighbour clusters are linked together, and the entrances of a cluster are
+/// linked by the cost of the shortest path between them inside the cluster.
+///
+/// A path query first searches this graph to find the clusters to go through,
+/// then runs the regular search restricted to those clusters.
+class NavClusterGraph {
+	struct Edge {
+		uint32_t to = 0;
+		float cost = 0.0;
+	};
+
+	struct Entrance {
+		uint32_t cluster = 0;
+		Vector3 position;
+		LocalVector<const gd::Polygon *> polygons;
+		LocalVector<Edge> edges;
+	};
+
+	struct Cluster {
+		LocalVector<gd::Polygon *> polygons;
+		LocalVector<uint32_t> entrances;
+	};
+
+	real_t cluster_size = 0.0;
+	uint32_t navigation_layers = 0;
+
+	LocalVector<Cluster> clusters;
+	LocalVector<Entrance> entrances;
+
+	uint32_t _get_entrance(HashMap<uint64_t, uint32_t> &r_entrance_ids, uint32_t p_cluster, uint32_t p_neighbour);
+	void _build_cluster_edges(uint32_t p_cluster, void *p_userdata);
+	void _compute_cluster_costs(uint32_t p_cluster, LocalVector<float> &r_costs, LocalVector<gd::ClusterSearchItem> &r_open) const;
+
+public:
+	void set_cluster_size(real_t p_cluster_size) { cluster_size = p_cluster_size; }
+	real_t get_cluster_size() const { return cluster_size; }
+
+	bool is_empty() const { return clusters.is_empty(); }
+
+	/// Rebuilds the graph, assigning the polygons to their cluster.
+	void build(LocalVector<gd::Polygon> &p_polygons, LocalVector<gd::Polygon> &p_link_polygons);
+	void clear();
+
+	/// Marks the clusters a path from `p_begin_poly` to `p_end_poly` should go
+	/// through in `r_scratch`. Returns `false` if the graph can't be used for
+	/// this query, or if it found no route.
+	bool find_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, gd::PathQueryScratch &r_scratch) const;
+};
+
+#endif // NAV_CLUSTER_GRAPH_H
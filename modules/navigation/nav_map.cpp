@@ -31,6 +31,7 @@
 #include "nav_map.h"
 
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
 #include "nav_link.h"
 #include "nav_region.h"
 #include "rvo_agent.h"
@@ -38,6 +39,132 @@
 
 #define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (((m_c) - (m_a)).cross((m_b) - (m_a)))
 
+#define POLYGON_BVH_LEAF_SIZE 4
+#define POLYGON_BVH_STACK_SIZE 64
+
+static _FORCE_INLINE_ real_t _aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+	return p_point.clamp(p_aabb.position, p_aabb.position + p_aabb.size).distance_squared_to(p_point);
+}
+
+static _FORCE_INLINE_ real_t _aabb_distance_squared(const AABB &p_a, const AABB &p_b) {
+	real_t ds = 0.0;
+	for (int i = 0; i < 3; i++) {
+		const real_t gap = MAX(p_a.position[i] - (p_b.position[i] + p_b.size[i]), p_b.position[i] - (p_a.position[i] + p_a.size[i]));
+		if (gap > 0.0) {
+			ds += gap * gap;
+		}
+	}
+	return ds;
+}
+
+struct PolygonBVHAxisCompare {
+	const AABB *aabbs = nullptr;
+	int axis = 0;
+
+	_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+		return aabbs[p_a].get_center()[axis] < aabbs[p_b].get_center()[axis];
+	}
+};
+
+// Closest point on the polygons of the map to a point, within a maximum distance.
+struct ClosestPolygonQuery {
+	Vector3 point;
+	bool use_layers = false;
+	uint32_t navigation_layers = 0;
+
+	real_t closest_distance = 0.0; // Squared.
+	int closest_polygon = -1;
+	Vector3 closest_point;
+	Vector3 closest_normal;
+
+	_FORCE_INLINE_ real_t get_aabb_distance(const AABB &p_aabb) const {
+		return _aabb_distance_squared(p_aabb, point);
+	}
+
+	_FORCE_INLINE_ void test_polygon(const gd::Polygon &p_polygon, uint32_t p_index) {
+		// Only consider the polygon if it in a region with compatible layers.
+		if (use_layers && (navigation_layers & p_polygon.owner->get_navigation_layers()) == 0) {
+			return;
+		}
+
+		// For each face check the distance to the point.
+		for (uint32_t point_id = 2; point_id < p_polygon.points.size(); point_id++) {
+			const Face3 face(p_polygon.points[0].pos, p_polygon.points[point_id - 1].pos, p_polygon.points[point_id].pos);
+			const Vector3 face_point = face.get_closest_point_to(point);
+			const real_t ds = face_point.distance_squared_to(point);
+			if (ds < closest_distance) {
+				closest_distance = ds;
+				closest_polygon = p_index;
+				closest_point = face_point;
+				closest_normal = face.get_plane().normal;
+			}
+		}
+	}
+};
+
+// Intersection of a segment with the polygons of the map that is the closest to the segment start.
+struct SegmentIntersectionQuery {
+	Vector3 from;
+	Vector3 to;
+
+	real_t closest_distance = INFINITY; // Squared.
+	Vector3 closest_point;
+
+	_FORCE_INLINE_ real_t get_aabb_distance(const AABB &p_aabb) const {
+		if (!p_aabb.intersects_segment(from, to)) {
+			return INFINITY;
+		}
+		return _aabb_distance_squared(p_aabb, from);
+	}
+
+	_FORCE_INLINE_ void test_polygon(const gd::Polygon &p_polygon, uint32_t p_index) {
+		for (uint32_t point_id = 2; point_id < p_polygon.points.size(); point_id++) {
+			const Face3 face(p_polygon.points[0].pos, p_polygon.points[point_id - 1].pos, p_polygon.points[point_id].pos);
+			Vector3 inters;
+			if (face.intersects_segment(from, to, &inters)) {
+				const real_t ds = from.distance_squared_to(inters);
+				if (ds < closest_distance) {
+					closest_distance = ds;
+					closest_point = inters;
+				}
+			}
+		}
+	}
+};
+
+// Point of the polygon edges of the map that is the closest to a segment.
+struct SegmentClosestEdgeQuery {
+	Vector3 from;
+	Vector3 to;
+	AABB segment_aabb;
+
+	real_t closest_distance = INFINITY; // Squared.
+	Vector3 closest_point;
+
+	_FORCE_INLINE_ real_t get_aabb_distance(const AABB &p_aabb) const {
+		return _aabb_distance_squared(p_aabb, segment_aabb);
+	}
+
+	_FORCE_INLINE_ void test_polygon(const gd::Polygon &p_polygon, uint32_t p_index) {
+		for (uint32_t point_id = 0; point_id < p_polygon.points.size(); point_id++) {
+			Vector3 a, b;
+			Geometry3D::get_closest_points_between_segments(
+					from,
+					to,
+					p_polygon.points[point_id].pos,
+					p_polygon.points[(point_id + 1) % p_polygon.points.size()].pos,
+					a,
+					b);
+
+			const real_t ds = a.distance_squared_to(b);
+			if (ds < closest_distance) {
+				closest_distance = ds;
+				closest_point = b;
+			}
+		}
+	}
+};
+
 void NavMap::set_up(Vector3 p_up) {
 	up = p_up;
 	regenerate_polygons = true;
@@ -58,6 +185,11 @@ void NavMap::set_link_connection_radius(float p_link_connection_radius) {
 	regenerate_links = true;
 }
 
+void NavMap::set_cluster_size(real_t p_cluster_size) {
+	cluster_graph.set_cluster_size(p_cluster_size);
+	regenerate_links = true;
+}
+
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	const int x = int(Math::floor(p_pos.x / cell_size));
 	const int y = int(Math::floor(p_pos.y / cell_size));
@@ -72,48 +204,56 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 }
 
 Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) const {
-	// Find the start poly and the end poly on this map.
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
-	Vector3 begin_point;
-	Vector3 end_point;
-	float begin_d = 1e20;
-	float end_d = 1e20;
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
+	gd::PathQueryScratch scratch;
+	return get_path(p_origin, p_destination, p_optimize, p_navigation_layers, scratch);
+}
 
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
+void NavMap::get_paths(const Vector<Vector3> &p_origins, const Vector<Vector3> &p_destinations, bool p_optimize, uint32_t p_navigation_layers, Vector<Vector<Vector3>> &r_paths) const {
+	ERR_FAIL_COND(p_origins.size() != p_destinations.size());
 
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+	r_paths.resize(p_origins.size());
+	if (p_origins.is_empty()) {
+		return;
+	}
 
-			Vector3 point = face.get_closest_point_to(p_origin);
-			float distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
+	PathBatch batch;
+	batch.origins = p_origins.ptr();
+	batch.destinations = p_destinations.ptr();
+	batch.optimize = p_optimize;
+	batch.navigation_layers = p_navigation_layers;
+	batch.paths = r_paths.ptrw();
+	batch.path_count = p_origins.size();
 
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
+	// Split the queries in a few chunks per thread, each chunk reuses its search scratch between its queries.
+	const uint32_t chunk_count = MIN(batch.path_count, uint32_t(MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * 4));
+	batch.chunk_size = (batch.path_count + chunk_count - 1) / chunk_count;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::_get_path_batch_chunk, &batch, chunk_count, -1, true, SNAME("NavigationMapPaths"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void NavMap::_get_path_batch_chunk(uint32_t p_chunk, const PathBatch *p_batch) const {
+	gd::PathQueryScratch scratch;
+	const uint32_t from = p_chunk * p_batch->chunk_size;
+	const uint32_t to = MIN(from + p_batch->chunk_size, p_batch->path_count);
+	for (uint32_t i = from; i < to; i++) {
+		p_batch->paths[i] = get_path(p_batch->origins[i], p_batch->destinations[i], p_batch->optimize, p_batch->navigation_layers, scratch);
 	}
+}
+
+Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, gd::PathQueryScratch &r_scratch) const {
+	// Find the start poly and the end poly on this map.
+	Vector3 begin_point;
+	Vector3 end_point;
+	const int begin_index = _get_closest_polygon(p_origin, INFINITY, true, p_navigation_layers, begin_point);
+	const int end_index = _get_closest_polygon(p_destination, INFINITY, true, p_navigation_layers, end_point);
 
 	// Check for trivial cases
-	if (!begin_poly || !end_poly) {
+	if (begin_index < 0 || end_index < 0) {
 		return Vector<Vector3>();
 	}
+	const gd::Polygon *begin_poly = &polygons[begin_index];
+	const gd::Polygon *end_poly = &polygons[end_index];
 	if (begin_poly == end_poly) {
 		Vector<Vector3> path;
 		path.resize(2);
@@ -122,8 +262,26 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
+	Vector<Vector3> path;
+	// Find the clusters to go through first, and only search their polygons.
+	if (cluster_graph.find_corridor(begin_poly, begin_point, end_poly, end_point, p_navigation_layers, r_scratch) &&
+			_find_path(p_destination, p_optimize, p_navigation_layers, begin_poly, begin_point, end_poly, end_point, true, r_scratch, path)) {
+		return path;
+	}
+
+	_find_path(p_destination, p_optimize, p_navigation_layers, begin_poly, begin_point, end_poly, end_point, false, r_scratch, path);
+	return path;
+}
+
+bool NavMap::_find_path(const Vector3 &p_destination, bool p_optimize, uint32_t p_navigation_layers, const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, bool p_use_corridor, gd::PathQueryScratch &r_scratch, Vector<Vector3> &r_path) const {
+	const gd::Polygon *begin_poly = p_begin_poly;
+	const Vector3 begin_point = p_begin_point;
+	const gd::Polygon *end_poly = p_end_poly;
+	Vector3 end_point = p_end_point;
+
 	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
+	LocalVector<gd::NavigationPoly> &navigation_polys = r_scratch.navigation_polys;
+	navigation_polys.clear();
 	navigation_polys.reserve(polygons.size() * 0.75);
 
 	// Add the start polygon to the reachable navigation polygons.
@@ -135,7 +293,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	navigation_polys.push_back(begin_navigation_poly);
 
 	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
+	LocalVector<uint32_t> &to_visit = r_scratch.to_visit;
+	to_visit.clear();
 	to_visit.push_back(0);
 
 	// This is an implementation of the A* algorithm.
@@ -164,6 +323,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				// Stay in the corridor of clusters found by the cluster graph.
+				if (p_use_corridor && !r_scratch.is_in_corridor(connection.polygon)) {
+					continue;
+				}
+
 				float poly_enter_cost = 0.0;
 				float poly_travel_cost = least_cost_poly->poly->owner->get_travel_cost();
 
@@ -212,6 +376,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
 		if (to_visit.size() == 0) {
+			// The corridor doesn't lead to the end, the caller does a full search instead.
+			if (p_use_corridor) {
+				return false;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -222,7 +391,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 			// Set as end point the furthest reachable point.
 			end_poly = reachable_end;
-			end_d = 1e20;
+			real_t end_d = 1e20;
 			for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
 				Face3 f(end_poly->points[0].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
 				Vector3 spoint = f.get_closest_point_to(p_destination);
@@ -249,8 +418,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		// Find the polygon with the minimum cost from the list of polygons to visit.
 		least_cost_id = -1;
 		float least_cost = 1e30;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
+		for (uint32_t i = 0; i < to_visit.size(); i++) {
+			gd::NavigationPoly *np = &navigation_polys[to_visit[i]];
 			float cost = np->traveled_distance;
 			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
 			if (cost < least_cost) {
@@ -279,10 +448,12 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 	// If we did not find a route, return an empty path.
 	if (!found_route) {
-		return Vector<Vector3>();
+		r_path = Vector<Vector3>();
+		return false;
 	}
 
-	Vector<Vector3> path;
+	Vector<Vector3> &path = r_path;
+	path.clear();
 	// Optimize the path.
 	if (p_optimize) {
 		// Set the apex poly/point to the end point
@@ -382,56 +553,29 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		path.reverse();
 	}
 
-	return path;
+	return true;
 }
 
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
-	bool use_collision = p_use_collision;
-	Vector3 closest_point;
-	real_t closest_point_d = 1e20;
-
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
-				}
-			}
-		}
-
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
-
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
-
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
-				}
-			}
-		}
+	// Prefer the intersection that is the closest to the segment start.
+	SegmentIntersectionQuery intersection_query;
+	intersection_query.from = p_from;
+	intersection_query.to = p_to;
+	_query_polygon_bvh(intersection_query);
+
+	if (intersection_query.closest_distance < INFINITY || p_use_collision) {
+		return intersection_query.closest_point;
 	}
 
-	return closest_point;
+	// Otherwise use the point of the polygon edges that is the closest to the segment.
+	SegmentClosestEdgeQuery edge_query;
+	edge_query.from = p_from;
+	edge_query.to = p_to;
+	edge_query.segment_aabb = AABB(p_from, Vector3());
+	edge_query.segment_aabb.expand_to(p_to);
+	_query_polygon_bvh(edge_query);
+
+	return edge_query.closest_point;
 }
 
 Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
@@ -451,23 +595,10 @@ RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
 
 gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = 1e20;
-
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
 
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
-			}
-		}
+	const int closest_index = _get_closest_polygon(p_point, INFINITY, false, 0, result.point, &result.normal);
+	if (closest_index >= 0) {
+		result.owner = polygons[closest_index].owner->get_self();
 	}
 
 	return result;
@@ -507,6 +638,9 @@ void NavMap::add_agent(RvoAgent *agent) {
 	if (!has_agent(agent)) {
 		agents.push_back(agent);
 		agents_dirty = true;
+		if (avoidance_callback.is_valid()) {
+			set_agent_as_controlled(agent);
+		}
 	}
 }
 
@@ -524,6 +658,7 @@ void NavMap::set_agent_as_controlled(RvoAgent *agent) {
 	if (!exist) {
 		ERR_FAIL_COND(!has_agent(agent));
 		controlled_agents.push_back(agent);
+		agents_dirty = true;
 	}
 }
 
@@ -535,6 +670,19 @@ void NavMap::remove_agent_as_controlled(RvoAgent *agent) {
 	}
 }
 
+void NavMap::set_avoidance_callback(const Callable &p_callback) {
+	avoidance_callback = p_callback;
+
+	// The map callback needs the velocity of every agent, the others only of the ones with a callback.
+	for (uint32_t i = 0; i < agents.size(); i++) {
+		if (avoidance_callback.is_valid()) {
+			set_agent_as_controlled(agents[i]);
+		} else if (!agents[i]->has_callback()) {
+			remove_agent_as_controlled(agents[i]);
+		}
+	}
+}
+
 void NavMap::sync() {
 	// Check if we need to update the links.
 	if (regenerate_polygons) {
@@ -567,6 +715,7 @@ void NavMap::sync() {
 		for (uint32_t r = 0; r < regions.size(); r++) {
 			count += regions[r]->get_polygons().size();
 		}
+
 		polygons.resize(count);
 
 		// Copy all region polygons in the map.
@@ -579,6 +728,8 @@ void NavMap::sync() {
 			count += regions[r]->get_polygons().size();
 		}
 
+		_build_polygon_bvh();
+
 		// Group all edges per key.
 		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
 		for (uint32_t poly_id = 0; poly_id < polygons.size(); poly_id++) {
@@ -694,51 +845,14 @@ void NavMap::sync() {
 			const Vector3 start = link->get_start_location();
 			const Vector3 end = link->get_end_location();
 
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
+			// Pick the closest polygons within the search radius of the start and end points.
 			Vector3 closest_start_point;
+			const int closest_start_index = _get_closest_polygon(start, link_connection_radius, false, 0, closest_start_point);
+			gd::Polygon *closest_start_polygon = closest_start_index >= 0 ? &polygons[closest_start_index] : nullptr;
 
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
 			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
-
-			// Find any polygons within the search radius of the end point.
-			for (uint32_t end_index = 0; end_index < polygons.size(); end_index++) {
-				gd::Polygon &end_poly = polygons[end_index];
-
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
-			}
+			const int closest_end_index = _get_closest_polygon(end, link_connection_radius, false, 0, closest_end_point);
+			gd::Polygon *closest_end_polygon = closest_end_index >= 0 ? &polygons[closest_end_index] : nullptr;
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
 			if (closest_start_polygon && closest_end_polygon) {
@@ -799,19 +913,28 @@ void NavMap::sync() {
 			}
 		}
 
+		link_polygons.resize(link_poly_idx);
+
+		// Group the polygons in clusters for the long path queries.
+		cluster_graph.build(polygons, link_polygons);
+
 		// Update the update ID.
 		map_update_id = (map_update_id + 1) % 9999999;
 	}
 
-	// Update agents tree.
+	// Update agents grid.
 	if (agents_dirty) {
-		// cannot use LocalVector here as RVO library expects std::vector to build KdTree
-		std::vector<RVO::Agent *> raw_agents;
-		raw_agents.reserve(agents.size());
-		for (size_t i(0); i < agents.size(); i++) {
-			raw_agents.push_back(agents[i]->get_agent());
+		agent_grid.clear();
+
+		// The array is shared with the avoidance callback, so it's replaced instead of
+		// modified, and read-only so the callback can't change it either.
+		TypedArray<RID> agent_rids;
+		agent_rids.resize(controlled_agents.size());
+		for (uint32_t i = 0; i < controlled_agents.size(); i++) {
+			agent_rids[i] = controlled_agents[i]->get_self();
 		}
-		rvo.buildAgentTree(raw_agents);
+		agent_rids.set_read_only(true);
+		avoidance_agent_rids = agent_rids;
 	}
 
 	regenerate_polygons = false;
@@ -819,14 +942,132 @@ void NavMap::sync() {
 	agents_dirty = false;
 }
 
+void NavMap::_build_polygon_bvh() {
+	polygon_bvh.clear();
+	polygon_bvh_indices.resize(polygons.size());
+	if (polygons.is_empty()) {
+		return;
+	}
+
+	LocalVector<AABB> polygon_aabbs;
+	polygon_aabbs.resize(polygons.size());
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		const gd::Polygon &p = polygons[i];
+		AABB aabb;
+		if (p.points.size() > 0) {
+			aabb.position = p.points[0].pos;
+			for (uint32_t j = 1; j < p.points.size(); j++) {
+				aabb.expand_to(p.points[j].pos);
+			}
+		}
+		// Flat polygons would have flat bounds, which are unreliable for segment tests.
+		polygon_aabbs[i] = aabb.grow(CMP_EPSILON);
+		polygon_bvh_indices[i] = i;
+	}
+
+	polygon_bvh.reserve(2 * (polygons.size() / POLYGON_BVH_LEAF_SIZE) + 1);
+	polygon_bvh.resize(1);
+	_build_polygon_bvh_node(0, 0, polygons.size(), polygon_aabbs);
+}
+
+void NavMap::_build_polygon_bvh_node(uint32_t p_node, uint32_t p_from, uint32_t p_count, const LocalVector<AABB> &p_polygon_aabbs) {
+	AABB aabb = p_polygon_aabbs[polygon_bvh_indices[p_from]];
+	AABB centers(aabb.get_center(), Vector3());
+	for (uint32_t i = p_from + 1; i < p_from + p_count; i++) {
+		const AABB &polygon_aabb = p_polygon_aabbs[polygon_bvh_indices[i]];
+		aabb.merge_with(polygon_aabb);
+		centers.expand_to(polygon_aabb.get_center());
+	}
+	polygon_bvh[p_node].aabb = aabb;
+
+	if (p_count <= POLYGON_BVH_LEAF_SIZE) {
+		polygon_bvh[p_node].first = p_from;
+		polygon_bvh[p_node].count = p_count;
+		return;
+	}
+
+	// Split at the median polygon along the longest axis of their centers.
+	const uint32_t half = p_count / 2;
+	SortArray<uint32_t, PolygonBVHAxisCompare> sorter;
+	sorter.compare.aabbs = p_polygon_aabbs.ptr();
+	sorter.compare.axis = centers.get_longest_axis_index();
+	sorter.nth_element(p_from, p_from + p_count, p_from + half, polygon_bvh_indices.ptr());
+
+	// Don't keep a reference to the node, adding the children may reallocate.
+	const uint32_t child = polygon_bvh.size();
+	polygon_bvh.resize(child + 2);
+	polygon_bvh[p_node].first = child;
+	polygon_bvh[p_node].count = 0;
+
+	_build_polygon_bvh_node(child, p_from, half, p_polygon_aabbs);
+	_build_polygon_bvh_node(child + 1, p_from + half, p_count - half, p_polygon_aabbs);
+}
+
+template <class Q>
+void NavMap::_query_polygon_bvh(Q &p_query) const {
+	if (polygon_bvh.is_empty()) {
+		return;
+	}
+
+	// Visit the nodes closer than the current result, the closest child first.
+	uint32_t stack[POLYGON_BVH_STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const PolygonBVHNode &node = polygon_bvh[stack[--stack_size]];
+		if (!(p_query.get_aabb_distance(node.aabb) < p_query.closest_distance)) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const uint32_t index = polygon_bvh_indices[i];
+				p_query.test_polygon(polygons[index], index);
+			}
+			continue;
+		}
+
+		ERR_FAIL_COND(stack_size + 2 > POLYGON_BVH_STACK_SIZE);
+		uint32_t near_child = node.first;
+		uint32_t far_child = node.first + 1;
+		if (p_query.get_aabb_distance(polygon_bvh[far_child].aabb) < p_query.get_aabb_distance(polygon_bvh[near_child].aabb)) {
+			SWAP(near_child, far_child);
+		}
+		stack[stack_size++] = far_child;
+		stack[stack_size++] = near_child;
+	}
+}
+
+int NavMap::_get_closest_polygon(const Vector3 &p_point, real_t p_max_distance, bool p_use_layers, uint32_t p_navigation_layers, Vector3 &r_point, Vector3 *r_normal) const {
+	ClosestPolygonQuery query;
+	query.point = p_point;
+	query.use_layers = p_use_layers;
+	query.navigation_layers = p_navigation_layers;
+	// Bias the limit a bit, so that polygons at exactly the maximum distance are still found.
+	query.closest_distance = p_max_distance < INFINITY ? p_max_distance * p_max_distance + CMP_EPSILON : INFINITY;
+	_query_polygon_bvh(query);
+
+	if (query.closest_polygon >= 0) {
+		r_point = query.closest_point;
+		if (r_normal) {
+			*r_normal = query.closest_normal;
+		}
+	}
+	return query.closest_polygon;
+}
+
 void NavMap::compute_single_step(uint32_t index, RvoAgent **agent) {
-	(*(agent + index))->get_agent()->computeNeighbors(&rvo);
+	agent_grid.compute_neighbors((*(agent + index))->get_agent());
 	(*(agent + index))->get_agent()->computeNewVelocity(deltatime);
 }
 
 void NavMap::step(real_t p_deltatime) {
 	deltatime = p_deltatime;
+
 	if (controlled_agents.size() > 0) {
+		agent_grid.update(agents);
+
 		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_step, controlled_agents.ptr(), controlled_agents.size(), -1, true, SNAME("NavigationMapAgents"));
 		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 	}
@@ -836,6 +1077,26 @@ void NavMap::dispatch_callbacks() {
 	for (int i(0); i < static_cast<int>(controlled_agents.size()); i++) {
 		controlled_agents[i]->dispatch_callback();
 	}
+
+	if (avoidance_callback.is_valid() && controlled_agents.size() > 0) {
+		ERR_FAIL_COND((uint32_t)avoidance_agent_rids.size() != controlled_agents.size());
+		avoidance_velocities.resize(controlled_agents.size());
+		Vector3 *w = avoidance_velocities.ptrw();
+		for (uint32_t i = 0; i < controlled_agents.size(); i++) {
+			const RVO::Vector3 &velocity = controlled_agents[i]->get_agent()->newVelocity_;
+			w[i] = Vector3(velocity.x(), velocity.y(), velocity.z());
+		}
+
+		Variant agent_rids = avoidance_agent_rids;
+		Variant velocities = avoidance_velocities;
+		const Variant *args[2] = { &agent_rids, &velocities };
+		Variant ret;
+		Callable::CallError ce;
+		avoidance_callback.callp(args, 2, ret, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling the avoidance callback of the navigation map: " + Variant::get_callable_error_text(avoidance_callback, args, 2, ce));
+		}
+	}
 }
 
 void NavMap::clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly) const {
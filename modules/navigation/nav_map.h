@@ -36,10 +36,11 @@
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/templates/rb_map.h"
+#include "core/variant/typed_array.h"
+#include "nav_agent_grid.h"
+#include "nav_cluster_graph.h"
 #include "nav_utils.h"
 
-#include <KdTree.h>
-
 class NavLink;
 class NavRegion;
 class RvoAgent;
@@ -71,8 +72,23 @@ class NavMap : public NavRid {
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
-	/// Rvo world
-	RVO::KdTree rvo;
+	/// Bounding volume hierarchy over the map polygons, rebuilt with them.
+	struct PolygonBVHNode {
+		AABB aabb;
+		/// Inner nodes have their two children next to each other, starting at `first`.
+		/// Leaves have `count` polygons, listed in `polygon_bvh_indices` from `first`.
+		uint32_t first = 0;
+		uint32_t count = 0;
+	};
+
+	LocalVector<PolygonBVHNode> polygon_bvh;
+	LocalVector<uint32_t> polygon_bvh_indices;
+
+	/// Clusters of polygons, used to speed up long path queries.
+	NavClusterGraph cluster_graph;
+
+	/// Spatial hash of the agents, to find the avoidance neighbors.
+	NavAgentGrid agent_grid;
 
 	/// Is agent array modified?
 	bool agents_dirty = false;
@@ -80,9 +96,14 @@ class NavMap : public NavRid {
 	/// All the Agents (even the controlled one)
 	LocalVector<RvoAgent *> agents;
 
-	/// Controlled agents
+	/// Controlled agents, all of them while the map has an avoidance callback.
 	LocalVector<RvoAgent *> controlled_agents;
 
+	/// Receives the new velocity of all the controlled agents at once.
+	Callable avoidance_callback;
+	TypedArray<RID> avoidance_agent_rids;
+	PackedVector3Array avoidance_velocities;
+
 	/// Physics delta time
 	real_t deltatime = 0.0;
 
@@ -113,9 +134,17 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_cluster_size(real_t p_cluster_size);
+	real_t get_cluster_size() const {
+		return cluster_graph.get_cluster_size();
+	}
+
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
 	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const;
+	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, gd::PathQueryScratch &r_scratch) const;
+	/// Runs the path queries in parallel, `r_paths[i]` goes from `p_origins[i]` to `p_destinations[i]`.
+	void get_paths(const Vector<Vector3> &p_origins, const Vector<Vector3> &p_destinations, bool p_optimize, uint32_t p_navigation_layers, Vector<Vector<Vector3>> &r_paths) const;
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
@@ -144,6 +173,11 @@ public:
 	void set_agent_as_controlled(RvoAgent *agent);
 	void remove_agent_as_controlled(RvoAgent *agent);
 
+	void set_avoidance_callback(const Callable &p_callback);
+	Callable get_avoidance_callback() const {
+		return avoidance_callback;
+	}
+
 	uint32_t get_map_update_id() const {
 		return map_update_id;
 	}
@@ -153,6 +187,25 @@ public:
 	void dispatch_callbacks();
 
 private:
+	struct PathBatch {
+		const Vector3 *origins = nullptr;
+		const Vector3 *destinations = nullptr;
+		bool optimize = false;
+		uint32_t navigation_layers = 0;
+		Vector<Vector3> *paths = nullptr;
+		uint32_t path_count = 0;
+		uint32_t chunk_size = 0;
+	};
+
+	void _get_path_batch_chunk(uint32_t p_chunk, const PathBatch *p_batch) const;
+	bool _find_path(const Vector3 &p_destination, bool p_optimize, uint32_t p_navigation_layers, const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, bool p_use_corridor, gd::PathQueryScratch &r_scratch, Vector<Vector3> &r_path) const;
+
+	void _build_polygon_bvh();
+	void _build_polygon_bvh_node(uint32_t p_node, uint32_t p_from, uint32_t p_count, const LocalVector<AABB> &p_polygon_aabbs);
+	template <class Q>
+	void _query_polygon_bvh(Q &p_query) const;
+	int _get_closest_polygon(const Vector3 &p_point, real_t p_max_distance, bool p_use_layers, uint32_t p_navigation_layers, Vector3 &r_point, Vector3 *r_normal = nullptr) const;
+
 	void compute_single_step(uint32_t index, RvoAgent **agent);
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly) const;
 };
@@ -112,6 +112,10 @@ struct Polygon {
 
 	/// The center of this `Polygon`
 	Vector3 center;
+
+	/// The cluster of the map containing this `Polygon`, and its index in it.
+	uint32_t cluster = 0;
+	uint32_t cluster_index = 0;
 };
 
 struct NavigationPoly {
@@ -144,6 +148,41 @@ struct NavigationPoly {
 	}
 };
 
+/// Open list item of the cluster graph searches.
+struct ClusterSearchItem {
+	float cost = 0.0;
+	uint32_t index = 0;
+};
+
+struct ClusterSearchItemCompare {
+	/// Reversed, so that the heap keeps the lowest cost on top.
+	_FORCE_INLINE_ bool operator()(const ClusterSearchItem &p_a, const ClusterSearchItem &p_b) const {
+		return p_a.cost > p_b.cost;
+	}
+};
+
+/// Search state of a path query, kept between queries to reuse its memory.
+struct PathQueryScratch {
+	/// All the reachable navigation polygons.
+	LocalVector<NavigationPoly> navigation_polys;
+	/// Indices of the navigation polygons left to visit.
+	LocalVector<uint32_t> to_visit;
+
+	/// Cluster graph search, see `NavClusterGraph`. The entries with the
+	/// current stamp are the ones written by the current query.
+	LocalVector<float> polygon_costs;
+	LocalVector<float> entrance_costs;
+	LocalVector<uint32_t> entrance_parents;
+	LocalVector<uint32_t> entrance_stamps;
+	LocalVector<uint32_t> cluster_stamps;
+	LocalVector<ClusterSearchItem> open;
+	uint32_t stamp = 0;
+
+	_FORCE_INLINE_ bool is_in_corridor(const Polygon *p_polygon) const {
+		return cluster_stamps[p_polygon->cluster] == stamp;
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
@@ -33,6 +33,7 @@
 #include "navigation_mesh_generator.h"
 
 #include "core/math/convex_hull.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/thread.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/multimesh_instance_3d.h"
@@ -467,14 +468,29 @@ void NavigationMeshGenerator::_parse_geometry(const Transform3D &p_navmesh_trans
 	}
 }
 
-void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh) {
-	Vector<Vector3> nav_vertices;
+void NavigationMeshGenerator::_parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &r_vertices, Vector<int> &r_indices) {
+	List<Node *> parse_nodes;
+
+	if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
+		parse_nodes.push_back(p_node);
+	} else {
+		p_node->get_tree()->get_nodes_in_group(p_nav_mesh->get_source_group_name(), &parse_nodes);
+	}
+
+	Transform3D navmesh_xform = Object::cast_to<Node3D>(p_node)->get_global_transform().affine_inverse();
+	for (Node *E : parse_nodes) {
+		NavigationMesh::ParsedGeometryType geometry_type = p_nav_mesh->get_parsed_geometry_type();
+		uint32_t collision_mask = p_nav_mesh->get_collision_mask();
+		bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
+		_parse_geometry(navmesh_xform, E, r_vertices, r_indices, geometry_type, collision_mask, recurse_children);
+	}
+}
 
+void NavigationMeshGenerator::_convert_detail_mesh(const rcPolyMeshDetail *p_detail_mesh, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
 	for (int i = 0; i < p_detail_mesh->nverts; i++) {
 		const float *v = &p_detail_mesh->verts[i * 3];
-		nav_vertices.push_back(Vector3(v[0], v[1], v[2]));
+		r_vertices.push_back(Vector3(v[0], v[1], v[2]));
 	}
-	p_nav_mesh->set_vertices(nav_vertices);
 
 	for (int i = 0; i < p_detail_mesh->nmeshes; i++) {
 		const unsigned int *m = &p_detail_mesh->meshes[i * 4];
@@ -489,87 +505,67 @@ void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(con
 			nav_indices.write[0] = ((int)(bverts + tris[j * 4 + 0]));
 			nav_indices.write[1] = ((int)(bverts + tris[j * 4 + 2]));
 			nav_indices.write[2] = ((int)(bverts + tris[j * 4 + 1]));
-			p_nav_mesh->add_polygon(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 }
 
-void NavigationMeshGenerator::_build_recast_navigation_mesh(
-		Ref<NavigationMesh> p_nav_mesh,
-#ifdef TOOLS_ENABLED
-		EditorProgress *ep,
-#endif
-		rcHeightfield *hf,
-		rcCompactHeightfield *chf,
-		rcContourSet *cset,
-		rcPolyMesh *poly_mesh,
-		rcPolyMeshDetail *detail_mesh,
-		Vector<float> &vertices,
-		Vector<int> &indices) {
-	rcContext ctx;
+void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh) {
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	_convert_detail_mesh(p_detail_mesh, nav_vertices, nav_polygons);
 
-#ifdef TOOLS_ENABLED
-	if (ep) {
-		ep->step(TTR("Setting up Configuration..."), 1);
+	p_nav_mesh->set_vertices(nav_vertices);
+	for (int i = 0; i < nav_polygons.size(); i++) {
+		p_nav_mesh->add_polygon(nav_polygons[i]);
 	}
-#endif
-
-	const float *verts = vertices.ptr();
-	const int nverts = vertices.size() / 3;
-	const int *tris = indices.ptr();
-	const int ntris = indices.size() / 3;
-
-	float bmin[3], bmax[3];
-	rcCalcBounds(verts, nverts, bmin, bmax);
+}
 
-	rcConfig cfg;
-	memset(&cfg, 0, sizeof(cfg));
-
-	cfg.cs = p_nav_mesh->get_cell_size();
-	cfg.ch = p_nav_mesh->get_cell_height();
-	cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
-	cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / cfg.ch);
-	cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / cfg.ch);
-	cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / cfg.cs);
-	cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
-	cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
-	cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
-	cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
-	cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
-	cfg.detailSampleDist = MAX(p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance(), 0.1f);
-	cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
-
-	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_nav_mesh->get_agent_height())) {
+void NavigationMeshGenerator::_init_recast_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg) {
+	memset(&r_cfg, 0, sizeof(r_cfg));
+
+	r_cfg.cs = p_nav_mesh->get_cell_size();
+	r_cfg.ch = p_nav_mesh->get_cell_height();
+	r_cfg.walkableSlopeAngle = p_nav_mesh->get_agent_max_slope();
+	r_cfg.walkableHeight = (int)Math::ceil(p_nav_mesh->get_agent_height() / r_cfg.ch);
+	r_cfg.walkableClimb = (int)Math::floor(p_nav_mesh->get_agent_max_climb() / r_cfg.ch);
+	r_cfg.walkableRadius = (int)Math::ceil(p_nav_mesh->get_agent_radius() / r_cfg.cs);
+	r_cfg.maxEdgeLen = (int)(p_nav_mesh->get_edge_max_length() / p_nav_mesh->get_cell_size());
+	r_cfg.maxSimplificationError = p_nav_mesh->get_edge_max_error();
+	r_cfg.minRegionArea = (int)(p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size());
+	r_cfg.mergeRegionArea = (int)(p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size());
+	r_cfg.maxVertsPerPoly = (int)p_nav_mesh->get_verts_per_poly();
+	r_cfg.detailSampleDist = MAX(p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance(), 0.1f);
+	r_cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
+
+	if (!Math::is_equal_approx((float)r_cfg.walkableHeight * r_cfg.ch, p_nav_mesh->get_agent_height())) {
 		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.walkableClimb * cfg.ch, p_nav_mesh->get_agent_max_climb())) {
+	if (!Math::is_equal_approx((float)r_cfg.walkableClimb * r_cfg.ch, p_nav_mesh->get_agent_max_climb())) {
 		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.walkableRadius * cfg.cs, p_nav_mesh->get_agent_radius())) {
+	if (!Math::is_equal_approx((float)r_cfg.walkableRadius * r_cfg.cs, p_nav_mesh->get_agent_radius())) {
 		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.maxEdgeLen * cfg.cs, p_nav_mesh->get_edge_max_length())) {
+	if (!Math::is_equal_approx((float)r_cfg.maxEdgeLen * r_cfg.cs, p_nav_mesh->get_edge_max_length())) {
 		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.minRegionArea, p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size())) {
+	if (!Math::is_equal_approx((float)r_cfg.minRegionArea, p_nav_mesh->get_region_min_size() * p_nav_mesh->get_region_min_size())) {
 		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.mergeRegionArea, p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size())) {
+	if (!Math::is_equal_approx((float)r_cfg.mergeRegionArea, p_nav_mesh->get_region_merge_size() * p_nav_mesh->get_region_merge_size())) {
 		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.maxVertsPerPoly, p_nav_mesh->get_verts_per_poly())) {
+	if (!Math::is_equal_approx((float)r_cfg.maxVertsPerPoly, p_nav_mesh->get_verts_per_poly())) {
 		WARN_PRINT("Property verts_per_poly is converted to int and loses precision.");
 	}
 	if (p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance() < 0.1f) {
 		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
 	}
+}
 
-	cfg.bmin[0] = bmin[0];
-	cfg.bmin[1] = bmin[1];
-	cfg.bmin[2] = bmin[2];
-	cfg.bmax[0] = bmax[0];
-	cfg.bmax[1] = bmax[1];
-	cfg.bmax[2] = bmax[2];
+void NavigationMeshGenerator::_get_recast_bounds(Ref<NavigationMesh> p_nav_mesh, const float *p_verts, int p_nverts, float *r_bmin, float *r_bmax) {
+	rcCalcBounds(p_verts, p_nverts, r_bmin, r_bmax);
 
 	AABB baking_aabb = p_nav_mesh->get_filter_baking_aabb();
 
@@ -578,13 +574,44 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	if (!aabb_has_no_volume) {
 		Vector3 baking_aabb_offset = p_nav_mesh->get_filter_baking_aabb_offset();
 
-		cfg.bmin[0] = baking_aabb.position[0] + baking_aabb_offset.x;
-		cfg.bmin[1] = baking_aabb.position[1] + baking_aabb_offset.y;
-		cfg.bmin[2] = baking_aabb.position[2] + baking_aabb_offset.z;
-		cfg.bmax[0] = cfg.bmin[0] + baking_aabb.size[0];
-		cfg.bmax[1] = cfg.bmin[1] + baking_aabb.size[1];
-		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
+		r_bmin[0] = baking_aabb.position[0] + baking_aabb_offset.x;
+		r_bmin[1] = baking_aabb.position[1] + baking_aabb_offset.y;
+		r_bmin[2] = baking_aabb.position[2] + baking_aabb_offset.z;
+		r_bmax[0] = r_bmin[0] + baking_aabb.size[0];
+		r_bmax[1] = r_bmin[1] + baking_aabb.size[1];
+		r_bmax[2] = r_bmin[2] + baking_aabb.size[2];
 	}
+}
+
+void NavigationMeshGenerator::_build_recast_navigation_mesh(
+		Ref<NavigationMesh> p_nav_mesh,
+#ifdef TOOLS_ENABLED
+		EditorProgress *ep,
+#endif
+		rcHeightfield *hf,
+		rcCompactHeightfield *chf,
+		rcContourSet *cset,
+		rcPolyMesh *poly_mesh,
+		rcPolyMeshDetail *detail_mesh,
+		Vector<float> &vertices,
+		Vector<int> &indices) {
+	rcContext ctx;
+
+#ifdef TOOLS_ENABLED
+	if (ep) {
+		ep->step(TTR("Setting up Configuration..."), 1);
+	}
+#endif
+
+	const float *verts = vertices.ptr();
+	const int nverts = vertices.size() / 3;
+	const int *tris = indices.ptr();
+	const int ntris = indices.size() / 3;
+
+	rcConfig cfg;
+	_init_recast_config(p_nav_mesh, cfg);
+
+	_get_recast_bounds(p_nav_mesh, verts, nverts, cfg.bmin, cfg.bmax);
 
 #ifdef TOOLS_ENABLED
 	if (ep) {
@@ -719,6 +746,233 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	detail_mesh = nullptr;
 }
 
+bool NavigationMeshGenerator::_build_recast_tile(
+		const TiledBake *p_bake,
+		const Vector2i &p_tile,
+		rcHeightfield *&r_hf,
+		rcCompactHeightfield *&r_chf,
+		rcContourSet *&r_cset,
+		rcPolyMesh *&r_poly_mesh,
+		rcPolyMeshDetail *&r_detail_mesh) {
+	rcContext ctx;
+	rcConfig cfg = p_bake->cfg;
+
+	// The tile bounds are snapped to the cells, so every tile voxelizes the geometry on the same grid.
+	const float tile_world_size = cfg.tileSize * cfg.cs;
+	const float border_world_size = cfg.borderSize * cfg.cs;
+	cfg.bmin[0] = MAX(p_tile.x * tile_world_size, Math::floor(p_bake->cfg.bmin[0] / cfg.cs) * cfg.cs) - border_world_size;
+	cfg.bmin[2] = MAX(p_tile.y * tile_world_size, Math::floor(p_bake->cfg.bmin[2] / cfg.cs) * cfg.cs) - border_world_size;
+	cfg.bmax[0] = MIN((p_tile.x + 1) * tile_world_size, Math::ceil(p_bake->cfg.bmax[0] / cfg.cs) * cfg.cs) + border_world_size;
+	cfg.bmax[2] = MIN((p_tile.y + 1) * tile_world_size, Math::ceil(p_bake->cfg.bmax[2] / cfg.cs) * cfg.cs) + border_world_size;
+	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+
+	LocalVector<int> tile_tris;
+	for (int i = 0; i < p_bake->ntris; i++) {
+		const int *tri = &p_bake->tris[i * 3];
+		float tri_min[2] = { INFINITY, INFINITY };
+		float tri_max[2] = { -INFINITY, -INFINITY };
+		for (int j = 0; j < 3; j++) {
+			const float *v = &p_bake->verts[tri[j] * 3];
+			tri_min[0] = MIN(tri_min[0], v[0]);
+			tri_min[1] = MIN(tri_min[1], v[2]);
+			tri_max[0] = MAX(tri_max[0], v[0]);
+			tri_max[1] = MAX(tri_max[1], v[2]);
+		}
+		if (tri_max[0] < cfg.bmin[0] || tri_min[0] > cfg.bmax[0] || tri_max[1] < cfg.bmin[2] || tri_min[1] > cfg.bmax[2]) {
+			continue;
+		}
+		tile_tris.push_back(tri[0]);
+		tile_tris.push_back(tri[1]);
+		tile_tris.push_back(tri[2]);
+	}
+
+	if (tile_tris.is_empty()) {
+		return true;
+	}
+	const int ntris = tile_tris.size() / 3;
+
+	r_hf = rcAllocHeightfield();
+	ERR_FAIL_COND_V(!r_hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *r_hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch), false);
+
+	{
+		LocalVector<unsigned char> tri_areas;
+		tri_areas.resize(ntris);
+		memset(tri_areas.ptr(), 0, ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, p_bake->verts, p_bake->nverts, tile_tris.ptr(), ntris, tri_areas.ptr());
+
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_bake->verts, p_bake->nverts, tile_tris.ptr(), tri_areas.ptr(), ntris, *r_hf, cfg.walkableClimb), false);
+	}
+
+	if (p_bake->filter_low_hanging_obstacles) {
+		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *r_hf);
+	}
+	if (p_bake->filter_ledge_spans) {
+		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *r_hf);
+	}
+	if (p_bake->filter_walkable_low_height_spans) {
+		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *r_hf);
+	}
+
+	r_chf = rcAllocCompactHeightfield();
+	ERR_FAIL_COND_V(!r_chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *r_hf, *r_chf), false);
+
+	rcFreeHeightField(r_hf);
+	r_hf = nullptr;
+
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *r_chf), false);
+
+	if (p_bake->partition_type == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *r_chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *r_chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
+	} else if (p_bake->partition_type == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *r_chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
+	} else {
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *r_chf, cfg.borderSize, cfg.minRegionArea), false);
+	}
+
+	r_cset = rcAllocContourSet();
+	ERR_FAIL_COND_V(!r_cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *r_chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *r_cset), false);
+
+	if (r_cset->nconts == 0) {
+		// Nothing walkable in this tile.
+		return true;
+	}
+
+	r_poly_mesh = rcAllocPolyMesh();
+	ERR_FAIL_COND_V(!r_poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *r_cset, cfg.maxVertsPerPoly, *r_poly_mesh), false);
+
+	r_detail_mesh = rcAllocPolyMeshDetail();
+	ERR_FAIL_COND_V(!r_detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *r_poly_mesh, *r_chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *r_detail_mesh), false);
+
+	return true;
+}
+
+void NavigationMeshGenerator::_bake_tile(uint32_t p_index, TiledBake *p_bake) {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+
+	if (_build_recast_tile(p_bake, p_bake->tiles[p_index], hf, chf, cset, poly_mesh, detail_mesh) && detail_mesh) {
+		NavigationMesh::BakedTile &tile = p_bake->results[p_index];
+		_convert_detail_mesh(detail_mesh, tile.vertices, tile.polygons);
+	}
+
+	rcFreeHeightField(hf);
+	rcFreeCompactHeightfield(chf);
+	rcFreeContourSet(cset);
+	rcFreePolyMesh(poly_mesh);
+	rcFreePolyMeshDetail(detail_mesh);
+}
+
+void NavigationMeshGenerator::_bake_tiles(Ref<NavigationMesh> p_nav_mesh, Vector<float> &p_vertices, Vector<int> &p_indices, const Vector<AABB> *p_changed_aabbs) {
+	p_nav_mesh->clear_polygons();
+
+	if (p_vertices.size() == 0 || p_indices.size() == 0) {
+		p_nav_mesh->set_vertices(Vector<Vector3>());
+		p_nav_mesh->set_baked_tiles(HashMap<Vector2i, NavigationMesh::BakedTile>());
+		return;
+	}
+
+	TiledBake bake;
+	bake.verts = p_vertices.ptr();
+	bake.nverts = p_vertices.size() / 3;
+	bake.tris = p_indices.ptr();
+	bake.ntris = p_indices.size() / 3;
+	bake.filter_low_hanging_obstacles = p_nav_mesh->get_filter_low_hanging_obstacles();
+	bake.filter_ledge_spans = p_nav_mesh->get_filter_ledge_spans();
+	bake.filter_walkable_low_height_spans = p_nav_mesh->get_filter_walkable_low_height_spans();
+	bake.partition_type = p_nav_mesh->get_sample_partition_type();
+
+	rcConfig &cfg = bake.cfg;
+	_init_recast_config(p_nav_mesh, cfg);
+	_get_recast_bounds(p_nav_mesh, bake.verts, bake.nverts, cfg.bmin, cfg.bmax);
+	cfg.tileSize = p_nav_mesh->get_tile_size();
+	// Tiles voxelize a few cells of their neighbors too, so erosion and regions agree along the tile edges.
+	cfg.borderSize = cfg.walkableRadius + 3;
+
+	const real_t tile_world_size = cfg.tileSize * cfg.cs;
+	const Vector2i tile_min(Math::floor(cfg.bmin[0] / tile_world_size), Math::floor(cfg.bmin[2] / tile_world_size));
+	const Vector2i tile_max(
+			MAX((int)Math::ceil(cfg.bmax[0] / tile_world_size) - 1, tile_min.x),
+			MAX((int)Math::ceil(cfg.bmax[2] / tile_world_size) - 1, tile_min.y));
+
+	HashMap<Vector2i, NavigationMesh::BakedTile> baked_tiles;
+	HashSet<Vector2i> dirty_tiles;
+	if (p_changed_aabbs) {
+		baked_tiles = p_nav_mesh->get_baked_tiles();
+
+		const real_t border_world_size = cfg.borderSize * cfg.cs;
+		for (int i = 0; i < p_changed_aabbs->size(); i++) {
+			const AABB &aabb = (*p_changed_aabbs)[i];
+			const Vector2i from(
+					MAX((int)Math::floor((aabb.position.x - border_world_size) / tile_world_size), tile_min.x),
+					MAX((int)Math::floor((aabb.position.z - border_world_size) / tile_world_size), tile_min.y));
+			const Vector2i to(
+					MIN((int)Math::floor((aabb.position.x + aabb.size.x + border_world_size) / tile_world_size), tile_max.x),
+					MIN((int)Math::floor((aabb.position.z + aabb.size.z + border_world_size) / tile_world_size), tile_max.y));
+			for (int z = from.y; z <= to.y; z++) {
+				for (int x = from.x; x <= to.x; x++) {
+					dirty_tiles.insert(Vector2i(x, z));
+				}
+			}
+		}
+	}
+
+	for (int z = tile_min.y; z <= tile_max.y; z++) {
+		for (int x = tile_min.x; x <= tile_max.x; x++) {
+			const Vector2i tile(x, z);
+			if (!p_changed_aabbs || dirty_tiles.has(tile) || !baked_tiles.has(tile)) {
+				bake.tiles.push_back(tile);
+			}
+		}
+	}
+	bake.results.resize(bake.tiles.size());
+
+	if (bake.tiles.size() > 0) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationMeshGenerator::_bake_tile, &bake, bake.tiles.size(), -1, true, SNAME("NavigationMeshBakeTiles"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	for (uint32_t i = 0; i < bake.tiles.size(); i++) {
+		baked_tiles[bake.tiles[i]] = bake.results[i];
+	}
+
+	// Stitch the tiles together, the cached tiles that are out of the baked area are dropped.
+	HashMap<Vector2i, NavigationMesh::BakedTile> used_tiles;
+	Vector<Vector3> nav_vertices;
+	for (int z = tile_min.y; z <= tile_max.y; z++) {
+		for (int x = tile_min.x; x <= tile_max.x; x++) {
+			const Vector2i key(x, z);
+			const NavigationMesh::BakedTile *tile = baked_tiles.getptr(key);
+			if (!tile) {
+				continue;
+			}
+
+			const int vertex_offset = nav_vertices.size();
+			nav_vertices.append_array(tile->vertices);
+			for (int i = 0; i < tile->polygons.size(); i++) {
+				Vector<int> polygon = tile->polygons[i];
+				int *w = polygon.ptrw();
+				for (int j = 0; j < polygon.size(); j++) {
+					w[j] += vertex_offset;
+				}
+				p_nav_mesh->add_polygon(polygon);
+			}
+			used_tiles.insert(key, *tile);
+		}
+	}
+
+	p_nav_mesh->set_vertices(nav_vertices);
+	p_nav_mesh->set_baked_tiles(used_tiles);
+}
+
 NavigationMeshGenerator *NavigationMeshGenerator::get_singleton() {
 	return singleton;
 }
@@ -753,24 +1007,11 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 
 	Vector<float> vertices;
 	Vector<int> indices;
+	_parse_source_geometry(p_nav_mesh, p_node, vertices, indices);
 
-	List<Node *> parse_nodes;
-
-	if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
-		parse_nodes.push_back(p_node);
-	} else {
-		p_node->get_tree()->get_nodes_in_group(p_nav_mesh->get_source_group_name(), &parse_nodes);
-	}
-
-	Transform3D navmesh_xform = Object::cast_to<Node3D>(p_node)->get_global_transform().affine_inverse();
-	for (Node *E : parse_nodes) {
-		NavigationMesh::ParsedGeometryType geometry_type = p_nav_mesh->get_parsed_geometry_type();
-		uint32_t collision_mask = p_nav_mesh->get_collision_mask();
-		bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
-		_parse_geometry(navmesh_xform, E, vertices, indices, geometry_type, collision_mask, recurse_children);
-	}
-
-	if (vertices.size() > 0 && indices.size() > 0) {
+	if (p_nav_mesh->get_tile_size() > 0) {
+		_bake_tiles(p_nav_mesh, vertices, indices, nullptr);
+	} else if (vertices.size() > 0 && indices.size() > 0) {
 		rcHeightfield *hf = nullptr;
 		rcCompactHeightfield *chf = nullptr;
 		rcContourSet *cset = nullptr;
@@ -817,15 +1058,41 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 #endif
 }
 
+void NavigationMeshGenerator::bake_tiles(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const TypedArray<AABB> &p_changed_aabbs) {
+	ERR_FAIL_COND_MSG(!p_nav_mesh.is_valid(), "Invalid navigation mesh.");
+
+	if (p_nav_mesh->get_tile_size() <= 0 || p_nav_mesh->get_baked_tiles().is_empty()) {
+		// Nothing to rebake partially, do a full bake instead.
+		clear(p_nav_mesh);
+		bake(p_nav_mesh, p_node);
+		return;
+	}
+
+	Vector<float> vertices;
+	Vector<int> indices;
+	_parse_source_geometry(p_nav_mesh, p_node, vertices, indices);
+
+	// The changed areas are given in global space, but the navigation mesh is baked in the space of the root node.
+	Transform3D navmesh_xform = Object::cast_to<Node3D>(p_node)->get_global_transform().affine_inverse();
+	Vector<AABB> changed_aabbs;
+	for (int i = 0; i < p_changed_aabbs.size(); i++) {
+		changed_aabbs.push_back(navmesh_xform.xform(AABB(p_changed_aabbs[i])));
+	}
+
+	_bake_tiles(p_nav_mesh, vertices, indices, &changed_aabbs);
+}
+
 void NavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
 	if (p_nav_mesh.is_valid()) {
 		p_nav_mesh->clear_polygons();
 		p_nav_mesh->set_vertices(Vector<Vector3>());
+		p_nav_mesh->set_baked_tiles(HashMap<Vector2i, NavigationMesh::BakedTile>());
 	}
 }
 
 void NavigationMeshGenerator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bake", "nav_mesh", "root_node"), &NavigationMeshGenerator::bake);
+	ClassDB::bind_method(D_METHOD("bake_tiles", "nav_mesh", "root_node", "changed_aabbs"), &NavigationMeshGenerator::bake_tiles);
 	ClassDB::bind_method(D_METHOD("clear", "nav_mesh"), &NavigationMeshGenerator::clear);
 }
 
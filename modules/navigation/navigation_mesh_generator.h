@@ -46,6 +46,22 @@ class NavigationMeshGenerator : public Object {
 
 	static NavigationMeshGenerator *singleton;
 
+	struct TiledBake {
+		rcConfig cfg; // Shared by all the tiles, borderSize is added to every tile's bounds.
+		bool filter_low_hanging_obstacles = false;
+		bool filter_ledge_spans = false;
+		bool filter_walkable_low_height_spans = false;
+		NavigationMesh::SamplePartitionType partition_type = NavigationMesh::SAMPLE_PARTITION_WATERSHED;
+
+		const float *verts = nullptr;
+		int nverts = 0;
+		const int *tris = nullptr;
+		int ntris = 0;
+
+		LocalVector<Vector2i> tiles;
+		LocalVector<NavigationMesh::BakedTile> results;
+	};
+
 protected:
 	static void _bind_methods();
 
@@ -55,6 +71,11 @@ protected:
 	static void _add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform, Vector<float> &p_vertices, Vector<int> &p_indices);
 	static void _parse_geometry(const Transform3D &p_navmesh_transform, Node *p_node, Vector<float> &p_vertices, Vector<int> &p_indices, NavigationMesh::ParsedGeometryType p_generate_from, uint32_t p_collision_mask, bool p_recurse_children);
 
+	static void _parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &r_vertices, Vector<int> &r_indices);
+
+	static void _init_recast_config(Ref<NavigationMesh> p_nav_mesh, rcConfig &r_cfg);
+	static void _get_recast_bounds(Ref<NavigationMesh> p_nav_mesh, const float *p_verts, int p_nverts, float *r_bmin, float *r_bmax);
+	static void _convert_detail_mesh(const rcPolyMeshDetail *p_detail_mesh, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
 	static void _convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh);
 	static void _build_recast_navigation_mesh(
 			Ref<NavigationMesh> p_nav_mesh,
@@ -69,6 +90,17 @@ protected:
 			Vector<float> &vertices,
 			Vector<int> &indices);
 
+	static bool _build_recast_tile(
+			const TiledBake *p_bake,
+			const Vector2i &p_tile,
+			rcHeightfield *&r_hf,
+			rcCompactHeightfield *&r_chf,
+			rcContourSet *&r_cset,
+			rcPolyMesh *&r_poly_mesh,
+			rcPolyMeshDetail *&r_detail_mesh);
+	void _bake_tile(uint32_t p_index, TiledBake *p_bake);
+	void _bake_tiles(Ref<NavigationMesh> p_nav_mesh, Vector<float> &p_vertices, Vector<int> &p_indices, const Vector<AABB> *p_changed_aabbs);
+
 public:
 	static NavigationMeshGenerator *get_singleton();
 
@@ -76,6 +108,7 @@ public:
 	~NavigationMeshGenerator();
 
 	void bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node);
+	void bake_tiles(Ref<NavigationMesh> p_nav_mesh, Node *p_node, const TypedArray<AABB> &p_changed_aabbs);
 	void clear(Ref<NavigationMesh> p_nav_mesh);
 };
 
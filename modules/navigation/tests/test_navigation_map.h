@@ -0,0 +1,351 @@
+/*************************************************************************/
+/*  test_navigation_map.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NAVIGATION_MAP_H
+#define TEST_NAVIGATION_MAP_H
+
+#include "core/math/random_number_generator.h"
+#include "modules/navigation/nav_agent_grid.h"
+#include "modules/navigation/rvo_agent.h"
+#include "scene/resources/navigation_mesh.h"
+#include "servers/navigation_server_3d.h"
+
+#include "tests/test_macros.h"
+
+// Declared in global namespace because of GDCLASS macro warning (Windows):
+// "Unqualified friend declaration referring to type outside of the nearest enclosing namespace
+// is a Microsoft extension; add a nested name specifier".
+class _TestAvoidanceReceiver : public Object {
+	GDCLASS(_TestAvoidanceReceiver, Object);
+
+public:
+	int call_count = 0;
+	Array agents;
+	PackedVector3Array velocities;
+
+	void avoidance_done(const Array &p_agents, const PackedVector3Array &p_velocities) {
+		call_count++;
+		agents = p_agents;
+		velocities = p_velocities;
+	}
+};
+
+namespace TestNavigationMap {
+
+// Flat grid of unit quads, covering [0, p_size] on the X and Z axes.
+static Ref<NavigationMesh> create_grid_navigation_mesh(int p_size) {
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_size; z++) {
+		for (int x = 0; x <= p_size; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+	navigation_mesh->set_vertices(vertices);
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			const int first = z * (p_size + 1) + x;
+			Vector<int> polygon;
+			polygon.push_back(first);
+			polygon.push_back(first + 1);
+			polygon.push_back(first + p_size + 2);
+			polygon.push_back(first + p_size + 1);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
+static real_t get_path_length(const Vector<Vector3> &p_path) {
+	real_t length = 0.0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
+TEST_CASE("[SceneTree][NavigationMap] Polygon queries") {
+	NavigationServer3D *server = NavigationServer3D::get_singleton_mut();
+	const int size = 64;
+
+	RID map = server->map_create();
+	RID region = server->region_create();
+	server->region_set_map(region, map);
+	server->region_set_navmesh(region, create_grid_navigation_mesh(size));
+	server->map_force_update(map);
+
+	SUBCASE("Closest point") {
+		CHECK(server->map_get_closest_point(map, Vector3(10.25, 3, 20.5)).is_equal_approx(Vector3(10.25, 0, 20.5)));
+		CHECK(server->map_get_closest_point(map, Vector3(-5, 0, 10.5)).is_equal_approx(Vector3(0, 0, 10.5)));
+		CHECK(server->map_get_closest_point(map, Vector3(70, -2, 70)).is_equal_approx(Vector3(size, 0, size)));
+		CHECK(server->map_get_closest_point_owner(map, Vector3(1, 1, 1)) == region);
+
+		// The result must match the one of an exhaustive search, i.e. the point clamped to the grid.
+		RandomNumberGenerator rng;
+		rng.set_seed(42);
+		bool matches = true;
+		for (int i = 0; i < 1000; i++) {
+			const Vector3 point(rng.randf_range(-10, size + 10), rng.randf_range(-10, 10), rng.randf_range(-10, size + 10));
+			const Vector3 expected(CLAMP(point.x, 0, size), 0, CLAMP(point.z, 0, size));
+			matches = matches && server->map_get_closest_point(map, point).is_equal_approx(expected);
+		}
+		CHECK_MESSAGE(matches, "The closest point should be the same as the one of an exhaustive search.");
+	}
+
+	SUBCASE("Closest point to segment") {
+		CHECK(server->map_get_closest_point_to_segment(map, Vector3(5.5, 2, 5.5), Vector3(5.5, -2, 5.5), true).is_equal_approx(Vector3(5.5, 0, 5.5)));
+		// A slanted segment hits the mesh halfway.
+		CHECK(server->map_get_closest_point_to_segment(map, Vector3(40.5, 1, 30.5), Vector3(2.5, -1, 30.5), true).is_equal_approx(Vector3(21.5, 0, 30.5)));
+		// Without intersection, the closest point of the mesh edges.
+		CHECK(server->map_get_closest_point_to_segment(map, Vector3(-3, 1, 10), Vector3(-1, 1, 10)).is_equal_approx(Vector3(0, 0, 10)));
+		CHECK(server->map_get_closest_point_to_segment(map, Vector3(-3, 1, 10), Vector3(-1, 1, 10), true) == Vector3());
+	}
+
+	SUBCASE("Path endpoints") {
+		const Vector<Vector3> path = server->map_get_path(map, Vector3(0.5, 1, 0.5), Vector3(60.5, 1, 40.5), true);
+		REQUIRE(path.size() >= 2);
+		CHECK(path[0].is_equal_approx(Vector3(0.5, 0, 0.5)));
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(60.5, 0, 40.5)));
+
+		// No polygon on the requested layers.
+		CHECK(server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(60.5, 0, 40.5), true, 2).is_empty());
+	}
+
+	SUBCASE("Removed region") {
+		RID other_region = server->region_create();
+		server->region_set_map(other_region, map);
+		server->region_set_transform(other_region, Transform3D(Basis(), Vector3(size + 10, 0, 0)));
+		server->region_set_navmesh(other_region, create_grid_navigation_mesh(4));
+		server->map_force_update(map);
+		CHECK(server->map_get_closest_point(map, Vector3(size + 11.5, 1, 2.5)).is_equal_approx(Vector3(size + 11.5, 0, 2.5)));
+		CHECK(server->map_get_closest_point_owner(map, Vector3(size + 11.5, 1, 2.5)) == other_region);
+
+		// The map now has fewer polygons, none of the removed ones may still be found.
+		server->region_set_map(other_region, RID());
+		server->map_force_update(map);
+		CHECK(server->map_get_closest_point(map, Vector3(size + 11.5, 1, 2.5)).is_equal_approx(Vector3(size, 0, 2.5)));
+		CHECK(server->map_get_closest_point_owner(map, Vector3(size + 11.5, 1, 2.5)) == region);
+		CHECK(server->map_get_closest_point(map, Vector3(10.25, 3, 20.5)).is_equal_approx(Vector3(10.25, 0, 20.5)));
+
+		server->free(other_region);
+	}
+
+	SUBCASE("Batched paths") {
+		RandomNumberGenerator rng;
+		rng.set_seed(7);
+		Vector<Vector3> origins;
+		Vector<Vector3> destinations;
+		for (int i = 0; i < 200; i++) {
+			origins.push_back(Vector3(rng.randf_range(0, size), 0, rng.randf_range(0, size)));
+			destinations.push_back(Vector3(rng.randf_range(0, size), 0, rng.randf_range(0, size)));
+		}
+
+		const TypedArray<PackedVector3Array> paths = server->map_get_paths(map, origins, destinations, true);
+		REQUIRE(paths.size() == origins.size());
+		bool matches = true;
+		bool found = true;
+		for (int i = 0; i < origins.size(); i++) {
+			const PackedVector3Array path = paths[i];
+			matches = matches && path == server->map_get_path(map, origins[i], destinations[i], true);
+			found = found && path.size() >= 2;
+		}
+		CHECK_MESSAGE(found, "Every point is on the grid, so every path should be found.");
+		CHECK_MESSAGE(matches, "Batched paths should be the same as the ones requested one by one.");
+
+		ERR_PRINT_OFF;
+		CHECK(server->map_get_paths(map, origins, Vector<Vector3>(), true).is_empty());
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Clustered paths") {
+		RandomNumberGenerator rng;
+		rng.set_seed(11);
+		Vector<Vector3> origins;
+		Vector<Vector3> destinations;
+		for (int i = 0; i < 50; i++) {
+			origins.push_back(Vector3(rng.randf_range(0, size), 0, rng.randf_range(0, size)));
+			destinations.push_back(Vector3(rng.randf_range(0, size), 0, rng.randf_range(0, size)));
+		}
+		const TypedArray<PackedVector3Array> paths = server->map_get_paths(map, origins, destinations, true);
+
+		server->map_set_cluster_size(map, 8.0);
+		server->map_force_update(map);
+		CHECK(server->map_get_cluster_size(map) == doctest::Approx(8.0));
+
+		const TypedArray<PackedVector3Array> clustered_paths = server->map_get_paths(map, origins, destinations, true);
+		bool same_ends = true;
+		bool short_enough = true;
+		for (int i = 0; i < origins.size(); i++) {
+			const PackedVector3Array path = paths[i];
+			const PackedVector3Array clustered_path = clustered_paths[i];
+			same_ends = same_ends && clustered_path.size() >= 2 && clustered_path[0].is_equal_approx(path[0]) && clustered_path[clustered_path.size() - 1].is_equal_approx(path[path.size() - 1]);
+			short_enough = short_enough && get_path_length(clustered_path) <= get_path_length(path) * 1.1 + CMP_EPSILON;
+		}
+		CHECK_MESSAGE(same_ends, "Clustered paths should go between the same points.");
+		CHECK_MESSAGE(short_enough, "Clustered paths should be close to the shortest ones.");
+
+		// Layers not used on the map don't prevent using the clusters.
+		const Vector<Vector3> path = server->map_get_path(map, origins[0], destinations[0], true, 3);
+		CHECK(get_path_length(path) == doctest::Approx(get_path_length(clustered_paths[0])));
+	}
+
+	server->free(region);
+	server->free(map);
+}
+
+// Compares the neighbors found through the grid with the ones found by brute force.
+static bool check_agent_neighbors(const NavAgentGrid &p_grid, LocalVector<RvoAgent *> &p_agents) {
+	for (uint32_t i = 0; i < p_agents.size(); i++) {
+		RVO::Agent *agent = p_agents[i]->get_agent();
+
+		LocalVector<float> expected;
+		for (uint32_t j = 0; j < p_agents.size(); j++) {
+			const float distance_sq = RVO::absSq(agent->position_ - p_agents[j]->get_agent()->position_);
+			if (i != j && distance_sq < agent->neighborDist_ * agent->neighborDist_) {
+				expected.push_back(distance_sq);
+			}
+		}
+		expected.sort();
+		expected.resize(MIN(expected.size(), agent->maxNeighbors_));
+
+		p_grid.compute_neighbors(agent);
+		if (agent->agentNeighbors_.size() != expected.size()) {
+			return false;
+		}
+		for (uint32_t j = 0; j < expected.size(); j++) {
+			if (agent->agentNeighbors_[j].first != expected[j]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[NavigationMap] Agent neighbors") {
+	RandomNumberGenerator rng;
+	rng.set_seed(3);
+
+	LocalVector<RvoAgent *> agents;
+	for (int i = 0; i < 2000; i++) {
+		RvoAgent *agent = memnew(RvoAgent);
+		RVO::Agent *rvo_agent = agent->get_agent();
+		rvo_agent->position_ = RVO::Vector3(rng.randf_range(0, 200), rng.randf_range(0, 2), rng.randf_range(0, 200));
+		rvo_agent->radius_ = 0.5;
+		rvo_agent->neighborDist_ = 10.0;
+		rvo_agent->maxNeighbors_ = 10;
+		agents.push_back(agent);
+	}
+	// Agents searching far away go through the occupied cells instead of the rings.
+	agents[0]->get_agent()->neighborDist_ = 1000.0;
+	agents[0]->get_agent()->maxNeighbors_ = 50;
+	agents[1]->get_agent()->maxNeighbors_ = 0;
+
+	NavAgentGrid grid;
+	grid.update(agents);
+	// Cells are sized for the furthest neighbor distance.
+	CHECK(grid.get_cell_size() == doctest::Approx(1000.0));
+	CHECK_MESSAGE(check_agent_neighbors(grid, agents), "The neighbors should match the ones found by brute force.");
+
+	// Move the agents, only some of them change cell.
+	for (uint32_t i = 0; i < agents.size(); i++) {
+		RVO::Agent *rvo_agent = agents[i]->get_agent();
+		rvo_agent->position_ = rvo_agent->position_ + RVO::Vector3(rng.randf_range(-3, 3), 0, rng.randf_range(-3, 3));
+	}
+	grid.update(agents);
+	CHECK_MESSAGE(check_agent_neighbors(grid, agents), "The neighbors should match the ones found by brute force after the agents moved.");
+
+	// So are the cells once that distance changes.
+	agents[0]->get_agent()->neighborDist_ = 10.0;
+	grid.update(agents);
+	CHECK(grid.get_cell_size() == doctest::Approx(10.0));
+	CHECK(check_agent_neighbors(grid, agents));
+
+	// Removing agents builds the grid again.
+	memdelete(agents[5]);
+	agents.remove_at_unordered(5);
+	grid.update(agents);
+	CHECK(check_agent_neighbors(grid, agents));
+
+	for (uint32_t i = 0; i < agents.size(); i++) {
+		memdelete(agents[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][NavigationMap] Batched avoidance") {
+	NavigationServer3D *server = NavigationServer3D::get_singleton_mut();
+	_TestAvoidanceReceiver *receiver = memnew(_TestAvoidanceReceiver);
+
+	RID map = server->map_create();
+	server->map_set_active(map, true);
+	server->map_set_avoidance_callback(map, callable_mp(receiver, &_TestAvoidanceReceiver::avoidance_done));
+
+	// Two agents walking into each other.
+	RID agents[2];
+	for (int i = 0; i < 2; i++) {
+		const real_t side = i == 0 ? -1.0 : 1.0;
+		agents[i] = server->agent_create();
+		server->agent_set_map(agents[i], map);
+		server->agent_set_radius(agents[i], 0.5);
+		server->agent_set_neighbor_distance(agents[i], 10.0);
+		server->agent_set_max_neighbors(agents[i], 10);
+		server->agent_set_time_horizon(agents[i], 5.0);
+		server->agent_set_max_speed(agents[i], 2.0);
+		server->agent_set_position(agents[i], Vector3(side * 2.0, 0, side * 0.1));
+		server->agent_set_velocity(agents[i], Vector3(-side * 2.0, 0, 0));
+		server->agent_set_target_velocity(agents[i], Vector3(-side * 2.0, 0, 0));
+	}
+
+	server->process(0.1);
+
+	CHECK(receiver->call_count == 1);
+	REQUIRE(receiver->agents.size() == 2);
+	REQUIRE(receiver->velocities.size() == 2);
+	CHECK(RID(receiver->agents[0]) == agents[0]);
+	CHECK(RID(receiver->agents[1]) == agents[1]);
+	CHECK_MESSAGE(receiver->agents.is_read_only(), "The callback shouldn't be able to change the map's agent list.");
+	CHECK_MESSAGE(
+			!receiver->velocities[0].is_equal_approx(Vector3(2.0, 0, 0)),
+			"The agents should avoid each other.");
+
+	server->map_set_avoidance_callback(map, Callable());
+	server->process(0.1);
+	CHECK(receiver->call_count == 1);
+
+	server->free(agents[0]);
+	server->free(agents[1]);
+	server->free(map);
+	memdelete(receiver);
+}
+
+} // namespace TestNavigationMap
+
+#endif // TEST_NAVIGATION_MAP_H
@@ -0,0 +1,124 @@
+/*************************************************************************/
+/*  test_navigation_mesh_generator.h                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NAVIGATION_MESH_GENERATOR_H
+#define TEST_NAVIGATION_MESH_GENERATOR_H
+
+#include "modules/navigation/navigation_mesh_generator.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/primitive_meshes.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavigationMeshGenerator {
+
+static real_t get_navigation_mesh_area(Ref<NavigationMesh> p_navigation_mesh) {
+	const Vector<Vector3> vertices = p_navigation_mesh->get_vertices();
+	real_t area = 0.0;
+	for (int i = 0; i < p_navigation_mesh->get_polygon_count(); i++) {
+		const Vector<int> polygon = p_navigation_mesh->get_polygon(i);
+		for (int j = 2; j < polygon.size(); j++) {
+			area += Face3(vertices[polygon[0]], vertices[polygon[j - 1]], vertices[polygon[j]]).get_area();
+		}
+	}
+	return area;
+}
+
+TEST_CASE("[SceneTree][NavigationMeshGenerator] Tiled baking") {
+	NavigationRegion3D *region = memnew(NavigationRegion3D);
+	SceneTree::get_singleton()->get_root()->add_child(region);
+
+	Ref<PlaneMesh> plane;
+	plane.instantiate();
+	plane->set_size(Size2(32, 32));
+	MeshInstance3D *ground = memnew(MeshInstance3D);
+	ground->set_mesh(plane);
+	region->add_child(ground);
+
+	NavigationMeshGenerator *generator = NavigationMeshGenerator::get_singleton();
+
+	Ref<NavigationMesh> untiled_mesh;
+	untiled_mesh.instantiate();
+	generator->bake(untiled_mesh, region);
+	const real_t untiled_area = get_navigation_mesh_area(untiled_mesh);
+	REQUIRE(untiled_area > 0.0);
+
+	Ref<NavigationMesh> tiled_mesh;
+	tiled_mesh.instantiate();
+	tiled_mesh->set_tile_size(32); // 8x8 meters with the default cell size.
+	generator->bake(tiled_mesh, region);
+	CHECK(tiled_mesh->get_baked_tiles().size() == 16);
+	CHECK_MESSAGE(
+			Math::abs(get_navigation_mesh_area(tiled_mesh) - untiled_area) < untiled_area * 0.01,
+			"The tiles should cover the same area as the whole navigation mesh.");
+
+	SUBCASE("Rebaking unchanged tiles") {
+		const Vector<Vector3> vertices = tiled_mesh->get_vertices();
+		const int polygon_count = tiled_mesh->get_polygon_count();
+
+		TypedArray<AABB> changed_aabbs;
+		changed_aabbs.push_back(AABB(Vector3(10, -1, 10), Vector3(2, 2, 2)));
+		generator->bake_tiles(tiled_mesh, region, changed_aabbs);
+
+		CHECK(tiled_mesh->get_vertices() == vertices);
+		CHECK(tiled_mesh->get_polygon_count() == polygon_count);
+	}
+
+	SUBCASE("Rebaking changed tiles") {
+		Ref<BoxMesh> box;
+		box.instantiate();
+		box->set_size(Vector3(2, 2, 2));
+		MeshInstance3D *obstacle = memnew(MeshInstance3D);
+		obstacle->set_mesh(box);
+		obstacle->set_position(Vector3(11, 1, 11));
+		region->add_child(obstacle);
+
+		TypedArray<AABB> changed_aabbs;
+		changed_aabbs.push_back(obstacle->get_global_transform().xform(box->get_aabb()));
+		generator->bake_tiles(tiled_mesh, region, changed_aabbs);
+		CHECK(get_navigation_mesh_area(tiled_mesh) < untiled_area);
+
+		Ref<NavigationMesh> full_mesh;
+		full_mesh.instantiate();
+		full_mesh->set_tile_size(32);
+		generator->bake(full_mesh, region);
+		CHECK_MESSAGE(
+				tiled_mesh->get_vertices() == full_mesh->get_vertices(),
+				"Rebaking the changed tiles should give the same result as a full bake.");
+		CHECK(tiled_mesh->get_polygon_count() == full_mesh->get_polygon_count());
+	}
+
+	memdelete(region);
+}
+
+} // namespace TestNavigationMeshGenerator
+
+#endif // TEST_NAVIGATION_MESH_GENERATOR_H
@@ -132,6 +132,7 @@ void Node2D::_update_transform() {
 }
 
 void Node2D::set_position(const Point2 &p_pos) {
+	ERR_THREAD_GUARD;
 	if (_xform_dirty) {
 		const_cast<Node2D *>(this)->_update_xform_values();
 	}
@@ -305,6 +306,7 @@ void Node2D::set_global_scale(const Size2 &p_scale) {
 }
 
 void Node2D::set_transform(const Transform2D &p_transform) {
+	ERR_THREAD_GUARD;
 	transform = p_transform;
 	_xform_dirty = true;
 
@@ -218,6 +218,8 @@ Ref<NavigationMesh> NavigationRegion3D::get_navigation_mesh() const {
 
 struct BakeThreadsArgs {
 	NavigationRegion3D *nav_region = nullptr;
+	bool tiles = false;
+	TypedArray<AABB> changed_aabbs;
 };
 
 void _bake_navigation_mesh(void *p_user_data) {
@@ -226,7 +228,11 @@ void _bake_navigation_mesh(void *p_user_data) {
 	if (args->nav_region->get_navigation_mesh().is_valid()) {
 		Ref<NavigationMesh> nav_mesh = args->nav_region->get_navigation_mesh()->duplicate();
 
-		NavigationServer3D::get_singleton()->region_bake_navmesh(nav_mesh, args->nav_region);
+		if (args->tiles) {
+			NavigationServer3D::get_singleton()->region_bake_navmesh_tiles(nav_mesh, args->nav_region, args->changed_aabbs);
+		} else {
+			NavigationServer3D::get_singleton()->region_bake_navmesh(nav_mesh, args->nav_region);
+		}
 		args->nav_region->call_deferred(SNAME("_bake_finished"), nav_mesh);
 		memdelete(args);
 	} else {
@@ -254,10 +260,37 @@ void NavigationRegion3D::bake_navigation_mesh(bool p_on_thread) {
 	}
 }
 
+void NavigationRegion3D::bake_navigation_mesh_tiles(const TypedArray<AABB> &p_changed_aabbs, bool p_on_thread) {
+	if (bake_thread.is_started()) {
+		// The tiles are rebaked from the result of the running bake once it is done.
+		bake_tiles_pending = true;
+		bake_pending_aabbs.append_array(p_changed_aabbs);
+		return;
+	}
+
+	BakeThreadsArgs *args = memnew(BakeThreadsArgs);
+	args->nav_region = this;
+	args->tiles = true;
+	args->changed_aabbs = p_changed_aabbs.duplicate();
+
+	if (p_on_thread && OS::get_singleton()->can_use_threads()) {
+		bake_thread.start(_bake_navigation_mesh, args);
+	} else {
+		_bake_navigation_mesh(args);
+	}
+}
+
 void NavigationRegion3D::_bake_finished(Ref<NavigationMesh> p_nav_mesh) {
 	set_navigation_mesh(p_nav_mesh);
 	bake_thread.wait_to_finish();
 	emit_signal(SNAME("bake_finished"));
+
+	if (bake_tiles_pending && p_nav_mesh.is_valid()) {
+		TypedArray<AABB> changed_aabbs = bake_pending_aabbs;
+		bake_tiles_pending = false;
+		bake_pending_aabbs.clear();
+		bake_navigation_mesh_tiles(changed_aabbs, true);
+	}
 }
 
 TypedArray<String> NavigationRegion3D::get_configuration_warnings() const {
@@ -294,6 +327,7 @@ void NavigationRegion3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_travel_cost"), &NavigationRegion3D::get_travel_cost);
 
 	ClassDB::bind_method(D_METHOD("bake_navigation_mesh", "on_thread"), &NavigationRegion3D::bake_navigation_mesh, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("bake_navigation_mesh_tiles", "changed_aabbs", "on_thread"), &NavigationRegion3D::bake_navigation_mesh_tiles, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("_bake_finished", "nav_mesh"), &NavigationRegion3D::_bake_finished);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "navmesh", PROPERTY_HINT_RESOURCE_TYPE, "NavigationMesh"), "set_navigation_mesh", "get_navigation_mesh");
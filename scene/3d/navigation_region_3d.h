@@ -45,6 +45,8 @@ class NavigationRegion3D : public Node3D {
 	real_t travel_cost = 1.0;
 
 	Thread bake_thread;
+	bool bake_tiles_pending = false;
+	TypedArray<AABB> bake_pending_aabbs;
 
 	void _navigation_changed();
 
@@ -88,6 +90,9 @@ public:
 	/// Bakes the navigation mesh; once done, automatically
 	/// sets the new navigation mesh and emits a signal
 	void bake_navigation_mesh(bool p_on_thread);
+	/// Rebakes only the navigation mesh tiles touched by the
+	/// given global areas, see NavigationMesh::tile_size
+	void bake_navigation_mesh_tiles(const TypedArray<AABB> &p_changed_aabbs, bool p_on_thread);
 	void _bake_finished(Ref<NavigationMesh> p_nav_mesh);
 
 	TypedArray<String> get_configuration_warnings() const override;
@@ -31,6 +31,7 @@
 #include "node_3d.h"
 
 #include "core/object/message_queue.h"
+#include "scene/3d/node_3d_transform_batch.h"
 #include "scene/3d/visual_instance_3d.h"
 #include "scene/main/viewport.h"
 #include "scene/property_utils.h"
@@ -80,6 +81,7 @@ void Node3D::_notify_dirty() {
 	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
 
 #endif
+		MutexLock lock(get_tree()->xform_change_mutex);
 		get_tree()->xform_change_list.add(&xform_change);
 	}
 }
@@ -106,6 +108,12 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 		return;
 	}
 
+	if (data.transform_batch) {
+		// Children and notifications are handled when the batch is flushed.
+		data.transform_batch->set_local(data.transform_slot, get_transform(), data.ignore_notification);
+		return;
+	}
+
 	data.children_lock++;
 
 	for (Node3D *&E : data.children) {
@@ -119,6 +127,7 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 #else
 	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
 #endif
+		MutexLock lock(get_tree()->xform_change_mutex);
 		get_tree()->xform_change_list.add(&xform_change);
 	}
 	data.dirty |= DIRTY_GLOBAL_TRANSFORM;
@@ -150,6 +159,12 @@ void Node3D::_notification(int p_what) {
 				data.top_level_active = true;
 			}
 
+			data.transform_batch = get_tree()->get_transform_batch_3d();
+			if (data.transform_batch) {
+				uint32_t parent_slot = data.parent && data.parent->data.transform_batch ? data.parent->data.transform_slot : 0xFFFFFFFF;
+				data.transform_slot = data.transform_batch->add(this, parent_slot, get_transform(), data.top_level_active, data.disable_scale);
+			}
+
 			data.dirty |= DIRTY_GLOBAL_TRANSFORM; // Global is always dirty upon entering a scene.
 			_notify_dirty();
 
@@ -165,6 +180,10 @@ void Node3D::_notification(int p_what) {
 			if (data.C) {
 				data.parent->data.children.erase(data.C);
 			}
+			if (data.transform_batch) {
+				data.transform_batch->remove(data.transform_slot);
+				data.transform_batch = nullptr;
+			}
 			data.parent = nullptr;
 			data.C = nullptr;
 			data.top_level_active = false;
@@ -260,6 +279,7 @@ void Node3D::set_global_rotation(const Vector3 &p_euler_rad) {
 }
 
 void Node3D::set_transform(const Transform3D &p_transform) {
+	ERR_THREAD_GUARD;
 	data.local_transform = p_transform;
 	data.dirty = DIRTY_EULER_ROTATION_AND_SCALE; // Make rot/scale dirty.
 
@@ -299,6 +319,10 @@ Transform3D Node3D::get_transform() const {
 Transform3D Node3D::get_global_transform() const {
 	ERR_FAIL_COND_V(!is_inside_tree(), Transform3D());
 
+	if (data.transform_batch) {
+		return data.transform_batch->get_global(data.transform_slot);
+	}
+
 	if (data.dirty & DIRTY_GLOBAL_TRANSFORM) {
 		if (data.dirty & DIRTY_LOCAL_TRANSFORM) {
 			_update_local_transform();
@@ -353,6 +377,7 @@ Transform3D Node3D::get_relative_transform(const Node *p_parent) const {
 }
 
 void Node3D::set_position(const Vector3 &p_position) {
+	ERR_THREAD_GUARD;
 	data.local_transform.origin = p_position;
 	_propagate_transform_changed(this);
 	if (data.notify_local_transform) {
@@ -609,6 +634,9 @@ void Node3D::set_disable_gizmos(bool p_enabled) {
 
 void Node3D::set_disable_scale(bool p_enabled) {
 	data.disable_scale = p_enabled;
+	if (data.transform_batch) {
+		data.transform_batch->set_disable_scale(data.transform_slot, p_enabled);
+	}
 }
 
 bool Node3D::is_scale_disabled() const {
@@ -628,6 +656,9 @@ void Node3D::set_as_top_level(bool p_enabled) {
 
 		data.top_level = p_enabled;
 		data.top_level_active = p_enabled;
+		if (data.transform_batch) {
+			data.transform_batch->set_top_level(data.transform_slot, p_enabled);
+		}
 	} else {
 		data.top_level = p_enabled;
 	}
@@ -672,6 +703,7 @@ void Node3D::hide() {
 }
 
 void Node3D::set_visible(bool p_visible) {
+	ERR_THREAD_GUARD;
 	if (data.visible == p_visible) {
 		return;
 	}
@@ -830,7 +862,10 @@ void Node3D::force_update_transform() {
 	if (!xform_change.in_list()) {
 		return; //nothing to update
 	}
-	get_tree()->xform_change_list.remove(&xform_change);
+	{
+		MutexLock lock(get_tree()->xform_change_mutex);
+		get_tree()->xform_change_list.remove(&xform_change);
+	}
 
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
@@ -34,6 +34,8 @@
 #include "scene/main/node.h"
 #include "scene/resources/world_3d.h"
 
+class Node3DTransformBatch;
+
 class Node3DGizmo : public RefCounted {
 	GDCLASS(Node3DGizmo, RefCounted);
 
@@ -126,6 +128,9 @@ private:
 		bool visible = true;
 		bool disable_scale = false;
 
+		Node3DTransformBatch *transform_batch = nullptr;
+		uint32_t transform_slot = 0;
+
 #ifdef TOOLS_ENABLED
 		Vector<Ref<Node3DGizmo>> gizmos;
 		bool gizmos_disabled = false;
@@ -137,6 +142,8 @@ private:
 
 	NodePath visibility_parent_path;
 
+	friend class Node3DTransformBatch;
+
 	void _update_gizmos();
 	void _notify_dirty();
 	void _propagate_transform_changed(Node3D *p_origin);
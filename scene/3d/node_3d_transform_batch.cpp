@@ -0,0 +1,267 @@
+/*************************************************************************/
+/*  node_3d_transform_batch.cpp                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "node_3d_transform_batch.h"
+
+#include "core/object/worker_thread_pool.h"
+#include "scene/3d/node_3d.h"
+
+// Levels smaller than this are cheaper to update on the calling thread.
+#define LEVEL_THREAD_THRESHOLD 1024
+
+void Node3DTransformBatch::_mark_dirty(uint32_t p_slot) {
+	flags[p_slot] |= FLAG_DIRTY;
+	if (!(flags[p_slot] & FLAG_PENDING)) {
+		flags[p_slot] |= FLAG_PENDING;
+		inv_min_pending_depth.exchange_if_greater(UINT32_MAX - depth[p_slot]);
+		pending_count.increment();
+	}
+}
+
+void Node3DTransformBatch::_set_global(uint32_t p_slot, const Transform3D &p_global) {
+	uint32_t p = parent[p_slot];
+	global[p_slot] = p_global;
+	stamp[p_slot]++;
+	parent_stamp[p_slot] = p != INVALID_SLOT ? stamp[p] : 0;
+	flags[p_slot] &= ~FLAG_DIRTY;
+}
+
+uint32_t Node3DTransformBatch::add(Node3D *p_node, uint32_t p_parent, const Transform3D &p_local, bool p_top_level, bool p_disable_scale) {
+	uint32_t slot;
+	if (free_slots.size()) {
+		slot = free_slots[free_slots.size() - 1];
+		free_slots.resize(free_slots.size() - 1);
+	} else {
+		slot = nodes.size();
+		local.push_back(Transform3D());
+		global.push_back(Transform3D());
+		parent.push_back(INVALID_SLOT);
+		flags.push_back(0);
+		stamp.push_back(0);
+		parent_stamp.push_back(0);
+		depth.push_back(0);
+		level_pos.push_back(0);
+		nodes.push_back(nullptr);
+	}
+
+	// Parents enter the tree before their children, so their level is always known.
+	uint32_t d = p_parent != INVALID_SLOT ? depth[p_parent] + 1 : 0;
+	if (d >= levels.size()) {
+		levels.resize(d + 1);
+	}
+
+	local[slot] = p_local;
+	parent[slot] = p_parent;
+	flags[slot] = (p_top_level ? FLAG_TOP_LEVEL : 0) | (p_disable_scale ? FLAG_DISABLE_SCALE : 0);
+	depth[slot] = d;
+	level_pos[slot] = levels[d].size();
+	nodes[slot] = p_node;
+	levels[d].push_back(slot);
+
+	_mark_dirty(slot);
+	return slot;
+}
+
+void Node3DTransformBatch::remove(uint32_t p_slot) {
+	ERR_FAIL_UNSIGNED_INDEX(p_slot, nodes.size());
+
+	LocalVector<uint32_t> &level = levels[depth[p_slot]];
+	uint32_t pos = level_pos[p_slot];
+	uint32_t last = level[level.size() - 1];
+	level[pos] = last;
+	level_pos[last] = pos;
+	level.resize(level.size() - 1);
+
+	if (flags[p_slot] & FLAG_PENDING) {
+		pending_count.decrement();
+	}
+	flags[p_slot] = 0;
+	parent[p_slot] = INVALID_SLOT;
+	nodes[p_slot] = nullptr;
+	free_slots.push_back(p_slot);
+
+	while (levels.size() && levels[levels.size() - 1].is_empty()) {
+		levels.resize(levels.size() - 1);
+	}
+}
+
+void Node3DTransformBatch::set_local(uint32_t p_slot, const Transform3D &p_local, bool p_ignore_notification) {
+	local[p_slot] = p_local;
+	if (!p_ignore_notification) {
+		flags[p_slot] &= ~FLAG_IGNORE_NOTIFICATION;
+	} else if (!(flags[p_slot] & FLAG_PENDING)) {
+		// Only suppressed if no other pending change asked for a notification.
+		flags[p_slot] |= FLAG_IGNORE_NOTIFICATION;
+	}
+	_mark_dirty(p_slot);
+}
+
+void Node3DTransformBatch::set_top_level(uint32_t p_slot, bool p_enabled) {
+	if (p_enabled) {
+		flags[p_slot] |= FLAG_TOP_LEVEL;
+	} else {
+		flags[p_slot] &= ~FLAG_TOP_LEVEL;
+	}
+	flags[p_slot] &= ~FLAG_IGNORE_NOTIFICATION;
+	_mark_dirty(p_slot);
+}
+
+void Node3DTransformBatch::set_disable_scale(uint32_t p_slot, bool p_enabled) {
+	if (p_enabled) {
+		flags[p_slot] |= FLAG_DISABLE_SCALE;
+	} else {
+		flags[p_slot] &= ~FLAG_DISABLE_SCALE;
+	}
+	flags[p_slot] &= ~FLAG_IGNORE_NOTIFICATION;
+	_mark_dirty(p_slot);
+}
+
+Transform3D Node3DTransformBatch::_compose_global(uint32_t p_slot, uint32_t p_top, bool &r_cached) {
+	Transform3D xform;
+	uint32_t p = parent[p_slot];
+	bool parent_cached = true;
+	if (flags[p_slot] & FLAG_TOP_LEVEL || p == INVALID_SLOT) {
+		xform = local[p_slot];
+	} else if (p_slot == p_top) {
+		xform = global[p] * local[p_slot];
+	} else {
+		xform = _compose_global(p, p_top, parent_cached) * local[p_slot];
+	}
+
+	if (flags[p_slot] & FLAG_DISABLE_SCALE) {
+		xform.basis.orthonormalize();
+	}
+
+	// Caching under a parent that wasn't would make the slot look valid when it isn't.
+	r_cached = parent_cached && nodes[p_slot]->is_accessible_from_caller_thread();
+	if (r_cached) {
+		_set_global(p_slot, xform);
+	}
+	return xform;
+}
+
+Transform3D Node3DTransformBatch::get_global(uint32_t p_slot) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_slot, nodes.size(), Transform3D());
+
+	if (pending_count.get() == 0) {
+		return global[p_slot];
+	}
+
+	// Find the out of date ancestor closest to the root, everything above it is valid.
+	uint32_t top = INVALID_SLOT;
+	uint32_t s = p_slot;
+	while (true) {
+		uint32_t p = parent[s];
+		bool top_level = (flags[s] & FLAG_TOP_LEVEL) || p == INVALID_SLOT;
+		if ((flags[s] & FLAG_DIRTY) || (!top_level && parent_stamp[s] != stamp[p])) {
+			top = s;
+		}
+		if (top_level) {
+			break;
+		}
+		s = p;
+	}
+
+	if (top == INVALID_SLOT) {
+		return global[p_slot];
+	}
+	bool cached;
+	return _compose_global(p_slot, top, cached);
+}
+
+void Node3DTransformBatch::_update_slot(uint32_t p_index, LocalVector<uint32_t> *p_level) {
+	uint32_t s = (*p_level)[p_index];
+	uint32_t f = flags[s];
+	uint32_t p = parent[s];
+	bool top_level = (f & FLAG_TOP_LEVEL) || p == INVALID_SLOT;
+
+	bool parent_changed = !top_level && (flags[p] & FLAG_CHANGED);
+
+	// Slots cached by get_global() since the last flush are still pending, and updated again.
+	if (!(f & FLAG_PENDING) && !parent_changed) {
+		return;
+	}
+
+	if (parent_changed) {
+		// Children of an ignored node are still notified, as without the batch.
+		f &= ~FLAG_IGNORE_NOTIFICATION;
+	}
+
+	Transform3D xform = top_level ? local[s] : global[p] * local[s];
+	if (f & FLAG_DISABLE_SCALE) {
+		xform.basis.orthonormalize();
+	}
+
+	flags[s] = (f & ~FLAG_PENDING) | FLAG_CHANGED;
+	_set_global(s, xform);
+}
+
+void Node3DTransformBatch::flush() {
+	if (pending_count.get() == 0) {
+		return;
+	}
+
+	uint32_t min_pending_depth = UINT32_MAX - inv_min_pending_depth.get();
+	uint32_t level_count = levels.size();
+	for (uint32_t d = min_pending_depth; d < level_count; d++) {
+		LocalVector<uint32_t> &level = levels[d];
+		// Each level only reads from the one above, which is already complete.
+		if (level.size() >= LEVEL_THREAD_THRESHOLD && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Node3DTransformBatch::_update_slot, &level, level.size(), -1, true, SNAME("Node3DTransformBatch"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < level.size(); i++) {
+				_update_slot(i, &level);
+			}
+		}
+	}
+
+	pending_count.set(0);
+	inv_min_pending_depth.set(0);
+
+	// Coalesced notifications, one per changed node.
+	for (uint32_t d = min_pending_depth; d < level_count; d++) {
+		const LocalVector<uint32_t> &level = levels[d];
+		for (uint32_t i = 0; i < level.size(); i++) {
+			uint32_t s = level[i];
+			uint32_t f = flags[s];
+			if (f & FLAG_CHANGED) {
+				flags[s] = f & ~(FLAG_CHANGED | FLAG_IGNORE_NOTIFICATION);
+				if (!(f & FLAG_IGNORE_NOTIFICATION)) {
+					nodes[s]->_notify_dirty();
+				}
+			}
+		}
+	}
+}
+
+Node3DTransformBatch::~Node3DTransformBatch() {
+	ERR_FAIL_COND_MSG(get_node_count() > 0, "Node3DTransformBatch freed while nodes still use it.");
+}
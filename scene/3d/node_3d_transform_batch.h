@@ -0,0 +1,112 @@
+/*************************************************************************/
+/*  node_3d_transform_batch.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NODE_3D_TRANSFORM_BATCH_H
+#define NODE_3D_TRANSFORM_BATCH_H
+
+#include "core/math/transform_3d.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class Node3D;
+
+// Optional storage for the transforms of every Node3D in a SceneTree, enabled with
+// the "application/run/batch_3d_transforms" project setting.
+//
+// Instead of walking the subtree on every change, setting a local transform only
+// marks the node dirty. Once per flush (before transform notifications are sent),
+// global transforms are recomputed level by level, parents always being one level
+// above their children, so each level can be updated in parallel. Nodes get a single
+// NOTIFICATION_TRANSFORM_CHANGED per flush no matter how often they were moved.
+//
+// Reading a global transform between flushes composes it from the closest valid
+// ancestor, so the result is always up to date, and caches it in the slots along the
+// way. Each slot remembers the stamp its parent had when it was computed, so the
+// other children of a cached slot still know they're out of date.
+//
+// There is no lock, slots follow the same thread group rule as Node::data: a slot is
+// only written from a thread that can access its node, reads from other threads only
+// compose without caching. Slots are only added and removed along with the tree, and
+// flush() runs on the main thread while no thread group is processed.
+//
+// Node3D::set_ignore_transform_notification() is only checked when the node is moved,
+// so the choice is stored with the slot and honored by the next flush.
+class Node3DTransformBatch {
+	enum {
+		FLAG_DIRTY = 1, // Cached global transform is out of date.
+		FLAG_PENDING = 2, // Local transform changed since the last flush, which must update the subtree and notify.
+		FLAG_CHANGED = 4, // Global transform recomputed by the current flush.
+		FLAG_TOP_LEVEL = 8,
+		FLAG_DISABLE_SCALE = 16,
+		FLAG_IGNORE_NOTIFICATION = 32, // Every local change since the last flush was made with notifications ignored.
+	};
+
+	static const uint32_t INVALID_SLOT = 0xFFFFFFFF;
+
+	// Indexed by slot.
+	LocalVector<Transform3D> local;
+	LocalVector<Transform3D> global;
+	LocalVector<uint32_t> parent;
+	LocalVector<uint32_t> flags;
+	LocalVector<uint32_t> stamp; // Incremented whenever the global transform is computed.
+	LocalVector<uint32_t> parent_stamp; // Parent stamp the global transform was computed from.
+	LocalVector<uint32_t> depth;
+	LocalVector<uint32_t> level_pos;
+	LocalVector<Node3D *> nodes;
+	LocalVector<uint32_t> free_slots;
+
+	LocalVector<LocalVector<uint32_t>> levels; // Slots by depth.
+	// Slots in different thread groups can be marked concurrently.
+	SafeNumeric<uint32_t> pending_count;
+	SafeNumeric<uint32_t> inv_min_pending_depth; // Inverted, so exchange_if_greater() keeps the smallest depth.
+
+	_FORCE_INLINE_ void _mark_dirty(uint32_t p_slot);
+	_FORCE_INLINE_ void _set_global(uint32_t p_slot, const Transform3D &p_global);
+	Transform3D _compose_global(uint32_t p_slot, uint32_t p_top, bool &r_cached);
+	void _update_slot(uint32_t p_index, LocalVector<uint32_t> *p_level);
+
+public:
+	uint32_t add(Node3D *p_node, uint32_t p_parent, const Transform3D &p_local, bool p_top_level, bool p_disable_scale);
+	void remove(uint32_t p_slot);
+
+	void set_local(uint32_t p_slot, const Transform3D &p_local, bool p_ignore_notification = false);
+	void set_top_level(uint32_t p_slot, bool p_enabled);
+	void set_disable_scale(uint32_t p_slot, bool p_enabled);
+
+	Transform3D get_global(uint32_t p_slot);
+
+	void flush();
+
+	uint32_t get_node_count() const { return nodes.size() - free_slots.size(); }
+
+	~Node3DTransformBatch();
+};
+
+#endif // NODE_3D_TRANSFORM_BATCH_H
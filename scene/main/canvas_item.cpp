@@ -69,6 +69,7 @@ void CanvasItem::_propagate_visibility_changed(bool p_parent_visible_in_tree) {
 }
 
 void CanvasItem::set_visible(bool p_visible) {
+	ERR_THREAD_GUARD;
 	if (visible == p_visible) {
 		return;
 	}
@@ -724,6 +725,7 @@ void CanvasItem::_notify_transform(CanvasItem *p_node) {
 	if (p_node->notify_transform && !p_node->xform_change.in_list()) {
 		if (!p_node->block_transform_notify) {
 			if (p_node->is_inside_tree()) {
+				MutexLock lock(get_tree()->xform_change_mutex);
 				get_tree()->xform_change_list.add(&p_node->xform_change);
 			}
 		}
@@ -861,7 +863,10 @@ void CanvasItem::force_update_transform() {
 		return;
 	}
 
-	get_tree()->xform_change_list.remove(&xform_change);
+	{
+		MutexLock lock(get_tree()->xform_change_mutex);
+		get_tree()->xform_change_list.remove(&xform_change);
+	}
 
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
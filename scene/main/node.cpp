@@ -46,9 +46,12 @@
 #include <stdint.h>
 
 VARIANT_ENUM_CAST(Node::ProcessMode);
+VARIANT_ENUM_CAST(Node::ProcessThreadGroup);
 VARIANT_ENUM_CAST(Node::InternalMode);
 
 int Node::orphan_node_count = 0;
+thread_local Node *Node::current_process_thread_group = nullptr;
+SafeNumeric<uint64_t> Node::subtree_version_counter;
 
 void Node::_notification(int p_notification) {
 	switch (p_notification) {
@@ -76,6 +79,15 @@ void Node::_notification(int p_notification) {
 				data.process_owner = this;
 			}
 
+			if (data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+				data.process_thread_group_owner = data.parent ? data.parent->data.process_thread_group_owner : nullptr;
+			} else {
+				data.process_thread_group_owner = this;
+				if (data.process_thread_group == PROCESS_THREAD_GROUP_SUB_THREAD) {
+					get_tree()->_add_process_group(this);
+				}
+			}
+
 			if (data.input) {
 				add_to_group("_vp_input" + itos(get_viewport()->get_instance_id()));
 			}
@@ -114,6 +126,10 @@ void Node::_notification(int p_notification) {
 			}
 
 			data.process_owner = nullptr;
+			if (data.process_group) {
+				get_tree()->_remove_process_group(this);
+			}
+			data.process_thread_group_owner = nullptr;
 			if (data.path_cache) {
 				memdelete(data.path_cache);
 				data.path_cache = nullptr;
@@ -262,6 +278,7 @@ void Node::_propagate_after_exit_tree() {
 			}
 			data.owner->data.owned.erase(data.OW);
 			data.owner = nullptr;
+			_subtree_changed();
 		}
 	}
 
@@ -323,6 +340,7 @@ void Node::_propagate_exit_tree() {
 }
 
 void Node::move_child(Node *p_child, int p_pos) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(p_child->data.parent != this, "Child is not a child of this node.");
 
@@ -372,6 +390,8 @@ void Node::_move_child(Node *p_child, int p_pos, bool p_ignore_end) {
 
 	if (data.tree) {
 		data.tree->tree_changed();
+		// Thread groups with the same order are sorted by tree order.
+		data.tree->process_groups_dirty = true;
 	}
 
 	data.blocked++;
@@ -379,6 +399,12 @@ void Node::_move_child(Node *p_child, int p_pos, bool p_ignore_end) {
 	for (int i = motion_from; i <= motion_to; i++) {
 		data.children[i]->data.pos = i;
 	}
+	// Siblings sharing the name may now come first.
+	Node *const *first_same_name = data.children_by_name.getptr(p_child->data.name);
+	if (first_same_name && (*first_same_name != p_child || p_child->data.next_same_name)) {
+		_unindex_child_name(p_child);
+		_index_child_name(p_child);
+	}
 	// notification second
 	move_child_notify(p_child);
 	for (int i = motion_from; i <= motion_to; i++) {
@@ -432,6 +458,7 @@ void Node::owner_changed_notify() {
 }
 
 void Node::set_physics_process(bool p_process) {
+	ERR_THREAD_GUARD;
 	if (data.physics_process == p_process) {
 		return;
 	}
@@ -450,6 +477,7 @@ bool Node::is_physics_processing() const {
 }
 
 void Node::set_physics_process_internal(bool p_process_internal) {
+	ERR_THREAD_GUARD;
 	if (data.physics_process_internal == p_process_internal) {
 		return;
 	}
@@ -468,6 +496,7 @@ bool Node::is_physics_processing_internal() const {
 }
 
 void Node::set_process_mode(ProcessMode p_mode) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.process_mode == p_mode) {
 		return;
 	}
@@ -560,6 +589,148 @@ void Node::_propagate_process_owner(Node *p_owner, int p_pause_notification, int
 	}
 }
 
+void Node::set_process_thread_group(ProcessThreadGroup p_mode) {
+	ERR_MAIN_THREAD_GUARD;
+	if (data.process_thread_group == p_mode) {
+		return;
+	}
+
+	data.process_thread_group = p_mode;
+
+	if (!is_inside_tree()) {
+		return;
+	}
+
+	if (data.process_group) {
+		get_tree()->_remove_process_group(this);
+	}
+
+	Node *owner = this;
+	if (p_mode == PROCESS_THREAD_GROUP_INHERIT) {
+		owner = data.parent ? data.parent->data.process_thread_group_owner : nullptr;
+	} else if (p_mode == PROCESS_THREAD_GROUP_SUB_THREAD) {
+		get_tree()->_add_process_group(this);
+	}
+
+	_propagate_process_thread_group_owner(owner);
+}
+
+Node::ProcessThreadGroup Node::get_process_thread_group() const {
+	return data.process_thread_group;
+}
+
+void Node::set_process_thread_group_order(int p_order) {
+	ERR_MAIN_THREAD_GUARD;
+	if (data.process_thread_group_order == p_order) {
+		return;
+	}
+
+	data.process_thread_group_order = p_order;
+
+	if (data.process_group) {
+		get_tree()->process_groups_dirty = true;
+	}
+}
+
+int Node::get_process_thread_group_order() const {
+	return data.process_thread_group_order;
+}
+
+void Node::_propagate_process_thread_group_owner(Node *p_owner) {
+	data.process_thread_group_owner = p_owner;
+
+	for (int i = 0; i < data.children.size(); i++) {
+		Node *c = data.children[i];
+		if (c->data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+			c->_propagate_process_thread_group_owner(p_owner);
+		}
+	}
+}
+
+bool Node::is_accessible_from_caller_thread() const {
+	if (!data.inside_tree) {
+		// Nodes outside the tree aren't processed, so any thread may set them up.
+		return true;
+	}
+
+	if (current_process_thread_group == nullptr) {
+		// No thread group is being processed by this thread, so nodes inside the tree belong to the main thread.
+		return Thread::get_caller_id() == Thread::get_main_id();
+	}
+
+	return current_process_thread_group == data.process_thread_group_owner;
+}
+
+bool Node::is_readable_from_caller_thread() const {
+	if (!data.inside_tree) {
+		return true;
+	}
+
+	if (current_process_thread_group == nullptr) {
+		return Thread::get_caller_id() == Thread::get_main_id();
+	}
+
+	// The main thread waits for the thread groups, and they can't add, remove or move nodes.
+	return true;
+}
+
+void Node::set_meta(const StringName &p_name, const Variant &p_value) {
+	ERR_THREAD_GUARD;
+	Object::set_meta(p_name, p_value);
+}
+
+void Node::call_deferred_thread_groupp(const StringName &p_method, const Variant **p_args, int p_argcount) {
+	// Queue on the group processed by the calling thread, which is the only one touching it.
+	SceneTree::ProcessGroup *pg = current_process_thread_group ? current_process_thread_group->data.process_group : nullptr;
+	if (!pg) {
+		MessageQueue::get_singleton()->push_callp(this, p_method, p_args, p_argcount);
+		return;
+	}
+
+	SceneTree::ProcessGroup::DeferredCall call;
+	call.callable = Callable(this, p_method);
+	call.args.resize(p_argcount);
+	for (int i = 0; i < p_argcount; i++) {
+		call.args.write[i] = *p_args[i];
+	}
+	pg->call_queue.push_back(call);
+}
+
+void Node::notify_deferred_thread_group(int p_notification) {
+	SceneTree::ProcessGroup *pg = current_process_thread_group ? current_process_thread_group->data.process_group : nullptr;
+	if (!pg) {
+		MessageQueue::get_singleton()->push_notification(this, p_notification);
+		return;
+	}
+
+	SceneTree::ProcessGroup::DeferredCall call;
+	call.notification_target = get_instance_id();
+	call.notification = p_notification;
+	pg->call_queue.push_back(call);
+}
+
+Error Node::_call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	if (p_argcount < 1) {
+		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
+		r_error.argument = 1;
+		return ERR_INVALID_PARAMETER;
+	}
+
+	Variant::Type type = p_args[0]->get_type();
+	if (type != Variant::STRING_NAME && type != Variant::STRING) {
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
+		r_error.argument = 0;
+		r_error.expected = Variant::STRING_NAME;
+		return ERR_INVALID_PARAMETER;
+	}
+
+	StringName method = (*p_args[0]).operator StringName();
+
+	call_deferred_thread_groupp(method, &p_args[1], p_argcount - 1);
+	r_error.error = Callable::CallError::CALL_OK;
+	return OK;
+}
+
 void Node::set_multiplayer_authority(int p_peer_id, bool p_recursive) {
 	data.multiplayer_authority = p_peer_id;
 
@@ -754,6 +925,7 @@ double Node::get_process_delta_time() const {
 }
 
 void Node::set_process(bool p_process) {
+	ERR_THREAD_GUARD;
 	if (data.process == p_process) {
 		return;
 	}
@@ -772,6 +944,7 @@ bool Node::is_processing() const {
 }
 
 void Node::set_process_internal(bool p_process_internal) {
+	ERR_THREAD_GUARD;
 	if (data.process_internal == p_process_internal) {
 		return;
 	}
@@ -790,6 +963,7 @@ bool Node::is_processing_internal() const {
 }
 
 void Node::set_process_priority(int p_priority) {
+	ERR_THREAD_GUARD;
 	data.process_priority = p_priority;
 
 	// Make sure we are in SceneTree.
@@ -819,6 +993,7 @@ int Node::get_process_priority() const {
 }
 
 void Node::set_process_input(bool p_enable) {
+	ERR_THREAD_GUARD;
 	if (p_enable == data.input) {
 		return;
 	}
@@ -840,6 +1015,7 @@ bool Node::is_processing_input() const {
 }
 
 void Node::set_process_shortcut_input(bool p_enable) {
+	ERR_THREAD_GUARD;
 	if (p_enable == data.shortcut_input) {
 		return;
 	}
@@ -860,6 +1036,7 @@ bool Node::is_processing_shortcut_input() const {
 }
 
 void Node::set_process_unhandled_input(bool p_enable) {
+	ERR_THREAD_GUARD;
 	if (p_enable == data.unhandled_input) {
 		return;
 	}
@@ -880,6 +1057,7 @@ bool Node::is_processing_unhandled_input() const {
 }
 
 void Node::set_process_unhandled_key_input(bool p_enable) {
+	ERR_THREAD_GUARD;
 	if (p_enable == data.unhandled_key_input) {
 		return;
 	}
@@ -904,10 +1082,18 @@ StringName Node::get_name() const {
 }
 
 void Node::_set_name_nocheck(const StringName &p_name) {
+	if (data.parent) {
+		data.parent->_unindex_child_name(this);
+	}
 	data.name = p_name;
+	if (data.parent) {
+		data.parent->_index_child_name(this);
+	}
+	_subtree_changed();
 }
 
 void Node::set_name(const String &p_name) {
+	ERR_MAIN_THREAD_GUARD;
 	String name = p_name.validate_node_name();
 
 	ERR_FAIL_COND(name.is_empty());
@@ -915,11 +1101,18 @@ void Node::set_name(const String &p_name) {
 	if (data.unique_name_in_owner && data.owner) {
 		_release_unique_name_in_owner();
 	}
+
+	if (data.parent) {
+		data.parent->_unindex_child_name(this);
+	}
+
 	data.name = name;
 
 	if (data.parent) {
 		data.parent->_validate_child_name(this, true);
+		data.parent->_index_child_name(this);
 	}
+	_subtree_changed();
 
 	if (data.unique_name_in_owner && data.owner) {
 		_acquire_unique_name_in_owner();
@@ -981,17 +1174,9 @@ void Node::_validate_child_name(Node *p_child, bool p_force_human_readable) {
 			unique = false;
 		} else {
 			//check if exists
-			Node **children = data.children.ptrw();
-			int cc = data.children.size();
-
-			for (int i = 0; i < cc; i++) {
-				if (children[i] == p_child) {
-					continue;
-				}
-				if (children[i]->data.name == p_child->data.name) {
-					unique = false;
-					break;
-				}
+			Node *const *existing = data.children_by_name.getptr(p_child->data.name);
+			if (existing && *existing != p_child) {
+				unique = false;
 			}
 		}
 
@@ -1038,22 +1223,9 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 	}
 
 	//quickly test if proposed name exists
-	int cc = data.children.size(); //children count
-	const Node *const *children_ptr = data.children.ptr();
-
 	{
-		bool exists = false;
-
-		for (int i = 0; i < cc; i++) {
-			if (children_ptr[i] == p_child) { //exclude self in renaming if it's already a child
-				continue;
-			}
-			if (children_ptr[i]->data.name == name) {
-				exists = true;
-			}
-		}
-
-		if (!exists) {
+		Node *const *existing = data.children_by_name.getptr(name);
+		if (!existing || *existing == p_child) { //exclude self in renaming if it's already a child
 			return; //if it does not exist, it does not need validation
 		}
 	}
@@ -1082,18 +1254,9 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 
 	for (;;) {
 		StringName attempt = name_string + nums;
-		bool exists = false;
+		Node *const *existing = data.children_by_name.getptr(attempt);
 
-		for (int i = 0; i < cc; i++) {
-			if (children_ptr[i] == p_child) {
-				continue;
-			}
-			if (children_ptr[i]->data.name == attempt) {
-				exists = true;
-			}
-		}
-
-		if (!exists) {
+		if (!existing || *existing == p_child) {
 			name = attempt;
 			return;
 		} else {
@@ -1115,6 +1278,9 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 	p_child->data.pos = data.children.size();
 	data.children.push_back(p_child);
 	p_child->data.parent = this;
+	_index_child_name(p_child);
+	// Share the fresh stamp, since paths leaving the child's subtree upwards now resolve differently.
+	p_child->data.subtree_version = data.subtree_version;
 
 	if (data.internal_children_back > 0) {
 		_move_child(p_child, data.children.size() - data.internal_children_back - 1);
@@ -1132,6 +1298,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 }
 
 void Node::add_child(Node *p_child, bool p_legible_unique_name, InternalMode p_internal) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(p_child == this, vformat("Can't add child '%s' to itself.", p_child->get_name())); // adding to itself!
 	ERR_FAIL_COND_MSG(p_child->data.parent, vformat("Can't add child '%s' to '%s', already has a parent '%s'.", p_child->get_name(), get_name(), p_child->data.parent->get_name())); //Fail if node has a parent
@@ -1155,6 +1322,7 @@ void Node::add_child(Node *p_child, bool p_legible_unique_name, InternalMode p_i
 }
 
 void Node::add_sibling(Node *p_sibling, bool p_legible_unique_name) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_sibling);
 	ERR_FAIL_NULL(data.parent);
 	ERR_FAIL_COND_MSG(p_sibling == this, vformat("Can't add sibling '%s' to itself.", p_sibling->get_name())); // adding to itself!
@@ -1172,6 +1340,7 @@ void Node::add_sibling(Node *p_sibling, bool p_legible_unique_name) {
 }
 
 void Node::remove_child(Node *p_child) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, remove_node() failed. Consider using call_deferred(\"remove_child\", child) instead.");
 
@@ -1211,6 +1380,7 @@ void Node::remove_child(Node *p_child) {
 	p_child->notification(NOTIFICATION_UNPARENTED);
 
 	data.children.remove_at(idx);
+	_unindex_child_name(p_child);
 
 	//update pointer and size
 	child_count = data.children.size();
@@ -1223,6 +1393,7 @@ void Node::remove_child(Node *p_child) {
 
 	p_child->data.parent = nullptr;
 	p_child->data.pos = -1;
+	_subtree_changed();
 
 	if (data.inside_tree) {
 		p_child->_propagate_after_exit_tree();
@@ -1238,6 +1409,7 @@ int Node::get_child_count(bool p_include_internal) const {
 }
 
 Node *Node::get_child(int p_index, bool p_include_internal) const {
+	ERR_READ_THREAD_GUARD_V(nullptr);
 	if (p_include_internal) {
 		if (p_index < 0) {
 			p_index += data.children.size();
@@ -1254,28 +1426,192 @@ Node *Node::get_child(int p_index, bool p_include_internal) const {
 	}
 }
 
+void Node::_subtree_changed() {
+	// A fresh stamp per change, so a node further up can't match a version recorded for another one.
+	uint64_t version = subtree_version_counter.increment();
+	for (Node *n = this; n; n = n->data.parent) {
+		n->data.subtree_version = version;
+	}
+}
+
 Node *Node::_get_child_by_name(const StringName &p_name) const {
-	int cc = data.children.size();
-	Node *const *cd = data.children.ptr();
+	Node *const *child = data.children_by_name.getptr(p_name);
+	return child ? *child : nullptr;
+}
+
+void Node::_index_child_name(Node *p_child) {
+	_subtree_changed();
+	// Names are unique among siblings, except when set without validation (e.g. by
+	// scene instantiation). Index the first child in order with a given name in that
+	// case, and chain the others after it.
+	Node **first = data.children_by_name.getptr(p_child->data.name);
+	if (!first) {
+		p_child->data.next_same_name = nullptr;
+		data.children_by_name.insert(p_child->data.name, p_child);
+	} else if (p_child->data.pos < (*first)->data.pos) {
+		p_child->data.next_same_name = *first;
+		*first = p_child;
+	} else {
+		p_child->data.next_same_name = (*first)->data.next_same_name;
+		(*first)->data.next_same_name = p_child;
+	}
+}
 
-	for (int i = 0; i < cc; i++) {
-		if (cd[i]->data.name == p_name) {
-			return cd[i];
+void Node::_unindex_child_name(Node *p_child) {
+	_subtree_changed();
+	HashMap<StringName, Node *>::Iterator E = data.children_by_name.find(p_child->data.name);
+	if (!E) {
+		return;
+	}
+
+	if (E->value == p_child) {
+		Node *next = p_child->data.next_same_name;
+		if (!next) {
+			data.children_by_name.remove(E);
+		} else {
+			// Let the sibling sharing the name that comes first in order take its place.
+			Node *first = next;
+			Node *first_prev = nullptr;
+			for (Node *n = next; n->data.next_same_name; n = n->data.next_same_name) {
+				if (n->data.next_same_name->data.pos < first->data.pos) {
+					first = n->data.next_same_name;
+					first_prev = n;
+				}
+			}
+			if (first_prev) {
+				first_prev->data.next_same_name = first->data.next_same_name;
+				first->data.next_same_name = next;
+			}
+			E->value = first;
+		}
+	} else {
+		Node *prev = E->value;
+		while (prev->data.next_same_name && prev->data.next_same_name != p_child) {
+			prev = prev->data.next_same_name;
+		}
+		if (prev->data.next_same_name == p_child) {
+			prev->data.next_same_name = p_child->data.next_same_name;
 		}
 	}
+	p_child->data.next_same_name = nullptr;
+}
 
-	return nullptr;
+// Recently resolved paths. Each entry is valid while the subtree of the highest node the
+// resolution went through (its scope) is unchanged, so unrelated parts of the tree can
+// change without invalidating it.
+struct Node::ResolveCache {
+	struct Entry {
+		NodePath path;
+		Node *node = nullptr;
+		uint64_t scope_version = 0;
+		int scope_levels = 0; // How far above the resolving node the scope is.
+	};
+
+	static const int SIZE = 8;
+	Entry entries[SIZE];
+	int next_replaced = 0;
+
+	_FORCE_INLINE_ Entry *find(const Node *p_from, const NodePath &p_path) {
+		uint32_t hash = p_path.hash();
+		for (int i = 0; i < SIZE; i++) {
+			Entry &e = entries[i];
+			if (e.path.hash() != hash || e.path != p_path) {
+				continue;
+			}
+			const Node *scope = p_from;
+			for (int j = 0; j < e.scope_levels && scope; j++) {
+				scope = scope->data.parent;
+			}
+			return (scope && scope->data.subtree_version == e.scope_version) ? &e : nullptr;
+		}
+		return nullptr;
+	}
+};
+
+bool Node::_is_node_path_cached(const NodePath &p_path) const {
+	return data.resolve_cache && data.resolve_cache->find(this, p_path);
 }
 
 Node *Node::get_node_or_null(const NodePath &p_path) const {
+	ERR_READ_THREAD_GUARD_V(nullptr);
 	if (p_path.is_empty()) {
 		return nullptr;
 	}
 
 	ERR_FAIL_COND_V_MSG(!data.inside_tree && p_path.is_absolute(), nullptr, "Can't use get_node() with absolute paths from outside the active scene tree.");
 
+	if (p_path.get_name_count() == 1 && !p_path.is_absolute()) {
+		return _resolve_node_path(p_path); // A single lookup, nothing to gain from caching.
+	}
+
+	// The cache may only be touched by the thread the node belongs to. Nodes outside the
+	// tree can be read from any thread, so only the main thread caches for them.
+	bool can_cache = data.inside_tree ? is_accessible_from_caller_thread() : Thread::get_caller_id() == Thread::get_main_id();
+	if (!can_cache) {
+		return _resolve_node_path(p_path);
+	}
+
+	if (data.resolve_cache) {
+		ResolveCache::Entry *cached = data.resolve_cache->find(this, p_path);
+		if (cached) {
+			return cached->node;
+		}
+	}
+
+	int scope_levels = 0;
+	Node *node = _resolve_node_path(p_path, &scope_levels);
+	if (scope_levels < 0) {
+		return node; // The scope couldn't be determined.
+	}
+
+	const Node *scope = this;
+	for (int i = 0; i < scope_levels; i++) {
+		scope = scope->data.parent;
+	}
+
+	if (!data.resolve_cache) {
+		data.resolve_cache = memnew(ResolveCache);
+	}
+	// Replace a stale entry for the same path first, then round-robin.
+	ResolveCache::Entry *e = nullptr;
+	for (int i = 0; i < ResolveCache::SIZE; i++) {
+		if (data.resolve_cache->entries[i].path == p_path) {
+			e = &data.resolve_cache->entries[i];
+			break;
+		}
+	}
+	if (!e) {
+		e = &data.resolve_cache->entries[data.resolve_cache->next_replaced];
+		data.resolve_cache->next_replaced = (data.resolve_cache->next_replaced + 1) % ResolveCache::SIZE;
+	}
+	e->path = p_path;
+	e->node = node;
+	e->scope_version = scope->data.subtree_version;
+	e->scope_levels = scope_levels;
+
+	return node;
+}
+
+// Number of levels p_node is below p_ancestor, or -1 if it isn't below it.
+static int _get_levels_below(const Node *p_node, const Node *p_ancestor) {
+	int levels = 0;
+	for (const Node *n = p_node; n; n = n->get_parent()) {
+		if (n == p_ancestor) {
+			return levels;
+		}
+		levels++;
+	}
+	return -1;
+}
+
+Node *Node::_resolve_node_path(const NodePath &p_path, int *r_scope_levels) const {
 	Node *current = nullptr;
 	Node *root = nullptr;
+	// Depth of the current node relative to this one (negative above it), and the highest
+	// node reached, which scopes the changes that can affect the result.
+	int depth = 0;
+	int top = 0;
+	bool scoped = true;
 
 	if (!p_path.is_absolute()) {
 		current = const_cast<Node *>(this); //start from this
@@ -1283,7 +1619,10 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 		root = const_cast<Node *>(this);
 		while (root->data.parent) {
 			root = root->data.parent; //start from root
+			depth--;
 		}
+		top = depth;
+		depth--; // Until the root name is matched.
 	}
 
 	for (int i = 0; i < p_path.get_name_count(); i++) {
@@ -1296,50 +1635,48 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 
 		} else if (name == SceneStringNames::get_singleton()->doubledot) { // ..
 
-			if (current == nullptr || !current->data.parent) {
-				return nullptr;
+			if (current != nullptr && current->data.parent) {
+				next = current->data.parent;
+				depth--;
+				top = MIN(top, depth);
 			}
 
-			next = current->data.parent;
 		} else if (current == nullptr) {
 			if (name == root->get_name()) {
 				next = root;
+				depth++;
 			}
 
 		} else if (name.is_node_unique_name()) {
-			if (current->data.owned_unique_nodes.size()) {
-				// Has unique nodes in ownership
-				Node **unique = current->data.owned_unique_nodes.getptr(name);
-				if (!unique) {
-					return nullptr;
-				}
-				next = *unique;
-			} else if (current->data.owner) {
-				Node **unique = current->data.owner->data.owned_unique_nodes.getptr(name);
-				if (!unique) {
-					return nullptr;
+			// Look in the unique nodes owned by this node if any, or else by its owner.
+			Node *owner = current->data.owned_unique_nodes.size() ? current : current->data.owner;
+			if (owner) {
+				Node **unique = owner->data.owned_unique_nodes.getptr(name);
+				next = unique ? *unique : nullptr;
+
+				int owner_levels = _get_levels_below(current, owner);
+				int unique_levels = next ? _get_levels_below(next, owner) : 0;
+				if (owner_levels < 0 || unique_levels < 0) {
+					scoped = false;
+				} else {
+					top = MIN(top, depth - owner_levels);
+					depth += unique_levels - owner_levels;
 				}
-				next = *unique;
-			} else {
-				return nullptr;
 			}
 
 		} else {
-			next = nullptr;
-
-			for (int j = 0; j < current->data.children.size(); j++) {
-				Node *child = current->data.children[j];
-
-				if (child->data.name == name) {
-					next = child;
-					break;
-				}
-			}
-			if (next == nullptr) {
-				return nullptr;
-			};
+			next = current->_get_child_by_name(name);
+			depth++;
 		}
+
 		current = next;
+		if (current == nullptr) {
+			break;
+		}
+	}
+
+	if (r_scope_levels) {
+		*r_scope_levels = scoped ? -top : -1;
 	}
 
 	return current;
@@ -1547,6 +1884,7 @@ void Node::_set_owner_nocheck(Node *p_owner) {
 	data.owner = p_owner;
 	data.owner->data.owned.push_back(this);
 	data.OW = data.owner->data.owned.back();
+	_subtree_changed();
 
 	owner_changed_notify();
 }
@@ -1559,6 +1897,7 @@ void Node::_release_unique_name_in_owner() {
 		return; // Ignore.
 	}
 	data.owner->data.owned_unique_nodes.erase(key);
+	data.owner->_subtree_changed();
 }
 
 void Node::_acquire_unique_name_in_owner() {
@@ -1573,6 +1912,7 @@ void Node::_acquire_unique_name_in_owner() {
 		return;
 	}
 	data.owner->data.owned_unique_nodes[key] = this;
+	data.owner->_subtree_changed();
 }
 
 void Node::set_unique_name_in_owner(bool p_enabled) {
@@ -1597,6 +1937,7 @@ bool Node::is_unique_name_in_owner() const {
 }
 
 void Node::set_owner(Node *p_owner) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.owner) {
 		if (data.unique_name_in_owner) {
 			_release_unique_name_in_owner();
@@ -1604,6 +1945,7 @@ void Node::set_owner(Node *p_owner) {
 		data.owner->data.owned.erase(data.OW);
 		data.OW = nullptr;
 		data.owner = nullptr;
+		_subtree_changed();
 	}
 
 	ERR_FAIL_COND(p_owner == this);
@@ -1746,26 +2088,24 @@ bool Node::is_in_group(const StringName &p_identifier) const {
 }
 
 void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
+	ERR_THREAD_GUARD;
 	ERR_FAIL_COND(!p_identifier.operator String().length());
 
 	if (data.grouped.has(p_identifier)) {
 		return;
 	}
 
-	GroupData gd;
+	GroupData &gd = data.grouped.insert(p_identifier, GroupData())->value;
+	gd.persistent = p_persistent;
 
+	// Inserted first, SceneTree keeps the index of the node in the group there.
 	if (data.tree) {
 		gd.group = data.tree->add_to_group(p_identifier, this);
-	} else {
-		gd.group = nullptr;
 	}
-
-	gd.persistent = p_persistent;
-
-	data.grouped[p_identifier] = gd;
 }
 
 void Node::remove_from_group(const StringName &p_identifier) {
+	ERR_THREAD_GUARD;
 	ERR_FAIL_COND(!data.grouped.has(p_identifier));
 
 	HashMap<StringName, GroupData>::Iterator E = data.grouped.find(p_identifier);
@@ -1866,6 +2206,7 @@ void Node::_propagate_deferred_notification(int p_notification, bool p_reverse)
 }
 
 void Node::propagate_notification(int p_notification) {
+	ERR_THREAD_GUARD;
 	data.blocked++;
 	notification(p_notification);
 
@@ -1876,6 +2217,7 @@ void Node::propagate_notification(int p_notification) {
 }
 
 void Node::propagate_call(const StringName &p_method, const Array &p_args, const bool p_parent_first) {
+	ERR_THREAD_GUARD;
 	data.blocked++;
 
 	if (p_parent_first && has_method(p_method)) {
@@ -2419,6 +2761,7 @@ static void find_owned_by(Node *p_by, Node *p_node, List<Node *> *p_owned) {
 }
 
 void Node::replace_by(Node *p_node, bool p_keep_groups) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_node);
 	ERR_FAIL_COND(p_node->data.parent);
 
@@ -2846,6 +3189,13 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_process_mode", "mode"), &Node::set_process_mode);
 	ClassDB::bind_method(D_METHOD("get_process_mode"), &Node::get_process_mode);
 	ClassDB::bind_method(D_METHOD("can_process"), &Node::can_process);
+	ClassDB::bind_method(D_METHOD("set_process_thread_group", "mode"), &Node::set_process_thread_group);
+	ClassDB::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
+	ClassDB::bind_method(D_METHOD("set_process_thread_group_order", "order"), &Node::set_process_thread_group_order);
+	ClassDB::bind_method(D_METHOD("get_process_thread_group_order"), &Node::get_process_thread_group_order);
+	ClassDB::bind_method(D_METHOD("is_accessible_from_caller_thread"), &Node::is_accessible_from_caller_thread);
+	ClassDB::bind_method(D_METHOD("is_readable_from_caller_thread"), &Node::is_readable_from_caller_thread);
+	ClassDB::bind_method(D_METHOD("notify_deferred_thread_group", "what"), &Node::notify_deferred_thread_group);
 	ClassDB::bind_method(D_METHOD("print_orphan_nodes"), &Node::_print_orphan_nodes);
 
 	ClassDB::bind_method(D_METHOD("set_display_folded", "fold"), &Node::set_display_folded);
@@ -2911,6 +3261,15 @@ void Node::_bind_methods() {
 		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "rpc_id", &Node::_rpc_id_bind, mi);
 	}
 
+	{
+		MethodInfo mi;
+
+		mi.arguments.push_back(PropertyInfo(Variant::STRING_NAME, "method"));
+
+		mi.name = "call_deferred_thread_group";
+		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "call_deferred_thread_group", &Node::_call_deferred_thread_group_bind, mi);
+	}
+
 	ClassDB::bind_method(D_METHOD("update_configuration_warnings"), &Node::update_configuration_warnings);
 
 	BIND_CONSTANT(NOTIFICATION_ENTER_TREE);
@@ -2963,6 +3322,10 @@ void Node::_bind_methods() {
 	BIND_ENUM_CONSTANT(PROCESS_MODE_ALWAYS);
 	BIND_ENUM_CONSTANT(PROCESS_MODE_DISABLED);
 
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_INHERIT);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_MAIN_THREAD);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_SUB_THREAD);
+
 	BIND_ENUM_CONSTANT(DUPLICATE_SIGNALS);
 	BIND_ENUM_CONSTANT(DUPLICATE_GROUPS);
 	BIND_ENUM_CONSTANT(DUPLICATE_SCRIPTS);
@@ -2989,6 +3352,9 @@ void Node::_bind_methods() {
 	ADD_GROUP("Process", "process_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_mode", PROPERTY_HINT_ENUM, "Inherit,Pausable,When Paused,Always,Disabled"), "set_process_mode", "get_process_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_priority"), "set_process_priority", "get_process_priority");
+	ADD_SUBGROUP("Thread Group", "process_thread_group_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_ENUM, "Inherit,Main Thread,Sub Thread"), "set_process_thread_group", "get_process_thread_group");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group_order"), "set_process_thread_group_order", "get_process_thread_group_order");
 
 	ADD_GROUP("Editor Description", "editor_");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "editor_description", PROPERTY_HINT_MULTILINE_TEXT), "set_editor_description", "get_editor_description");
@@ -3021,12 +3387,18 @@ String Node::_get_name_num_separator() {
 
 Node::Node() {
 	orphan_node_count++;
+	data.subtree_version = subtree_version_counter.increment();
 }
 
 Node::~Node() {
 	data.grouped.clear();
 	data.owned.clear();
 	data.children.clear();
+	data.children_by_name.clear();
+
+	if (data.resolve_cache) {
+		memdelete(data.resolve_cache);
+	}
 
 	ERR_FAIL_COND(data.parent);
 	ERR_FAIL_COND(data.children.size());
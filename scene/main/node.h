@@ -31,11 +31,20 @@
 #ifndef NODE_H
 #define NODE_H
 
+#include "core/os/thread.h"
 #include "core/string/node_path.h"
 #include "core/templates/rb_map.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/scene_tree.h"
 
+// Guards for methods that may only be called from the thread currently processing the node's thread group.
+#define ERR_THREAD_GUARD ERR_FAIL_COND_MSG(!is_accessible_from_caller_thread(), "Caller thread can't call this function in this node (" + String(get_name()) + "). Use call_deferred() or call_deferred_thread_group() instead.");
+#define ERR_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(!is_accessible_from_caller_thread(), (m_ret), "Caller thread can't call this function in this node (" + String(get_name()) + "). Use call_deferred() or call_deferred_thread_group() instead.");
+// Guard for methods that only read the scene tree, which doesn't change while thread groups are processed.
+#define ERR_READ_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(!is_readable_from_caller_thread(), (m_ret), "Caller thread can't call this function in this node (" + String(get_name()) + "). Use call_deferred() or call_deferred_thread_group() instead.");
+// Guard for methods that touch the scene tree itself, which may only be modified from the main thread.
+#define ERR_MAIN_THREAD_GUARD ERR_FAIL_COND_MSG(data.inside_tree && Thread::get_caller_id() != Thread::get_main_id(), "This function in this node (" + String(get_name()) + ") can only be accessed from the main thread. Use call_deferred() or call_deferred_thread_group() instead.");
+
 class Viewport;
 class SceneState;
 class Tween;
@@ -53,6 +62,12 @@ public:
 		PROCESS_MODE_DISABLED, // never process
 	};
 
+	enum ProcessThreadGroup {
+		PROCESS_THREAD_GROUP_INHERIT, // same as parent node
+		PROCESS_THREAD_GROUP_MAIN_THREAD, // process on the main thread
+		PROCESS_THREAD_GROUP_SUB_THREAD, // process this subtree on a worker thread, concurrently with other sub-thread groups
+	};
+
 	enum DuplicateFlags {
 		DUPLICATE_SIGNALS = 1,
 		DUPLICATE_GROUPS = 2,
@@ -89,8 +104,11 @@ private:
 	struct GroupData {
 		bool persistent = false;
 		SceneTree::Group *group = nullptr;
+		int index = -1; // Position in group->nodes, maintained by SceneTree.
 	};
 
+	struct ResolveCache;
+
 	struct Data {
 		String scene_file_path;
 		Ref<SceneState> instance_state;
@@ -99,6 +117,8 @@ private:
 		Node *parent = nullptr;
 		Node *owner = nullptr;
 		Vector<Node *> children;
+		HashMap<StringName, Node *> children_by_name; // Index of children, kept in sync with their names.
+		Node *next_same_name = nullptr; // Next sibling sharing the name, chained from children_by_name.
 		HashMap<StringName, Node *> owned_unique_nodes;
 		bool unique_name_in_owner = false;
 
@@ -126,6 +146,11 @@ private:
 		ProcessMode process_mode = PROCESS_MODE_INHERIT;
 		Node *process_owner = nullptr;
 
+		ProcessThreadGroup process_thread_group = PROCESS_THREAD_GROUP_INHERIT;
+		Node *process_thread_group_owner = nullptr;
+		int process_thread_group_order = 0;
+		SceneTree::ProcessGroup *process_group = nullptr; // Only set on the owner of a sub-thread group.
+
 		int multiplayer_authority = 1; // Server by default.
 		Variant rpc_config;
 
@@ -152,6 +177,15 @@ private:
 
 		mutable NodePath *path_cache = nullptr;
 
+		// Stamped from subtree_version_counter on this node and its ancestors whenever something
+		// below changes what a NodePath resolves to.
+		uint64_t subtree_version = 0;
+		// Paths recently resolved by get_node() from this node. Only touched by the thread the
+		// node belongs to, see get_node_or_null().
+		mutable ResolveCache *resolve_cache = nullptr;
+
+		ObjectID scene_pool; // ScenePool recycling this instance on queue_free(), if any.
+
 	} data;
 
 	Ref<MultiplayerAPI> multiplayer;
@@ -159,7 +193,13 @@ private:
 	void _print_tree_pretty(const String &prefix, const bool last);
 	void _print_tree(const Node *p_node);
 
+	static SafeNumeric<uint64_t> subtree_version_counter;
+	void _subtree_changed();
+
 	Node *_get_child_by_name(const StringName &p_name) const;
+	Node *_resolve_node_path(const NodePath &p_path, int *r_scope_levels = nullptr) const;
+	void _index_child_name(Node *p_child);
+	void _unindex_child_name(Node *p_child);
 
 	void _replace_connections_target(Node *p_new_target);
 
@@ -174,6 +214,7 @@ private:
 	void _propagate_after_exit_tree();
 	void _print_orphan_nodes();
 	void _propagate_process_owner(Node *p_owner, int p_pause_notification, int p_enabled_notification);
+	void _propagate_process_thread_group_owner(Node *p_owner);
 	void _propagate_groups_dirty();
 	Array _get_node_and_resource(const NodePath &p_path);
 
@@ -185,11 +226,16 @@ private:
 
 	Error _rpc_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Error _rpc_id_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	Error _call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+
+	// Owner of the thread group being processed by the calling thread, if any.
+	static thread_local Node *current_process_thread_group;
 
 	_FORCE_INLINE_ bool _is_internal_front() const { return data.parent && data.pos < data.parent->data.internal_children_front; }
 	_FORCE_INLINE_ bool _is_internal_back() const { return data.parent && data.pos >= data.parent->data.children.size() - data.parent->data.internal_children_back; }
 
 	friend class SceneTree;
+	friend class ScenePool;
 
 	void _set_tree(SceneTree *p_tree);
 	void _propagate_pause_notification(bool p_enable);
@@ -204,6 +250,8 @@ protected:
 	void _block() { data.blocked++; }
 	void _unblock() { data.blocked--; }
 
+	bool _is_node_path_cached(const NodePath &p_path) const;
+
 	void _notification(int p_notification);
 
 	virtual void add_child_notify(Node *p_child);
@@ -452,6 +500,29 @@ public:
 	bool can_process_notification(int p_what) const;
 	bool is_enabled() const;
 
+	void set_process_thread_group(ProcessThreadGroup p_mode);
+	ProcessThreadGroup get_process_thread_group() const;
+
+	void set_process_thread_group_order(int p_order);
+	int get_process_thread_group_order() const;
+
+	bool is_accessible_from_caller_thread() const;
+	bool is_readable_from_caller_thread() const;
+
+	virtual void set_meta(const StringName &p_name, const Variant &p_value) override;
+
+	void call_deferred_thread_groupp(const StringName &p_method, const Variant **p_args, int p_argcount);
+	template <typename... VarArgs>
+	void call_deferred_thread_group(const StringName &p_method, VarArgs... p_args) {
+		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
+		const Variant *argptrs[sizeof...(p_args) + 1];
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+		call_deferred_thread_groupp(p_method, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
+	}
+	void notify_deferred_thread_group(int p_notification);
+
 	void request_ready();
 
 	static void print_orphan_nodes();
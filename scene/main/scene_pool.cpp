@@ -0,0 +1,362 @@
+/*************************************************************************/
+/*  scene_pool.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "scene_pool.h"
+
+#include "core/core_string_names.h"
+
+bool ScenePool::_collect_nodes(Node *p_root, LocalVector<Node *> &r_nodes) const {
+	Ref<SceneState> state = scene->get_state();
+	int nc = state->get_node_count();
+	r_nodes.resize(nc);
+	if (nc == 0) {
+		return false;
+	}
+
+	r_nodes[0] = p_root;
+	for (int i = 1; i < nc; i++) {
+		Node *node = p_root->get_node_or_null(state->get_node_path(i));
+		if (!node || node->is_queued_for_deletion()) {
+			return false; // Structure changed since instantiation, can't be reused.
+		}
+		r_nodes[i] = node;
+	}
+
+	return true;
+}
+
+void ScenePool::_capture_node_paths(Node *p_root, Node *p_node) {
+	for (int i = 0; i < p_node->get_child_count(false); i++) {
+		Node *child = p_node->get_child(i, false);
+		node_paths.insert(p_root->get_path_to(child));
+		_capture_node_paths(p_root, child);
+	}
+}
+
+void ScenePool::_capture_defaults(const LocalVector<Node *> &p_nodes) {
+	defaults.resize(p_nodes.size());
+	node_paths.clear();
+	_capture_node_paths(p_nodes[0], p_nodes[0]);
+
+	// Copies of the local to scene resources, taken before the instance gets to modify them.
+	HashMap<Ref<Resource>, Ref<Resource>> local_copies;
+
+	for (uint32_t i = 0; i < p_nodes.size(); i++) {
+		LocalVector<PropertyDefault> &node_defaults = defaults[i];
+		node_defaults.clear();
+
+		List<PropertyInfo> plist;
+		p_nodes[i]->get_property_list(&plist);
+		for (const PropertyInfo &E : plist) {
+			if (!(E.usage & PROPERTY_USAGE_STORAGE) || E.name == CoreStringNames::get_singleton()->_script) {
+				continue;
+			}
+
+			PropertyDefault pd;
+			pd.name = E.name;
+			pd.value = p_nodes[i]->get(E.name);
+			if (pd.value.get_type() == Variant::OBJECT) {
+				Ref<Resource> res = pd.value;
+				if (res.is_null()) {
+					if (pd.value.get_validated_object()) {
+						continue; // Nodes are specific to each instance.
+					}
+				} else if (res->is_local_to_scene()) {
+					HashMap<Ref<Resource>, Ref<Resource>>::Iterator C = local_copies.find(res);
+					if (!C) {
+						Ref<Resource> copy = res->duplicate_for_local_scene(nullptr, local_copies);
+						C = local_copies.insert(res, copy);
+					}
+					pd.value = C->value;
+					pd.local_to_scene = true;
+				}
+			}
+
+			node_defaults.push_back(pd);
+		}
+	}
+
+	defaults_captured = true;
+}
+
+void ScenePool::_free_extra_children(Node *p_root, Node *p_node) {
+	for (int i = p_node->get_child_count(false) - 1; i >= 0; i--) {
+		Node *child = p_node->get_child(i, false);
+		if (node_paths.has(p_root->get_path_to(child))) {
+			_free_extra_children(p_root, child);
+		} else {
+			p_node->remove_child(child);
+			memdelete(child);
+		}
+	}
+}
+
+void ScenePool::_reset_instance(const LocalVector<Node *> &p_nodes) {
+	if (!defaults_captured) {
+		return;
+	}
+
+	Node *root = p_nodes[0];
+
+	// Children added at runtime aren't part of the scene, whether they were given an owner or not.
+	_free_extra_children(root, root);
+
+	// Local to scene resources may have been modified through the instance, so like
+	// instantiate() does, every instance gets its own fresh duplicates.
+	HashMap<Ref<Resource>, Ref<Resource>> local_resources;
+
+	for (uint32_t i = 0; i < p_nodes.size() && i < defaults.size(); i++) {
+		Node *node = p_nodes[i];
+		const LocalVector<PropertyDefault> &node_defaults = defaults[i];
+
+		for (uint32_t j = 0; j < node_defaults.size(); j++) {
+			const PropertyDefault &pd = node_defaults[j];
+			if (pd.local_to_scene) {
+				Ref<Resource> res = pd.value;
+				HashMap<Ref<Resource>, Ref<Resource>>::Iterator L = local_resources.find(res);
+				if (!L) {
+					Ref<Resource> local_dupe = res->duplicate_for_local_scene(root, local_resources);
+					L = local_resources.insert(res, local_dupe);
+				}
+				node->set(pd.name, L->value);
+			} else if (node->get(pd.name) != pd.value) {
+				// Unchanged values are skipped, setters may have side effects like restarting playback.
+				node->set(pd.name, pd.value);
+			}
+		}
+
+		// Groups added at runtime aren't persistent, unlike the ones saved in the scene.
+		// Engine nodes only add themselves to such groups while inside the tree.
+		List<Node::GroupInfo> groups;
+		node->get_groups(&groups);
+		for (const Node::GroupInfo &E : groups) {
+			if (!E.persistent) {
+				node->remove_from_group(E.name);
+			}
+		}
+	}
+
+	for (KeyValue<Ref<Resource>, Ref<Resource>> &E : local_resources) {
+		if (E.value->get_local_scene() == root) {
+			E.value->setup_local_to_scene();
+		}
+	}
+}
+
+void ScenePool::_store(Node *p_root, LocalVector<Node *> &p_nodes) {
+	Instance instance;
+	instance.root = p_root;
+	instance.nodes = p_nodes;
+	available.push_back(instance);
+}
+
+void ScenePool::set_scene(const Ref<PackedScene> &p_scene) {
+	if (scene == p_scene) {
+		return;
+	}
+	clear();
+	scene = p_scene;
+	defaults.clear();
+	node_paths.clear();
+	defaults_captured = false;
+}
+
+Ref<PackedScene> ScenePool::get_scene() const {
+	return scene;
+}
+
+void ScenePool::set_max_size(int p_max_size) {
+	ERR_FAIL_COND(p_max_size < 0);
+	max_size = p_max_size;
+	while (max_size > 0 && (int)available.size() > max_size) {
+		memdelete(available[available.size() - 1].root);
+		available.resize(available.size() - 1);
+	}
+}
+
+int ScenePool::get_max_size() const {
+	return max_size;
+}
+
+void ScenePool::set_recycle_on_free(bool p_enable) {
+	recycle_on_free = p_enable;
+}
+
+bool ScenePool::is_recycle_on_free() const {
+	return recycle_on_free;
+}
+
+void ScenePool::set_request_ready_on_acquire(bool p_enable) {
+	request_ready_on_acquire = p_enable;
+}
+
+bool ScenePool::is_request_ready_on_acquire() const {
+	return request_ready_on_acquire;
+}
+
+Node *ScenePool::acquire() {
+	ERR_FAIL_COND_V_MSG(scene.is_null(), nullptr, "No scene set in the pool.");
+
+	Node *root = nullptr;
+
+	if (available.size()) {
+		Instance &instance = available[available.size() - 1];
+		root = instance.root;
+		if (request_ready_on_acquire) {
+			for (uint32_t i = 0; i < instance.nodes.size(); i++) {
+				instance.nodes[i]->request_ready();
+			}
+		}
+		available.resize(available.size() - 1);
+		hit_count++;
+	} else {
+		root = scene->instantiate();
+		ERR_FAIL_COND_V(!root, nullptr);
+		if (!defaults_captured) {
+			LocalVector<Node *> nodes;
+			if (_collect_nodes(root, nodes)) {
+				_capture_defaults(nodes);
+			}
+		}
+		miss_count++;
+	}
+
+	// Whether queue_free() recycles the instance is checked when it's freed.
+	root->data.scene_pool = get_instance_id();
+	return root;
+}
+
+bool ScenePool::release(Node *p_node) {
+	ERR_FAIL_NULL_V(p_node, false);
+	ERR_FAIL_COND_V(scene.is_null(), false);
+
+	p_node->data.scene_pool = ObjectID();
+	if (p_node->get_parent()) {
+		p_node->get_parent()->remove_child(p_node);
+	}
+
+	String scene_path = scene->is_built_in() ? String() : scene->get_path();
+	LocalVector<Node *> nodes;
+	if ((max_size > 0 && (int)available.size() >= max_size) || p_node->get_scene_file_path() != scene_path || !_collect_nodes(p_node, nodes)) {
+		memdelete(p_node);
+		return false;
+	}
+
+	_reset_instance(nodes);
+	p_node->_is_queued_for_deletion = false;
+	_store(p_node, nodes);
+
+	return true;
+}
+
+void ScenePool::prewarm(int p_count) {
+	ERR_FAIL_COND(scene.is_null());
+	if (max_size > 0) {
+		p_count = MIN(p_count, max_size - (int)available.size());
+	}
+	if (p_count <= 0) {
+		return;
+	}
+
+	Vector<Node *> roots = scene->instantiate_batch(p_count);
+	for (int i = 0; i < roots.size(); i++) {
+		LocalVector<Node *> nodes;
+		if (!_collect_nodes(roots[i], nodes)) {
+			memdelete(roots[i]);
+			continue;
+		}
+		if (!defaults_captured) {
+			_capture_defaults(nodes);
+		}
+		_store(roots[i], nodes);
+	}
+}
+
+void ScenePool::clear() {
+	for (uint32_t i = 0; i < available.size(); i++) {
+		memdelete(available[i].root);
+	}
+	available.clear();
+}
+
+int ScenePool::get_available_count() const {
+	return available.size();
+}
+
+uint64_t ScenePool::get_hit_count() const {
+	return hit_count;
+}
+
+uint64_t ScenePool::get_miss_count() const {
+	return miss_count;
+}
+
+bool ScenePool::recycle_queued(Node *p_node) {
+	if (p_node->data.scene_pool.is_null()) {
+		return false;
+	}
+
+	ScenePool *pool = Object::cast_to<ScenePool>(ObjectDB::get_instance(p_node->data.scene_pool));
+	if (!pool || !pool->recycle_on_free) {
+		return false;
+	}
+
+	// release() deletes the node itself when it can't be reused.
+	pool->release(p_node);
+	return true;
+}
+
+void ScenePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_scene", "scene"), &ScenePool::set_scene);
+	ClassDB::bind_method(D_METHOD("get_scene"), &ScenePool::get_scene);
+	ClassDB::bind_method(D_METHOD("set_max_size", "max_size"), &ScenePool::set_max_size);
+	ClassDB::bind_method(D_METHOD("get_max_size"), &ScenePool::get_max_size);
+	ClassDB::bind_method(D_METHOD("set_recycle_on_free", "enable"), &ScenePool::set_recycle_on_free);
+	ClassDB::bind_method(D_METHOD("is_recycle_on_free"), &ScenePool::is_recycle_on_free);
+	ClassDB::bind_method(D_METHOD("set_request_ready_on_acquire", "enable"), &ScenePool::set_request_ready_on_acquire);
+	ClassDB::bind_method(D_METHOD("is_request_ready_on_acquire"), &ScenePool::is_request_ready_on_acquire);
+
+	ClassDB::bind_method(D_METHOD("acquire"), &ScenePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "node"), &ScenePool::release);
+	ClassDB::bind_method(D_METHOD("prewarm", "count"), &ScenePool::prewarm);
+	ClassDB::bind_method(D_METHOD("clear"), &ScenePool::clear);
+	ClassDB::bind_method(D_METHOD("get_available_count"), &ScenePool::get_available_count);
+	ClassDB::bind_method(D_METHOD("get_hit_count"), &ScenePool::get_hit_count);
+	ClassDB::bind_method(D_METHOD("get_miss_count"), &ScenePool::get_miss_count);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "scene", PROPERTY_HINT_RESOURCE_TYPE, "PackedScene"), "set_scene", "get_scene");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_size", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), "set_max_size", "get_max_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "recycle_on_free"), "set_recycle_on_free", "is_recycle_on_free");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "request_ready_on_acquire"), "set_request_ready_on_acquire", "is_request_ready_on_acquire");
+}
+
+ScenePool::~ScenePool() {
+	clear();
+}
@@ -0,0 +1,109 @@
+/*************************************************************************/
+/*  scene_pool.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SCENE_POOL_H
+#define SCENE_POOL_H
+
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "scene/resources/packed_scene.h"
+
+class ScenePool : public RefCounted {
+	GDCLASS(ScenePool, RefCounted);
+
+	struct PropertyDefault {
+		StringName name;
+		Variant value;
+		bool local_to_scene = false; // Value is a pristine copy, duplicated again for every reset.
+	};
+
+	struct Instance {
+		Node *root = nullptr;
+		LocalVector<Node *> nodes; // Indexed like the nodes of the SceneState.
+	};
+
+	Ref<PackedScene> scene;
+	int max_size = 0;
+	bool recycle_on_free = false;
+	bool request_ready_on_acquire = true;
+
+	// Stored properties of every scene node right after instantiation, captured
+	// once from the first instance and used to reset released instances. Script
+	// variables that aren't stored and runtime signal connections aren't reset.
+	LocalVector<LocalVector<PropertyDefault>> defaults;
+	// Paths of every node in a fresh instance, including the ones of nested scenes.
+	HashSet<NodePath> node_paths;
+	bool defaults_captured = false;
+
+	LocalVector<Instance> available;
+
+	uint64_t hit_count = 0;
+	uint64_t miss_count = 0;
+
+	bool _collect_nodes(Node *p_root, LocalVector<Node *> &r_nodes) const;
+	void _capture_node_paths(Node *p_root, Node *p_node);
+	void _capture_defaults(const LocalVector<Node *> &p_nodes);
+	void _free_extra_children(Node *p_root, Node *p_node);
+	void _reset_instance(const LocalVector<Node *> &p_nodes);
+	void _store(Node *p_root, LocalVector<Node *> &p_nodes);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_scene(const Ref<PackedScene> &p_scene);
+	Ref<PackedScene> get_scene() const;
+
+	void set_max_size(int p_max_size);
+	int get_max_size() const;
+
+	void set_recycle_on_free(bool p_enable);
+	bool is_recycle_on_free() const;
+
+	void set_request_ready_on_acquire(bool p_enable);
+	bool is_request_ready_on_acquire() const;
+
+	Node *acquire();
+	bool release(Node *p_node);
+	void prewarm(int p_count);
+	void clear();
+
+	int get_available_count() const;
+	uint64_t get_hit_count() const;
+	uint64_t get_miss_count() const;
+
+	// Called by SceneTree when flushing queue_free(), returns false if the node must be deleted.
+	static bool recycle_queued(Node *p_node);
+
+	~ScenePool();
+};
+
+#endif // SCENE_POOL_H
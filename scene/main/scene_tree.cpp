@@ -38,13 +38,16 @@
 #include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/keyboard.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/sort_array.h"
 #include "node.h"
 #include "scene/animation/tween.h"
 #include "scene/debugger/scene_debugger.h"
 #include "scene/main/multiplayer_api.h"
+#include "scene/main/scene_pool.h"
 #include "scene/main/viewport.h"
 #include "scene/resources/environment.h"
 #include "scene/resources/font.h"
@@ -60,6 +63,10 @@
 #include "servers/physics_server_3d.h"
 #include "window.h"
 
+#ifndef _3D_DISABLED
+#include "scene/3d/node_3d_transform_batch.h"
+#endif // _3D_DISABLED
+
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -139,29 +146,60 @@ void SceneTree::node_renamed(Node *p_node) {
 }
 
 SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_node) {
+	MutexLock lock(group_mutex);
+
 	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
 	if (!E) {
 		E = group_map.insert(p_group, Group());
 	}
 
-	ERR_FAIL_COND_V_MSG(E->value.nodes.has(p_node), &E->value, "Already in group: " + p_group + ".");
+	Node::GroupData *gd = p_node->data.grouped.getptr(p_group);
+	ERR_FAIL_COND_V(!gd, &E->value);
+	ERR_FAIL_COND_V_MSG(gd->index >= 0, &E->value, "Already in group: " + p_group + ".");
+	gd->index = E->value.nodes.size();
 	E->value.nodes.push_back(p_node);
-	//E->value.last_tree_version=0;
 	E->value.changed = true;
 	return &E->value;
 }
 
 void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
+	MutexLock lock(group_mutex);
+
 	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
 	ERR_FAIL_COND(!E);
 
-	E->value.nodes.erase(p_node);
-	if (E->value.nodes.is_empty()) {
+	Group &g = E->value;
+	Node::GroupData *gd = p_node->data.grouped.getptr(p_group);
+	ERR_FAIL_COND(!gd || gd->index < 0 || gd->index >= g.nodes.size() || g.nodes[gd->index] != p_node);
+
+	int index = gd->index;
+	int last = g.nodes.size() - 1;
+	gd->index = -1;
+
+	if (index == last) {
+		g.nodes.resize(last);
+	} else if (g.ordered && !g.changed) {
+		// Keep the tree order, the gap is compacted before the group is iterated again.
+		g.nodes.write[index] = nullptr;
+		g.removed++;
+	} else {
+		Node *moved = g.nodes[last];
+		g.nodes.write[index] = moved;
+		g.nodes.resize(last);
+		if (moved) {
+			_set_group_index(p_group, moved, index);
+		}
+		g.changed = true;
+	}
+
+	if (g.nodes.size() == g.removed) {
 		group_map.remove(E);
 	}
 }
 
 void SceneTree::make_group_changed(const StringName &p_group) {
+	MutexLock lock(group_mutex);
+
 	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
 	if (E) {
 		E->value.changed = true;
@@ -169,6 +207,12 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 }
 
 void SceneTree::flush_transform_notifications() {
+#ifndef _3D_DISABLED
+	if (transform_batch_3d) {
+		transform_batch_3d->flush();
+	}
+#endif
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -199,7 +243,31 @@ void SceneTree::_flush_ugc() {
 	ugc_locked = false;
 }
 
-void SceneTree::_update_group_order(Group &g, bool p_use_priority) {
+void SceneTree::_set_group_index(const StringName &p_group, Node *p_node, int p_index) {
+	p_node->data.grouped.getptr(p_group)->index = p_index;
+}
+
+void SceneTree::_update_group_order(const StringName &p_group, Group &g, bool p_use_priority) {
+	g.ordered = true;
+
+	if (g.removed) {
+		Node **nodes = g.nodes.ptrw();
+		int node_count = g.nodes.size();
+		int count = 0;
+		for (int i = 0; i < node_count; i++) {
+			if (!nodes[i]) {
+				continue;
+			}
+			if (count != i) {
+				nodes[count] = nodes[i];
+				_set_group_index(p_group, nodes[count], count);
+			}
+			count++;
+		}
+		g.nodes.resize(count);
+		g.removed = 0;
+	}
+
 	if (!g.changed) {
 		return;
 	}
@@ -217,6 +285,10 @@ void SceneTree::_update_group_order(Group &g, bool p_use_priority) {
 		SortArray<Node *, Node::Comparator> node_sort;
 		node_sort.sort(nodes, node_count);
 	}
+
+	for (int i = 0; i < node_count; i++) {
+		_set_group_index(p_group, nodes[i], i);
+	}
 	g.changed = false;
 }
 
@@ -250,7 +322,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 		return;
 	}
 
-	_update_group_order(g);
+	_update_group_order(E->key, g);
 
 	Vector<Node *> nodes_copy = g.nodes;
 	Node **nodes = nodes_copy.ptrw();
@@ -303,7 +375,7 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 		return;
 	}
 
-	_update_group_order(g);
+	_update_group_order(E->key, g);
 
 	Vector<Node *> nodes_copy = g.nodes;
 	Node **nodes = nodes_copy.ptrw();
@@ -354,7 +426,7 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 		return;
 	}
 
-	_update_group_order(g);
+	_update_group_order(E->key, g);
 
 	Vector<Node *> nodes_copy = g.nodes;
 	Node **nodes = nodes_copy.ptrw();
@@ -890,7 +962,7 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 		return;
 	}
 
-	_update_group_order(g, p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+	_update_group_order(E->key, g, p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
 
 	//copy, so copy on write happens in case something is removed from process while being called
 	//performance is not lost because only if something is added/removed the vector is copied.
@@ -901,9 +973,119 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 
 	call_lock++;
 
-	for (int i = 0; i < node_count; i++) {
-		Node *n = nodes[i];
-		if (call_lock && call_skip.has(n)) {
+	if (!process_groups.is_empty() && (p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS)) {
+		_notify_process_groups(nodes, node_count, p_notification);
+	} else {
+		for (int i = 0; i < node_count; i++) {
+			Node *n = nodes[i];
+			if (call_lock && call_skip.has(n)) {
+				continue;
+			}
+
+			if (!n->can_process()) {
+				continue;
+			}
+			if (!n->can_process_notification(p_notification)) {
+				continue;
+			}
+
+			n->notification(p_notification);
+			//ERR_FAIL_COND(node_count != g.nodes.size());
+		}
+	}
+
+	call_lock--;
+	if (call_lock == 0) {
+		call_skip.clear();
+	}
+}
+
+bool SceneTree::ProcessGroupSort::operator()(const ProcessGroup *p_left, const ProcessGroup *p_right) const {
+	int left_order = p_left->owner->data.process_thread_group_order;
+	int right_order = p_right->owner->data.process_thread_group_order;
+	return left_order == right_order ? p_right->owner->is_greater_than(p_left->owner) : left_order < right_order;
+}
+
+void SceneTree::_add_process_group(Node *p_owner) {
+	ERR_FAIL_COND(p_owner->data.process_group);
+	ProcessGroup *pg = memnew(ProcessGroup);
+	pg->owner = p_owner;
+	p_owner->data.process_group = pg;
+	process_groups.push_back(pg);
+	process_groups_dirty = true;
+}
+
+void SceneTree::_remove_process_group(Node *p_owner) {
+	ProcessGroup *pg = p_owner->data.process_group;
+	ERR_FAIL_COND(!pg);
+	process_groups.erase(pg);
+	p_owner->data.process_group = nullptr;
+	memdelete(pg);
+}
+
+void SceneTree::_process_group_task(uint32_t p_index, int p_notification) {
+	ProcessGroup *pg = process_groups_active[p_index];
+
+	Node *prev_group = Node::current_process_thread_group;
+	Node::current_process_thread_group = pg->owner;
+
+	for (uint32_t i = 0; i < pg->nodes.size(); i++) {
+		pg->nodes[i]->notification(p_notification);
+	}
+
+	Node::current_process_thread_group = prev_group;
+}
+
+void SceneTree::_notify_process_groups(Node **p_nodes, int p_node_count, int p_notification) {
+	if (process_groups_dirty) {
+		SortArray<ProcessGroup *, ProcessGroupSort> sorter;
+		sorter.sort(process_groups.ptr(), process_groups.size());
+		process_groups_dirty = false;
+	}
+
+	// Split the nodes by thread group, keeping the priority order within each group.
+	for (int i = 0; i < p_node_count; i++) {
+		Node *n = p_nodes[i];
+		Node *owner = n->data.process_thread_group_owner;
+		if (owner && owner->data.process_group) {
+			if (call_skip.has(n) || !n->can_process() || !n->can_process_notification(p_notification)) {
+				continue;
+			}
+			owner->data.process_group->nodes.push_back(n);
+		} else {
+			process_groups_main_nodes.push_back(n);
+		}
+	}
+
+	process_groups_active.clear();
+	for (uint32_t i = 0; i < process_groups.size(); i++) {
+		if (!process_groups[i]->nodes.is_empty()) {
+			process_groups_active.push_back(process_groups[i]);
+		}
+	}
+
+	if (!process_groups_active.is_empty()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_group_task, p_notification, process_groups_active.size(), -1, true, SNAME("ProcessGroups"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	// Take the queued calls out before anything else runs, since main thread nodes
+	// and the calls themselves may add or remove groups.
+	LocalVector<ProcessGroup::DeferredCall> calls;
+	for (uint32_t i = 0; i < process_groups_active.size(); i++) {
+		ProcessGroup *pg = process_groups_active[i];
+		pg->nodes.clear();
+		for (uint32_t j = 0; j < pg->call_queue.size(); j++) {
+			calls.push_back(pg->call_queue[j]);
+		}
+		pg->call_queue.clear();
+	}
+	process_groups_active.clear();
+
+	// Main thread nodes may add or remove nodes as usual, so check them just before processing.
+	for (uint32_t i = 0; i < process_groups_main_nodes.size(); i++) {
+		Node *n = process_groups_main_nodes[i];
+		if (call_skip.has(n)) {
 			continue;
 		}
 
@@ -915,12 +1097,35 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 		}
 
 		n->notification(p_notification);
-		//ERR_FAIL_COND(node_count != g.nodes.size());
 	}
+	process_groups_main_nodes.clear();
 
-	call_lock--;
-	if (call_lock == 0) {
-		call_skip.clear();
+	// Flush in group order, so the result doesn't depend on thread scheduling.
+	for (uint32_t i = 0; i < calls.size(); i++) {
+		const ProcessGroup::DeferredCall &call = calls[i];
+		if (call.callable.is_null()) {
+			Object *obj = ObjectDB::get_instance(call.notification_target);
+			if (obj) {
+				obj->notification(call.notification);
+			}
+			continue;
+		}
+
+		if (!call.callable.is_custom() && !ObjectDB::get_instance(call.callable.get_object_id())) {
+			continue; // The target was freed by an earlier call, skip it like MessageQueue does.
+		}
+
+		const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * call.args.size());
+		for (int j = 0; j < call.args.size(); j++) {
+			argptrs[j] = &call.args[j];
+		}
+
+		Callable::CallError ce;
+		Variant ret;
+		call.callable.callp(argptrs, call.args.size(), ret, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling deferred thread group method: " + Variant::get_callable_error_text(call.callable, argptrs, call.args.size(), ce) + ".");
+		}
 	}
 }
 
@@ -934,7 +1139,7 @@ void SceneTree::_call_input_pause(const StringName &p_group, CallInputType p_cal
 		return;
 	}
 
-	_update_group_order(g);
+	_update_group_order(E->key, g);
 
 	//copy, so copy on write happens in case something is removed from process while being called
 	//performance is not lost because only if something is added/removed the vector is copied.
@@ -1020,7 +1225,7 @@ TypedArray<Node> SceneTree::_get_nodes_in_group(const StringName &p_group) {
 		return ret;
 	}
 
-	_update_group_order(E->value); //update order just in case
+	_update_group_order(E->key, E->value); //update order just in case
 	int nc = E->value.nodes.size();
 	if (nc == 0) {
 		return ret;
@@ -1046,7 +1251,7 @@ Node *SceneTree::get_first_node_in_group(const StringName &p_group) {
 		return nullptr; // No group.
 	}
 
-	_update_group_order(E->value); // Update order just in case.
+	_update_group_order(E->key, E->value); // Update order just in case.
 
 	if (E->value.nodes.is_empty()) {
 		return nullptr;
@@ -1061,7 +1266,7 @@ void SceneTree::get_nodes_in_group(const StringName &p_group, List<Node *> *p_li
 		return;
 	}
 
-	_update_group_order(E->value); //update order just in case
+	_update_group_order(E->key, E->value); //update order just in case
 	int nc = E->value.nodes.size();
 	if (nc == 0) {
 		return;
@@ -1078,7 +1283,10 @@ void SceneTree::_flush_delete_queue() {
 	while (delete_queue.size()) {
 		Object *obj = ObjectDB::get_instance(delete_queue.front()->get());
 		if (obj) {
-			memdelete(obj);
+			Node *node = Object::cast_to<Node>(obj);
+			if (!node || !ScenePool::recycle_queued(node)) {
+				memdelete(obj);
+			}
 		}
 		delete_queue.pop_front();
 	}
@@ -1413,6 +1621,13 @@ SceneTree::SceneTree() {
 
 	Math::randomize();
 
+#ifndef _3D_DISABLED
+	// Must exist before any Node3D enters the tree.
+	if (GLOBAL_DEF("application/run/batch_3d_transforms", false) && !Engine::get_singleton()->is_editor_hint()) {
+		transform_batch_3d = memnew(Node3DTransformBatch);
+	}
+#endif // _3D_DISABLED
+
 	// Create with mainloop.
 
 	root = memnew(Window);
@@ -1567,6 +1782,12 @@ SceneTree::~SceneTree() {
 		memdelete(root);
 	}
 
+#ifndef _3D_DISABLED
+	if (transform_batch_3d) {
+		memdelete(transform_batch_3d);
+	}
+#endif
+
 	if (singleton == this) {
 		singleton = nullptr;
 	}
@@ -33,6 +33,7 @@
 
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/self_list.h"
 #include "scene/resources/mesh.h"
 
@@ -44,6 +45,7 @@ class Window;
 class Material;
 class Mesh;
 class MultiplayerAPI;
+class Node3DTransformBatch;
 class SceneDebugger;
 class Tween;
 class Viewport;
@@ -86,9 +88,35 @@ public:
 	typedef void (*IdleCallback)();
 
 private:
+	// Nodes are stored densely and know their own index (Node::GroupData::index), so
+	// adding and removing is O(1). The tree order is only maintained once the group
+	// has been iterated: removals then leave gaps that are compacted lazily instead
+	// of breaking the order, which would require sorting the group again.
 	struct Group {
 		Vector<Node *> nodes;
-		bool changed = false;
+		int removed = 0; // Null entries left in nodes by removals.
+		bool changed = false; // Needs sorting.
+		bool ordered = false; // Iterated in tree order at least once.
+	};
+
+	// A subtree whose nodes are processed on a worker thread, concurrently with the
+	// other sub-thread groups. Deferred calls made while it's processed are queued
+	// here and flushed on the main thread once every group is done.
+	struct ProcessGroup {
+		struct DeferredCall {
+			Callable callable;
+			Vector<Variant> args;
+			ObjectID notification_target; // Set instead of the callable for notifications.
+			int notification = 0;
+		};
+
+		Node *owner = nullptr;
+		LocalVector<Node *> nodes;
+		LocalVector<DeferredCall> call_queue;
+	};
+
+	struct ProcessGroupSort {
+		bool operator()(const ProcessGroup *p_left, const ProcessGroup *p_right) const;
 	};
 
 	Window *root = nullptr;
@@ -108,6 +136,7 @@ private:
 	int root_lock = 0;
 
 	HashMap<StringName, Group> group_map;
+	Mutex group_mutex; // Nodes in sub-thread process groups may join or leave groups concurrently.
 	bool _quit = false;
 	bool initialized = false;
 
@@ -143,7 +172,18 @@ private:
 	bool ugc_locked = false;
 	void _flush_ugc();
 
-	_FORCE_INLINE_ void _update_group_order(Group &g, bool p_use_priority = false);
+	_FORCE_INLINE_ void _set_group_index(const StringName &p_group, Node *p_node, int p_index);
+	_FORCE_INLINE_ void _update_group_order(const StringName &p_group, Group &g, bool p_use_priority = false);
+
+	LocalVector<ProcessGroup *> process_groups;
+	LocalVector<ProcessGroup *> process_groups_active;
+	LocalVector<Node *> process_groups_main_nodes;
+	bool process_groups_dirty = false;
+
+	void _add_process_group(Node *p_owner);
+	void _remove_process_group(Node *p_owner);
+	void _process_group_task(uint32_t p_index, int p_notification);
+	void _notify_process_groups(Node **p_nodes, int p_node_count, int p_notification);
 
 	TypedArray<Node> _get_nodes_in_group(const StringName &p_group);
 
@@ -198,6 +238,11 @@ private:
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	Mutex xform_change_mutex; // Nodes in sub-thread process groups queue transform changes concurrently.
+
+#ifndef _3D_DISABLED
+	Node3DTransformBatch *transform_batch_3d = nullptr;
+#endif
 
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
@@ -275,6 +320,12 @@ public:
 
 	void flush_transform_notifications();
 
+#ifndef _3D_DISABLED
+	Node3DTransformBatch *get_transform_batch_3d() const { return transform_batch_3d; }
+#else
+	Node3DTransformBatch *get_transform_batch_3d() const { return nullptr; }
+#endif
+
 	virtual void initialize() override;
 
 	virtual bool physics_process(double p_time) override;
@@ -294,6 +294,31 @@ Vector3 NavigationMesh::get_filter_baking_aabb_offset() const {
 	return filter_baking_aabb_offset;
 }
 
+void NavigationMesh::set_tile_size(int p_value) {
+	ERR_FAIL_COND(p_value < 0);
+	tile_size = p_value;
+	baked_tiles.clear();
+}
+
+int NavigationMesh::get_tile_size() const {
+	return tile_size;
+}
+
+void NavigationMesh::set_baked_tiles(const HashMap<Vector2i, BakedTile> &p_tiles) {
+	baked_tiles = p_tiles;
+}
+
+const HashMap<Vector2i, NavigationMesh::BakedTile> &NavigationMesh::get_baked_tiles() const {
+	return baked_tiles;
+}
+
+Ref<Resource> NavigationMesh::duplicate(bool p_subresources) const {
+	Ref<NavigationMesh> copy = Resource::duplicate(p_subresources);
+	// The baked tiles aren't a property, but the copy must be able to rebake only some of them.
+	copy->baked_tiles = baked_tiles;
+	return copy;
+}
+
 void NavigationMesh::set_vertices(const Vector<Vector3> &p_vertices) {
 	vertices = p_vertices;
 	notify_property_list_changed();
@@ -593,6 +618,9 @@ void NavigationMesh::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_filter_baking_aabb_offset", "baking_aabb_offset"), &NavigationMesh::set_filter_baking_aabb_offset);
 	ClassDB::bind_method(D_METHOD("get_filter_baking_aabb_offset"), &NavigationMesh::get_filter_baking_aabb_offset);
 
+	ClassDB::bind_method(D_METHOD("set_tile_size", "tile_size"), &NavigationMesh::set_tile_size);
+	ClassDB::bind_method(D_METHOD("get_tile_size"), &NavigationMesh::get_tile_size);
+
 	ClassDB::bind_method(D_METHOD("set_vertices", "vertices"), &NavigationMesh::set_vertices);
 	ClassDB::bind_method(D_METHOD("get_vertices"), &NavigationMesh::get_vertices);
 
@@ -643,6 +671,8 @@ void NavigationMesh::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "filter_walkable_low_height_spans"), "set_filter_walkable_low_height_spans", "get_filter_walkable_low_height_spans");
 	ADD_PROPERTY(PropertyInfo(Variant::AABB, "filter_baking_aabb"), "set_filter_baking_aabb", "get_filter_baking_aabb");
 	ADD_PROPERTY(PropertyInfo(Variant::VECTOR3, "filter_baking_aabb_offset"), "set_filter_baking_aabb_offset", "get_filter_baking_aabb_offset");
+	ADD_GROUP("Tiles", "tile_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "tile_size", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), "set_tile_size", "get_tile_size");
 
 	BIND_ENUM_CONSTANT(SAMPLE_PARTITION_WATERSHED);
 	BIND_ENUM_CONSTANT(SAMPLE_PARTITION_MONOTONE);
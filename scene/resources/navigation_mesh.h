@@ -68,6 +68,16 @@ protected:
 	void _set_polygons(const Array &p_array);
 	Array _get_polygons() const;
 
+public:
+	// Result of the bake of a tile, kept to only rebake the tiles that change.
+	struct BakedTile {
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+private:
+	HashMap<Vector2i, BakedTile> baked_tiles;
+
 public:
 	enum SamplePartitionType {
 		SAMPLE_PARTITION_WATERSHED = 0,
@@ -104,6 +114,7 @@ protected:
 	float verts_per_poly = 6.0f;
 	float detail_sample_distance = 6.0f;
 	float detail_sample_max_error = 1.0f;
+	int tile_size = 0;
 
 	SamplePartitionType partition_type = SAMPLE_PARTITION_WATERSHED;
 	ParsedGeometryType parsed_geometry_type = PARSED_GEOMETRY_MESH_INSTANCES;
@@ -192,6 +203,12 @@ public:
 	void set_filter_baking_aabb_offset(const Vector3 &p_aabb_offset);
 	Vector3 get_filter_baking_aabb_offset() const;
 
+	void set_tile_size(int p_value);
+	int get_tile_size() const;
+
+	void set_baked_tiles(const HashMap<Vector2i, BakedTile> &p_tiles);
+	const HashMap<Vector2i, BakedTile> &get_baked_tiles() const;
+
 	void create_from_mesh(const Ref<Mesh> &p_mesh);
 
 	void set_vertices(const Vector<Vector3> &p_vertices);
@@ -202,6 +219,8 @@ public:
 	Vector<int> get_polygon(int p_idx);
 	void clear_polygons();
 
+	virtual Ref<Resource> duplicate(bool p_subresources = false) const override;
+
 #ifndef DISABLE_DEPRECATED
 	Ref<Mesh> get_debug_mesh();
 #endif // DISABLE_DEPRECATED
@@ -471,6 +471,244 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+bool SceneState::_compile_batch_program(BatchProgram &r_program) const {
+	// Only plain scenes are compiled: instances, inheritance, paths to nodes outside
+	// the scene and missing classes or resources go through instantiate() instead.
+	if (base_scene_idx >= 0 || !editable_instances.is_empty() || Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+
+	int nc = nodes.size();
+	int sname_count = names.size();
+	int prop_count = variants.size();
+	r_program.nodes.resize(nc);
+
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+		BatchProgram::NodeOp &op = r_program.nodes[i];
+
+		if (n.instance >= 0 || n.type == TYPE_INSTANCED || (n.parent >= 0 && (n.parent & FLAG_ID_IS_PATH)) || (n.owner >= 0 && (n.owner & FLAG_ID_IS_PATH))) {
+			return false;
+		}
+		ERR_FAIL_INDEX_V(n.type, sname_count, false);
+		ERR_FAIL_INDEX_V(n.name, sname_count, false);
+
+		const StringName &type = names[n.type];
+		ClassDB::ClassInfo *ti = nullptr;
+		{
+			RWLockRead read_lock(ClassDB::lock);
+			ti = ClassDB::classes.getptr(type);
+			if (!ti || ti->disabled || !ti->creation_func || ti->native_extension || ti->api == ClassDB::API_EDITOR) {
+				return false;
+			}
+		}
+		if (!ClassDB::is_parent_class(type, SNAME("Node"))) {
+			return false;
+		}
+
+		op.create = ti->creation_func;
+		op.parent = i > 0 ? n.parent : -1;
+		op.owner = n.owner;
+		op.name = n.name;
+		op.index = n.index;
+		ERR_FAIL_COND_V(i > 0 && (op.parent < 0 || op.parent >= i), false);
+		ERR_FAIL_COND_V(op.owner >= nc, false);
+
+		op.properties.resize(n.properties.size());
+		for (int j = 0; j < n.properties.size(); j++) {
+			const NodeData::Property &np = n.properties[j];
+			BatchProgram::Property &prop = op.properties[j];
+			ERR_FAIL_INDEX_V(np.value, prop_count, false);
+			prop.value = np.value;
+
+			if (np.name & FLAG_PATH_PROPERTY_IS_NODE) {
+				prop.name = np.name & FLAG_PROP_NAME_MASK;
+				prop.node_path = true;
+				ERR_FAIL_INDEX_V(prop.name, sname_count, false);
+				continue;
+			}
+
+			ERR_FAIL_INDEX_V(np.name, sname_count, false);
+			prop.name = np.name;
+
+			const Variant &value = variants[np.value];
+			if (value.get_type() == Variant::OBJECT) {
+				Ref<Resource> res = value;
+				if (res.is_valid()) {
+					if (Object::cast_to<MissingResource>(res.ptr())) {
+						return false;
+					}
+					prop.local_to_scene = res->is_local_to_scene();
+				}
+			}
+
+			// Same lookup as ClassDB::set_property(), done once for all copies.
+			RWLockRead read_lock(ClassDB::lock);
+			ClassDB::ClassInfo *check = ti;
+			while (check) {
+				const ClassDB::PropertySetGet *psg = check->property_setget.getptr(names[np.name]);
+				if (psg) {
+					prop.setter = psg->_setptr;
+					prop.setter_index = psg->index;
+					break;
+				}
+				check = check->inherits_ptr;
+			}
+		}
+
+		op.groups.resize(n.groups.size());
+		for (int j = 0; j < n.groups.size(); j++) {
+			ERR_FAIL_INDEX_V(n.groups[j], sname_count, false);
+			op.groups[j] = n.groups[j];
+		}
+	}
+
+	for (int i = 0; i < connections.size(); i++) {
+		const ConnectionData &c = connections[i];
+		if ((c.from & FLAG_ID_IS_PATH) || (c.to & FLAG_ID_IS_PATH)) {
+			return false;
+		}
+		ERR_FAIL_INDEX_V(c.from, nc, false);
+		ERR_FAIL_INDEX_V(c.to, nc, false);
+	}
+
+	return true;
+}
+
+Node *SceneState::_instantiate_from_program(const BatchProgram &p_program) const {
+	int nc = p_program.nodes.size();
+	const StringName *snames = names.ptr();
+	const Variant *props = variants.ptr();
+
+	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
+	HashMap<Ref<Resource>, Ref<Resource>> resources_local_to_scene;
+	LocalVector<DeferredNodePathProperties> deferred_node_paths;
+
+	for (int i = 0; i < nc; i++) {
+		const BatchProgram::NodeOp &op = p_program.nodes[i];
+		Node *node = static_cast<Node *>(op.create());
+
+		for (uint32_t j = 0; j < op.properties.size(); j++) {
+			const BatchProgram::Property &prop = op.properties[j];
+
+			if (prop.node_path) {
+				DeferredNodePathProperties dnp;
+				dnp.path = props[prop.value];
+				dnp.base = node;
+				dnp.property = snames[prop.name];
+				deferred_node_paths.push_back(dnp);
+				continue;
+			}
+
+			const Variant *value = &props[prop.value];
+			Variant local_value;
+			if (prop.local_to_scene) {
+				Ref<Resource> res = *value;
+				HashMap<Ref<Resource>, Ref<Resource>>::Iterator E = resources_local_to_scene.find(res);
+				if (E) {
+					local_value = E->value;
+				} else {
+					Ref<Resource> local_dupe = res->duplicate_for_local_scene(i == 0 ? node : ret_nodes[0], resources_local_to_scene);
+					resources_local_to_scene[res] = local_dupe;
+					local_value = local_dupe;
+				}
+				value = &local_value;
+			}
+
+			// A script may override any property, so once it's set use the regular path.
+			if (prop.setter && !node->get_script_instance()) {
+				Callable::CallError ce;
+				if (prop.setter_index >= 0) {
+					Variant index = prop.setter_index;
+					const Variant *args[2] = { &index, value };
+					prop.setter->call(node, args, 2, ce);
+				} else {
+					const Variant *args[1] = { value };
+					prop.setter->call(node, args, 1, ce);
+				}
+			} else {
+				node->set(snames[prop.name], *value);
+			}
+		}
+
+		for (uint32_t j = 0; j < op.groups.size(); j++) {
+			node->add_to_group(snames[op.groups[j]], true);
+		}
+
+		if (i > 0) {
+			Node *parent = ret_nodes[op.parent];
+			parent->_add_child_nocheck(node, snames[op.name]);
+			if (op.index >= 0 && op.index < parent->get_child_count() - 1) {
+				parent->move_child(node, op.index);
+			}
+		} else {
+			node->_set_name_nocheck(snames[op.name]);
+		}
+
+		if (op.owner >= 0) {
+			node->_set_owner_nocheck(ret_nodes[op.owner]);
+			if (node->data.unique_name_in_owner) {
+				node->_acquire_unique_name_in_owner();
+			}
+		}
+
+		node->remove_meta("_edit_pinned_properties_");
+
+		ret_nodes[i] = node;
+	}
+
+	for (uint32_t i = 0; i < deferred_node_paths.size(); i++) {
+		const DeferredNodePathProperties &dnp = deferred_node_paths[i];
+		Node *other = dnp.base->get_node_or_null(dnp.path);
+		dnp.base->set(dnp.property, other);
+	}
+
+	for (KeyValue<Ref<Resource>, Ref<Resource>> &E : resources_local_to_scene) {
+		if (E.value->get_local_scene() == ret_nodes[0]) {
+			E.value->setup_local_to_scene();
+		}
+	}
+
+	for (int i = 0; i < connections.size(); i++) {
+		const ConnectionData &c = connections[i];
+
+		Callable callable(ret_nodes[c.to], snames[c.method]);
+		if (c.unbinds > 0) {
+			callable = callable.unbind(c.unbinds);
+		} else if (!c.binds.is_empty()) {
+			const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * c.binds.size());
+			for (int j = 0; j < c.binds.size(); j++) {
+				argptrs[j] = &props[c.binds[j]];
+			}
+			callable = callable.bindp(argptrs, c.binds.size());
+		}
+
+		ret_nodes[c.from]->connect(snames[c.signal], callable, CONNECT_PERSIST | c.flags);
+	}
+
+	return ret_nodes[0];
+}
+
+Error SceneState::instantiate_batch(int p_count, Node **r_nodes) const {
+	ERR_FAIL_COND_V(p_count < 0, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(nodes.is_empty(), ERR_UNCONFIGURED);
+
+	// Not run on threads: node constructors and property setters may call into the
+	// servers or update global state.
+	BatchProgram program;
+	bool compiled = _compile_batch_program(program);
+
+	Error err = OK;
+	for (int i = 0; i < p_count; i++) {
+		r_nodes[i] = compiled ? _instantiate_from_program(program) : instantiate(GEN_EDIT_STATE_DISABLED);
+		if (!r_nodes[i]) {
+			err = FAILED;
+		}
+	}
+
+	return err;
+}
+
 static int _nm_get_string(const String &p_string, HashMap<StringName, int> &name_map) {
 	if (name_map.has(p_string)) {
 		return name_map[p_string];
@@ -1760,6 +1998,43 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	return s;
 }
 
+Vector<Node *> PackedScene::instantiate_batch(int p_count) const {
+	Vector<Node *> nodes;
+	ERR_FAIL_COND_V(p_count < 0, nodes);
+	nodes.resize(p_count);
+	Node **ptrw = nodes.ptrw();
+
+	Error err = state->instantiate_batch(p_count, ptrw);
+	if (err != OK) {
+		for (int i = 0; i < p_count; i++) {
+			if (ptrw[i]) {
+				memdelete(ptrw[i]);
+			}
+		}
+		ERR_FAIL_V_MSG(Vector<Node *>(), "Failed to instantiate scene copies.");
+	}
+
+	String path = is_built_in() ? String() : get_path();
+	for (int i = 0; i < p_count; i++) {
+		if (!path.is_empty()) {
+			ptrw[i]->set_scene_file_path(path);
+		}
+		ptrw[i]->notification(Node::NOTIFICATION_SCENE_INSTANTIATED);
+	}
+
+	return nodes;
+}
+
+TypedArray<Node> PackedScene::_instantiate_batch(int p_count) const {
+	Vector<Node *> nodes = instantiate_batch(p_count);
+	TypedArray<Node> ret;
+	ret.resize(nodes.size());
+	for (int i = 0; i < nodes.size(); i++) {
+		ret[i] = nodes[i];
+	}
+	return ret;
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
 	state = p_by;
 	state->set_path(get_path());
@@ -1791,6 +2066,7 @@ void PackedScene::reset_state() {
 void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instantiate", "edit_state"), &PackedScene::instantiate, DEFVAL(GEN_EDIT_STATE_DISABLED));
+	ClassDB::bind_method(D_METHOD("instantiate_batch", "count"), &PackedScene::_instantiate_batch);
 	ClassDB::bind_method(D_METHOD("can_instantiate"), &PackedScene::can_instantiate);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene", "scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
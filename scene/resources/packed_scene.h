@@ -32,6 +32,7 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -89,6 +90,31 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Flat construction program used by instantiate_batch(). Class creation functions
+	// and property setters are resolved once, then replayed for every copy.
+	struct BatchProgram {
+		struct Property {
+			int name = 0;
+			int value = 0;
+			MethodBind *setter = nullptr; // Bound class setter, if any.
+			int setter_index = -1;
+			bool local_to_scene = false;
+			bool node_path = false; // Deferred NodePath -> Node property.
+		};
+
+		struct NodeOp {
+			Object *(*create)() = nullptr;
+			int parent = -1;
+			int owner = -1;
+			int name = 0;
+			int index = -1;
+			LocalVector<Property> properties;
+			LocalVector<int> groups;
+		};
+
+		LocalVector<NodeOp> nodes;
+	};
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -102,6 +128,9 @@ class SceneState : public RefCounted {
 
 	int _find_base_scene_node_remap_key(int p_idx) const;
 
+	bool _compile_batch_program(BatchProgram &r_program) const;
+	Node *_instantiate_from_program(const BatchProgram &p_program) const;
+
 protected:
 	static void _bind_methods();
 
@@ -146,6 +175,7 @@ public:
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state) const;
+	Error instantiate_batch(int p_count, Node **r_nodes) const;
 
 	Ref<SceneState> get_base_scene_state() const;
 
@@ -211,6 +241,7 @@ class PackedScene : public Resource {
 
 	void _set_bundled_scene(const Dictionary &p_scene);
 	Dictionary _get_bundled_scene() const;
+	TypedArray<Node> _instantiate_batch(int p_count) const;
 
 protected:
 	virtual bool editor_can_reload_from_file() override { return false; } // this is handled by editor better
@@ -231,6 +262,7 @@ public:
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
+	Vector<Node *> instantiate_batch(int p_count) const;
 
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
@@ -154,6 +154,7 @@ World3D::World3D() {
 	NavigationServer3D::get_singleton()->map_set_cell_size(navigation_map, GLOBAL_DEF("navigation/3d/default_cell_size", 0.25));
 	NavigationServer3D::get_singleton()->map_set_edge_connection_margin(navigation_map, GLOBAL_DEF("navigation/3d/default_edge_connection_margin", 0.25));
 	NavigationServer3D::get_singleton()->map_set_link_connection_radius(navigation_map, GLOBAL_DEF("navigation/3d/default_link_connection_radius", 1.0));
+	NavigationServer3D::get_singleton()->map_set_cluster_size(navigation_map, GLOBAL_DEF("navigation/3d/default_cluster_size", 0.0));
 }
 
 World3D::~World3D() {
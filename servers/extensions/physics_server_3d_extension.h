@@ -130,6 +130,8 @@ protected:
 
 	GDVIRTUAL8R(bool, _intersect_ray, const Vector3 &, const Vector3 &, uint32_t, bool, bool, bool, bool, GDNativePtr<PhysicsServer3DExtensionRayResult>)
 	GDVIRTUAL6R(int, _intersect_point, const Vector3 &, uint32_t, bool, bool, GDNativePtr<PhysicsServer3DExtensionShapeResult>, int)
+	GDVIRTUAL10(_intersect_rays, GDNativeConstPtr<const Vector3>, GDNativeConstPtr<const Vector3>, int, uint32_t, bool, bool, bool, bool, GDNativePtr<PhysicsServer3DExtensionRayResult>, GDNativePtr<bool>)
+	GDVIRTUAL7(_intersect_points, GDNativeConstPtr<const Vector3>, int, uint32_t, bool, bool, GDNativePtr<PhysicsServer3DExtensionShapeResult>, GDNativePtr<bool>)
 	GDVIRTUAL9R(int, _intersect_shape, RID, const Transform3D &, const Vector3 &, real_t, uint32_t, bool, bool, GDNativePtr<PhysicsServer3DExtensionShapeResult>, int)
 	GDVIRTUAL10R(bool, _cast_motion, RID, const Transform3D &, const Vector3 &, real_t, uint32_t, bool, bool, GDNativePtr<real_t>, GDNativePtr<real_t>, GDNativePtr<PhysicsServer3DExtensionShapeRestInfo>)
 	GDVIRTUAL10R(bool, _collide_shape, RID, const Transform3D &, const Vector3 &, real_t, uint32_t, bool, bool, GDNativePtr<Vector3>, int, GDNativePtr<int>)
@@ -151,6 +153,23 @@ public:
 		exclude = nullptr;
 		return ret;
 	}
+	// The batched queries are optional, by default they go through _intersect_ray() and _intersect_point().
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) override {
+		exclude = &p_parameters.exclude;
+		bool called = GDVIRTUAL_CALL(_intersect_rays, p_from, p_to, p_count, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.hit_from_inside, p_parameters.hit_back_faces, r_results, r_hits);
+		exclude = nullptr;
+		if (!called) {
+			PhysicsDirectSpaceState3D::intersect_rays(p_parameters, p_from, p_to, p_count, r_results, r_hits);
+		}
+	}
+	virtual void intersect_points(const PointParameters &p_parameters, const Vector3 *p_positions, int p_count, ShapeResult *r_results, bool *r_hits) override {
+		exclude = &p_parameters.exclude;
+		bool called = GDVIRTUAL_CALL(_intersect_points, p_positions, p_count, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, r_results, r_hits);
+		exclude = nullptr;
+		if (!called) {
+			PhysicsDirectSpaceState3D::intersect_points(p_parameters, p_positions, p_count, r_results, r_hits);
+		}
+	}
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override {
 		exclude = &p_parameters.exclude;
 		int ret = 0;
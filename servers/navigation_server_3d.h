@@ -91,9 +91,21 @@ public:
 	/// Returns the link connection radius of this map.
 	virtual real_t map_get_link_connection_radius(RID p_map) const = 0;
 
+	/// Set the size of the map clusters used to speed up long path queries, 0 disables them.
+	virtual void map_set_cluster_size(RID p_map, real_t p_cluster_size) const = 0;
+
+	/// Returns the cluster size of this map.
+	virtual real_t map_get_cluster_size(RID p_map) const = 0;
+
+	/// Set the callback receiving the new velocity of all the agents of this map at once.
+	virtual void map_set_avoidance_callback(RID p_map, Callable p_callback) const = 0;
+
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const = 0;
 
+	/// Returns the navigation paths between each origin and its destination, computed in parallel.
+	virtual TypedArray<PackedVector3Array> map_get_paths(RID p_map, const Vector<Vector3> &p_origins, const Vector<Vector3> &p_destinations, bool p_optimize, uint32_t p_navigation_layers = 1) const = 0;
+
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const = 0;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const = 0;
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const = 0;
@@ -135,6 +147,9 @@ public:
 	/// Bake the navigation mesh.
 	virtual void region_bake_navmesh(Ref<NavigationMesh> r_mesh, Node *p_node) const = 0;
 
+	/// Rebake the tiles of the navigation mesh touched by the changed areas.
+	virtual void region_bake_navmesh_tiles(Ref<NavigationMesh> r_mesh, Node *p_node, const TypedArray<AABB> &p_changed_aabbs) const = 0;
+
 	/// Get a list of a region's connection to other regions.
 	virtual int region_get_connections_count(RID p_region) const = 0;
 	virtual Vector3 region_get_connection_pathway_start(RID p_region, int p_connection_id) const = 0;
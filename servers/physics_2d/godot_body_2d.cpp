@@ -604,7 +604,8 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector2();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_compute_shape_aabbs_with_motion(motion);
+		shapes_update_pending = true;
 	}
 
 	contact_count = 0;
@@ -615,15 +616,13 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 		return;
 	}
 
-	if (fi_callback_data || body_state_callback) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
+	state_query_pending = fi_callback_data || body_state_callback;
 
 	if (mode == PhysicsServer2D::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.size() == 0 && linear_velocity == Vector2() && angular_velocity == 0) {
-			set_active(false); //stopped moving, deactivate
+			deactivate_pending = true; //stopped moving, deactivate
 		}
 		return;
 	}
@@ -640,16 +639,36 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 		pos += center_of_mass - center_of_mass.rotated(angle_delta);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	_set_transform(Transform2D(angle, pos), false);
 	_set_inv_transform(get_transform().inverse());
 
-	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
+	if (continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED) {
+		_compute_shape_aabbs();
+		shapes_update_pending = true;
+	} else {
 		new_transform = get_transform();
 	}
 
 	_update_transform_dependent();
 }
 
+void GodotBody2D::commit_integration() {
+	if (shapes_update_pending) {
+		_commit_shape_aabbs();
+		shapes_update_pending = false;
+	}
+
+	if (state_query_pending) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		state_query_pending = false;
+	}
+
+	if (deactivate_pending) {
+		set_active(false);
+		deactivate_pending = false;
+	}
+}
+
 void GodotBody2D::wakeup_neighbours() {
 	for (const Pair<GodotConstraint2D *, int> &E : constraint_list) {
 		const GodotConstraint2D *c = E.first;
@@ -100,6 +100,10 @@ class GodotBody2D : public GodotCollisionObject2D {
 	PhysicsServer2D::CCDMode continuous_cd_mode = PhysicsServer2D::CCD_MODE_DISABLED;
 	bool omit_force_integration = false;
 	bool active = true;
+	// Work left by the integration functions, which can run on threads, done by commit_integration().
+	bool shapes_update_pending = false;
+	bool state_query_pending = false;
+	bool deactivate_pending = false;
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
 	void _mass_properties_changed();
@@ -112,7 +116,13 @@ class GodotBody2D : public GodotCollisionObject2D {
 		GodotArea2D *area = nullptr;
 		int refCount = 0;
 		_FORCE_INLINE_ bool operator==(const AreaCMP &p_cmp) const { return area->get_self() == p_cmp.area->get_self(); }
-		_FORCE_INLINE_ bool operator<(const AreaCMP &p_cmp) const { return area->get_priority() < p_cmp.area->get_priority(); }
+		_FORCE_INLINE_ bool operator<(const AreaCMP &p_cmp) const {
+			// Areas with the same priority are ordered by creation, to be deterministic.
+			if (area->get_priority() == p_cmp.area->get_priority()) {
+				return area->get_self() < p_cmp.area->get_self();
+			}
+			return area->get_priority() < p_cmp.area->get_priority();
+		}
 		_FORCE_INLINE_ AreaCMP() {}
 		_FORCE_INLINE_ AreaCMP(GodotArea2D *p_area) {
 			area = p_area;
@@ -314,8 +324,11 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// Integration only touches the body itself, so bodies can be integrated in parallel.
+	// commit_integration() must be called afterwards, serially, to update the space.
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void commit_integration();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
@@ -89,6 +89,8 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
 public:
+	virtual OrderKey get_order_key() const override { return OrderKey(A->get_self(), B->get_self(), shape_A, shape_B); }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
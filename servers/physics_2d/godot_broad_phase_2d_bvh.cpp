@@ -73,12 +73,28 @@ int GodotBroadPhase2DBVH::get_subindex(ID p_id) const {
 	return bvh.get_subindex(p_id - 1);
 }
 
-int GodotBroadPhase2DBVH::cull_segment(const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices) {
-	return bvh.cull_segment(p_from, p_to, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
+int GodotBroadPhase2DBVH::cull_segment(const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices, CullBuffer *r_buffer) {
+	return bvh.cull_segment(p_from, p_to, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices, r_buffer);
 }
 
-int GodotBroadPhase2DBVH::cull_aabb(const Rect2 &p_aabb, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices) {
-	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
+int GodotBroadPhase2DBVH::cull_aabb(const Rect2 &p_aabb, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices, CullBuffer *r_buffer) {
+	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices, r_buffer);
+}
+
+void GodotBroadPhase2DBVH::lock_queries() {
+	bvh.cull_lock();
+}
+
+void GodotBroadPhase2DBVH::unlock_queries() {
+	bvh.cull_unlock();
+}
+
+int GodotBroadPhase2DBVH::cull_segment_unlocked(const Vector2 &p_from, const Vector2 &p_to, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices, CullBuffer *r_buffer) {
+	return bvh.cull_segment_unlocked(p_from, p_to, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices, r_buffer);
+}
+
+int GodotBroadPhase2DBVH::cull_aabb_unlocked(const Rect2 &p_aabb, GodotCollisionObject2D **p_results, int p_max_results, int *p_result_indices, CullBuffer *r_buffer) {
+	return bvh.cull_aabb_unlocked(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices, r_buffer);
 }
 
 void *GodotBroadPhase2DBVH::_pair_callback(void *self, uint32_t p_A, GodotCollisionObject2D *p_object_A, int subindex_A, uint32_t p_B, GodotCollisionObject2D *p_object_B, int subindex_B) {
@@ -162,6 +162,20 @@ void GodotCollisionObject2D::_update_shapes() {
 		return;
 	}
 
+	_compute_shape_aabbs();
+	_commit_shape_aabbs();
+}
+
+void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion) {
+	if (!space) {
+		return;
+	}
+
+	_compute_shape_aabbs_with_motion(p_motion);
+	_commit_shape_aabbs();
+}
+
+void GodotCollisionObject2D::_compute_shape_aabbs() {
 	for (int i = 0; i < shapes.size(); i++) {
 		Shape &s = shapes.write[i];
 		if (s.disabled) {
@@ -174,21 +188,10 @@ void GodotCollisionObject2D::_update_shapes() {
 		shape_aabb = xform.xform(shape_aabb);
 		shape_aabb.grow_by((s.aabb_cache.size.x + s.aabb_cache.size.y) * 0.5 * 0.05);
 		s.aabb_cache = shape_aabb;
-
-		if (s.bpid == 0) {
-			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
-			space->get_broadphase()->set_static(s.bpid, _static);
-		}
-
-		space->get_broadphase()->move(s.bpid, shape_aabb);
 	}
 }
 
-void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion) {
-	if (!space) {
-		return;
-	}
-
+void GodotCollisionObject2D::_compute_shape_aabbs_with_motion(const Vector2 &p_motion) {
 	for (int i = 0; i < shapes.size(); i++) {
 		Shape &s = shapes.write[i];
 		if (s.disabled) {
@@ -201,13 +204,26 @@ void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion)
 		shape_aabb = xform.xform(shape_aabb);
 		shape_aabb = shape_aabb.merge(Rect2(shape_aabb.position + p_motion, shape_aabb.size)); //use motion
 		s.aabb_cache = shape_aabb;
+	}
+}
+
+void GodotCollisionObject2D::_commit_shape_aabbs() {
+	if (!space) {
+		return;
+	}
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		if (s.disabled) {
+			continue;
+		}
 
 		if (s.bpid == 0) {
-			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
+			s.bpid = space->get_broadphase()->create(this, i, s.aabb_cache, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
 		}
 
-		space->get_broadphase()->move(s.bpid, shape_aabb);
+		space->get_broadphase()->move(s.bpid, s.aabb_cache);
 	}
 }
 
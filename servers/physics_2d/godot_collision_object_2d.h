@@ -81,6 +81,12 @@ protected:
 	void _update_shapes_with_motion(const Vector2 &p_motion);
 	void _unregister_shapes();
 
+	// Split versions of the shape updates: computing the AABBs doesn't touch the space,
+	// so it can run on threads, the broadphase is updated afterwards with the cached AABBs.
+	void _compute_shape_aabbs();
+	void _compute_shape_aabbs_with_motion(const Vector2 &p_motion);
+	void _commit_shape_aabbs();
+
 	_FORCE_INLINE_ void _set_transform(const Transform2D &p_transform, bool p_update_shapes = true) {
 		transform = p_transform;
 		if (p_update_shapes) {
@@ -48,6 +48,31 @@ protected:
 	}
 
 public:
+	// Orders the constraints of deterministic spaces. It must only depend on the objects
+	// involved, not on when the constraint was created.
+	struct OrderKey {
+		uint64_t first = 0;
+		uint64_t second = 0;
+		uint64_t shapes = 0;
+
+		_FORCE_INLINE_ bool operator<(const OrderKey &p_key) const {
+			if (first != p_key.first) {
+				return first < p_key.first;
+			}
+			if (second != p_key.second) {
+				return second < p_key.second;
+			}
+			return shapes < p_key.shapes;
+		}
+
+		_FORCE_INLINE_ OrderKey() {}
+		_FORCE_INLINE_ OrderKey(const RID &p_first, const RID &p_second, int p_shape_first = 0, int p_shape_second = 0) {
+			first = p_first.get_id();
+			second = p_second.get_id();
+			shapes = (uint64_t(uint32_t(p_shape_first)) << 32) | uint32_t(p_shape_second);
+		}
+	};
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
@@ -60,6 +85,8 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	virtual OrderKey get_order_key() const { return OrderKey(self, RID()); }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
@@ -55,29 +55,34 @@ _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject2D *p_object, u
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+int GodotPhysicsDirectSpaceState2D::_intersect_point(const PointParameters &p_parameters, const Vector2 &p_position, ShapeResult *r_results, int p_result_max, const QueryBuffer &p_buffer) {
 	if (p_result_max <= 0) {
 		return 0;
 	}
 
 	Rect2 aabb;
-	aabb.position = p_parameters.position - Vector2(0.00001, 0.00001);
+	aabb.position = p_position - Vector2(0.00001, 0.00001);
 	aabb.size = Vector2(0.00002, 0.00002);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount;
+	if (p_buffer.broadphase_locked) {
+		amount = space->broadphase->cull_aabb_unlocked(aabb, p_buffer.results, GodotSpace2D::INTERSECTION_QUERY_MAX, p_buffer.subindex_results, p_buffer.cull_buffer);
+	} else {
+		amount = space->broadphase->cull_aabb(aabb, p_buffer.results, GodotSpace2D::INTERSECTION_QUERY_MAX, p_buffer.subindex_results, p_buffer.cull_buffer);
+	}
 
 	int cc = 0;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(p_buffer.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_buffer.results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = p_buffer.results[i];
 
 		if (p_parameters.pick_point && !col_obj->is_pickable()) {
 			continue;
@@ -87,11 +92,11 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 			continue;
 		}
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_buffer.subindex_results[i];
 
 		GodotShape2D *shape = col_obj->get_shape(shape_idx);
 
-		Vector2 local_point = (col_obj->get_transform() * col_obj->get_shape_transform(shape_idx)).affine_inverse().xform(p_parameters.position);
+		Vector2 local_point = (col_obj->get_transform() * col_obj->get_shape_transform(shape_idx)).affine_inverse().xform(p_position);
 
 		if (!shape->contains_point(local_point)) {
 			continue;
@@ -114,16 +119,23 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
+int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	return _intersect_point(p_parameters, p_parameters.position, r_results, p_result_max, _get_space_query_buffer());
+}
 
+bool GodotPhysicsDirectSpaceState2D::_intersect_ray(const RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, const QueryBuffer &p_buffer) {
 	Vector2 begin, end;
 	Vector2 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount;
+	if (p_buffer.broadphase_locked) {
+		amount = space->broadphase->cull_segment_unlocked(begin, end, p_buffer.results, GodotSpace2D::INTERSECTION_QUERY_MAX, p_buffer.subindex_results, p_buffer.cull_buffer);
+	} else {
+		amount = space->broadphase->cull_segment(begin, end, p_buffer.results, GodotSpace2D::INTERSECTION_QUERY_MAX, p_buffer.subindex_results, p_buffer.cull_buffer);
+	}
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -134,17 +146,17 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(p_buffer.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_buffer.results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = p_buffer.results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_buffer.subindex_results[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -203,6 +215,89 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, r_result, _get_space_query_buffer());
+}
+
+void GodotPhysicsDirectSpaceState2D::intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+
+	QueryBatch batch;
+	batch.ray_parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.ray_results = r_results;
+	batch.hits = r_hits;
+	batch.query_count = p_count;
+	_run_query_batch(batch);
+}
+
+void GodotPhysicsDirectSpaceState2D::intersect_points(const PointParameters &p_parameters, const Vector2 *p_positions, int p_count, ShapeResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+
+	QueryBatch batch;
+	batch.point_parameters = &p_parameters;
+	batch.from = p_positions;
+	batch.shape_results = r_results;
+	batch.hits = r_hits;
+	batch.query_count = p_count;
+	_run_query_batch(batch);
+}
+
+GodotPhysicsDirectSpaceState2D::QueryBuffer GodotPhysicsDirectSpaceState2D::_get_space_query_buffer() const {
+	QueryBuffer buffer;
+	buffer.results = space->intersection_query_results;
+	buffer.subindex_results = space->intersection_query_subindex_results;
+	return buffer;
+}
+
+void GodotPhysicsDirectSpaceState2D::_run_query_batch(QueryBatch &r_batch) {
+	if (r_batch.query_count == 0) {
+		return;
+	}
+
+	// Split the queries in a few chunks per thread, each chunk reuses its query buffer between its queries.
+	const uint32_t chunk_count = MIN(r_batch.query_count, uint32_t(MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * 4));
+	r_batch.chunk_size = (r_batch.query_count + chunk_count - 1) / chunk_count;
+
+	// Locking once for the whole batch, so the chunks don't wait on each other.
+	space->broadphase->lock_queries();
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_query_batch_chunk, &r_batch, chunk_count, -1, true, SNAME("Physics2DQueryBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	space->broadphase->unlock_queries();
+}
+
+void GodotPhysicsDirectSpaceState2D::_query_batch_chunk(uint32_t p_chunk, QueryBatch *p_batch) {
+	LocalVector<GodotCollisionObject2D *> results;
+	results.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> subindex_results;
+	subindex_results.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+	GodotBroadPhase2D::CullBuffer cull_buffer;
+
+	QueryBuffer buffer;
+	buffer.results = results.ptr();
+	buffer.subindex_results = subindex_results.ptr();
+	buffer.cull_buffer = &cull_buffer;
+	buffer.broadphase_locked = true;
+
+	const uint32_t from = p_chunk * p_batch->chunk_size;
+	const uint32_t to = MIN(from + p_batch->chunk_size, p_batch->query_count);
+	for (uint32_t i = from; i < to; i++) {
+		if (p_batch->ray_parameters) {
+			p_batch->hits[i] = _intersect_ray(*p_batch->ray_parameters, p_batch->from[i], p_batch->to[i], p_batch->ray_results[i], buffer);
+		} else {
+			p_batch->hits[i] = _intersect_point(*p_batch->point_parameters, p_batch->from[i], &p_batch->shape_results[i], 1, buffer) > 0;
+		}
+	}
+}
+
 int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -1009,15 +1104,17 @@ bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::
 
 // Assumes a valid collision pair, this should have been checked beforehand in the BVH or octree.
 void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_self) {
+	GodotSpace2D *self = static_cast<GodotSpace2D *>(p_self);
+
 	GodotCollisionObject2D::Type type_A = A->get_type();
 	GodotCollisionObject2D::Type type_B = B->get_type();
-	if (type_A > type_B) {
+	if (type_A > type_B || (self->deterministic && type_A == type_B && A->get_self() > B->get_self())) {
+		// When deterministic, the order of the objects doesn't depend on the order in which the broadphase finds them.
 		SWAP(A, B);
 		SWAP(p_subindex_A, p_subindex_B);
 		SWAP(type_A, type_B);
 	}
 
-	GodotSpace2D *self = static_cast<GodotSpace2D *>(p_self);
 	self->collision_pairs++;
 
 	if (type_A == GodotCollisionObject2D::TYPE_AREA) {
@@ -1173,6 +1270,9 @@ void GodotSpace2D::set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_v
 		case PhysicsServer2D::SPACE_PARAM_SOLVER_ITERATIONS:
 			solver_iterations = p_value;
 			break;
+		case PhysicsServer2D::SPACE_PARAM_DETERMINISTIC:
+			deterministic = p_value != 0;
+			break;
 	}
 }
 
@@ -1196,6 +1296,8 @@ real_t GodotSpace2D::get_param(PhysicsServer2D::SpaceParameter p_param) const {
 			return constraint_bias;
 		case PhysicsServer2D::SPACE_PARAM_SOLVER_ITERATIONS:
 			return solver_iterations;
+		case PhysicsServer2D::SPACE_PARAM_DETERMINISTIC:
+			return deterministic;
 	}
 	return 0;
 }
@@ -1240,6 +1342,8 @@ GodotSpace2D::GodotSpace2D() {
 	constraint_bias = GLOBAL_DEF("physics/2d/solver/default_constraint_bias", 0.2);
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/2d/solver/default_constraint_bias", PropertyInfo(Variant::FLOAT, "physics/2d/solver/default_constraint_bias", PROPERTY_HINT_RANGE, "0,1,0.01"));
 
+	deterministic = GLOBAL_DEF("physics/2d/solver/deterministic", false);
+
 	broadphase = GodotBroadPhase2D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
 	broadphase->set_unpair_callback(_broadphase_unpair, this);
@@ -45,11 +45,41 @@
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
+	// Where the broadphase writes the objects found by a query.
+	// Queries using separate buffers can run concurrently.
+	struct QueryBuffer {
+		GodotCollisionObject2D **results = nullptr;
+		int *subindex_results = nullptr;
+		GodotBroadPhase2D::CullBuffer *cull_buffer = nullptr;
+		bool broadphase_locked = false; // Held by the batch, the culls must not lock it again.
+	};
+
+	// Rays when ray_parameters is set, points otherwise.
+	struct QueryBatch {
+		const RayParameters *ray_parameters = nullptr;
+		const PointParameters *point_parameters = nullptr;
+		const Vector2 *from = nullptr; // Ray origins or point positions.
+		const Vector2 *to = nullptr;
+		RayResult *ray_results = nullptr;
+		ShapeResult *shape_results = nullptr;
+		bool *hits = nullptr;
+		uint32_t query_count = 0;
+		uint32_t chunk_size = 0;
+	};
+
+	QueryBuffer _get_space_query_buffer() const;
+	int _intersect_point(const PointParameters &p_parameters, const Vector2 &p_position, ShapeResult *r_results, int p_result_max, const QueryBuffer &p_buffer);
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, const QueryBuffer &p_buffer);
+	void _run_query_batch(QueryBatch &r_batch);
+	void _query_batch_chunk(uint32_t p_chunk, QueryBatch *p_batch);
+
 public:
 	GodotSpace2D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
+	virtual void intersect_points(const PointParameters &p_parameters, const Vector2 *p_positions, int p_count, ShapeResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) override;
@@ -97,6 +127,7 @@ private:
 	GodotArea2D *area = nullptr;
 
 	int solver_iterations = 0;
+	bool deterministic = false;
 
 	real_t contact_recycle_radius = 0.0;
 	real_t contact_max_separation = 0.0;
@@ -159,6 +190,7 @@ public:
 	const HashSet<GodotCollisionObject2D *> &get_objects() const;
 
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
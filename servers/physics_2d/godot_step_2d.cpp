@@ -37,6 +37,7 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define BODY_COUNT_RESERVE 1024
 
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -76,6 +77,27 @@ void GodotStep2D::_setup_contraint(uint32_t p_constraint_index, void *p_userdata
 	constraint->setup(delta);
 }
 
+void GodotStep2D::_gather_active_bodies(const SelfList<GodotBody2D>::List *p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody2D> *b = p_body_list->first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+	if (deterministic) {
+		// The list order depends on when the bodies were activated.
+		active_bodies.sort_custom<BodyOrder>();
+	}
+}
+
+void GodotStep2D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep2D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
 void GodotStep2D::_pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const {
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
@@ -133,6 +155,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	iterations = p_space->get_solver_iterations();
 	delta = p_delta;
+	deterministic = p_space->is_deterministic();
 
 	const SelfList<GodotBody2D>::List *body_list = &p_space->get_active_body_list();
 
@@ -141,16 +164,19 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	// The active bodies are copied to a contiguous array, integrated on threads,
+	// then their broadphase entries are updated serially.
+	_gather_active_bodies(body_list);
+	uint32_t active_count = active_bodies.size();
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_forces, nullptr, active_count, -1, true, SNAME("Physics2DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (uint32_t body_index = 0; body_index < active_count; ++body_index) {
+		active_bodies[body_index]->commit_integration();
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects((int)active_count);
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -174,29 +200,37 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 				continue;
 			}
 			constraint->set_island_step(_step);
-
-			// Each constraint can be on a separate island for areas as there's no solving phase.
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-
 			all_constraints.push_back(constraint);
-			constraint_island.push_back(constraint);
 		}
 		p_space->area_remove_from_moved_list((SelfList<GodotArea2D> *)aml.first()); //faster to remove here
 	}
 
+	if (deterministic) {
+		all_constraints.sort_custom<ConstraintOrder>();
+	}
+
+	uint32_t area_constraint_count = all_constraints.size();
+	for (uint32_t constraint_index = 0; constraint_index < area_constraint_count; ++constraint_index) {
+		// Each constraint can be on a separate island for areas as there's no solving phase.
+		++island_count;
+		if (constraint_islands.size() < island_count) {
+			constraint_islands.resize(island_count);
+		}
+		LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
+		constraint_island.clear();
+		constraint_island.push_back(all_constraints[constraint_index]);
+	}
+
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	// Gathered again, as the broadphase update can activate bodies.
+	_gather_active_bodies(body_list);
+	active_count = active_bodies.size();
 
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody2D *body = b->self();
+	for (uint32_t body_index = 0; body_index < active_count; ++body_index) {
+		GodotBody2D *body = active_bodies[body_index];
 
 		if (body->get_island_step() != _step) {
 			++body_island_count;
@@ -223,9 +257,11 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 			if (constraint_island.is_empty()) {
 				--island_count;
+			} else if (deterministic) {
+				// The island is filled following the constraint lists of the bodies, which depend on the pairing order.
+				constraint_island.sort_custom<ConstraintOrder>();
 			}
 		}
-		b = b->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -239,7 +275,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_contraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_contraint, nullptr, total_contraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_contraint, nullptr, total_contraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -270,11 +306,16 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	// Gathered again, as bodies can be activated by the collisions.
+	_gather_active_bodies(body_list);
+	active_count = active_bodies.size();
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_velocities, nullptr, active_count, -1, true, SNAME("Physics2DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Bodies can deactivate themselves here, which is why the array is used instead of the list.
+	for (uint32_t body_index = 0; body_index < active_count; ++body_index) {
+		active_bodies[body_index]->commit_integration();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -299,6 +340,7 @@ GodotStep2D::GodotStep2D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	active_bodies.reserve(BODY_COUNT_RESERVE);
 }
 
 GodotStep2D::~GodotStep2D() {
@@ -41,11 +41,28 @@ class GodotStep2D {
 
 	int iterations = 0;
 	real_t delta = 0.0;
+	bool deterministic = false;
+
+	struct BodyOrder {
+		_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const {
+			return p_a->get_self() < p_b->get_self();
+		}
+	};
+
+	struct ConstraintOrder {
+		_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const {
+			return p_a->get_order_key() < p_b->get_order_key();
+		}
+	};
 
 	LocalVector<LocalVector<GodotBody2D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
+	LocalVector<GodotBody2D *> active_bodies;
 
+	void _gather_active_bodies(const SelfList<GodotBody2D>::List *p_body_list);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
 	void _setup_contraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
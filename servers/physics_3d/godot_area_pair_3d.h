@@ -46,6 +46,8 @@ class GodotAreaPair3D : public GodotConstraint3D {
 	bool has_space_override = false;
 
 public:
+	virtual bool is_area_pair() const override { return true; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -67,6 +69,8 @@ class GodotArea2Pair3D : public GodotConstraint3D {
 	bool area_b_monitorable;
 
 public:
+	virtual bool is_area_pair() const override { return true; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -85,6 +89,8 @@ class GodotAreaSoftBodyPair3D : public GodotConstraint3D {
 	bool has_space_override = false;
 
 public:
+	virtual bool is_area_pair() const override { return true; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
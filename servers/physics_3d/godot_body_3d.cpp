@@ -674,7 +674,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		return;
 	}
 
-	if (fi_callback_data || body_state_callback) {
+	if ((fi_callback_data || body_state_callback) && !direct_state_query_list.in_list()) {
 		get_space()->body_add_to_state_query_list(&direct_state_query_list);
 	}
 
@@ -144,6 +144,7 @@ class GodotBody3D : public GodotCollisionObject3D {
 	GodotPhysicsDirectBodyState3D *direct_state = nullptr;
 
 	uint64_t island_step = 0;
+	uint64_t substep_step = 0;
 
 	void _update_transform_dependent();
 
@@ -194,6 +195,17 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	// Bodies in substepped islands are integrated by their island, not by the main step.
+	_FORCE_INLINE_ uint64_t get_substep_step() const { return substep_step; }
+	_FORCE_INLINE_ void set_substep_step(uint64_t p_step) { substep_step = p_step; }
+
+	// Clears what the previous substep accumulated, only the last substep reports contacts.
+	_FORCE_INLINE_ void prepare_substep() {
+		biased_linear_velocity = Vector3();
+		biased_angular_velocity = Vector3();
+		contact_count = 0;
+	}
+
 	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
 	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraint_map.erase(p_constraint); }
 	const HashMap<GodotConstraint3D *, int> &get_constraint_map() const { return constraint_map; }
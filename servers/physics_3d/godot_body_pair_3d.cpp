@@ -44,8 +44,14 @@ void GodotBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_in
 }
 
 void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B) {
-	Vector3 local_A = A->get_inv_transform().basis.xform(p_point_A);
-	Vector3 local_B = B->get_inv_transform().basis.xform(p_point_B - offset_B);
+	Vector3 normal = (p_point_A - p_point_B).normalized();
+
+	// Speculative contacts are found on grown shapes, move the points back onto the actual ones.
+	Vector3 point_A = p_point_A - normal * speculative_margin_A;
+	Vector3 point_B = p_point_B + normal * speculative_margin_B;
+
+	Vector3 local_A = A->get_inv_transform().basis.xform(point_A);
+	Vector3 local_B = B->get_inv_transform().basis.xform(point_B - offset_B);
 
 	int new_index = contact_count;
 
@@ -56,7 +62,7 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 	contact.index_B = p_index_B;
 	contact.local_A = local_A;
 	contact.local_B = local_B;
-	contact.normal = (p_point_A - p_point_B).normalized();
+	contact.normal = normal;
 	contact.used = true;
 
 	// Attempt to determine if the contact will be reused.
@@ -217,6 +223,15 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 	return ABS(MIN(A->get_friction(), B->get_friction()));
 }
 
+uint32_t GodotBodyPair3D::get_setup_batch() const {
+	uint32_t type_A = A->get_shape(shape_A)->get_type();
+	uint32_t type_B = B->get_shape(shape_B)->get_type();
+	if (type_A > type_B) {
+		SWAP(type_A, type_B);
+	}
+	return 1 + type_A * PhysicsServer3D::SHAPE_CUSTOM + type_B;
+}
+
 bool GodotBodyPair3D::setup(real_t p_step) {
 	check_ccd = false;
 
@@ -253,9 +268,30 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
-	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	bool speculative = space->get_continuous_cd_mode() == GodotSpace3D::CONTINUOUS_CD_MODE_SPECULATIVE;
+
+	speculative_margin_A = 0.0;
+	speculative_margin_B = 0.0;
+	if (speculative) {
+		// Grow the continuous body by how much the bodies get closer during this step at most,
+		// so contacts are found before the shapes touch and the solver can stop them in time.
+		real_t relative_motion = (A->get_linear_velocity() - B->get_linear_velocity()).length() * p_step;
+		if (relative_motion > CMP_EPSILON) {
+			if (A->is_continuous_collision_detection_enabled() && collide_A) {
+				speculative_margin_A = relative_motion;
+			} else if (B->is_continuous_collision_detection_enabled() && collide_B) {
+				speculative_margin_B = relative_motion;
+			}
+		}
+	}
+
+	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis, speculative_margin_A, speculative_margin_B);
 
 	if (!collided) {
+		if (speculative) {
+			return false;
+		}
+
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
 			check_ccd = true;
 			return true;
@@ -328,6 +364,8 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	real_t inv_mass_A = collide_A ? A->get_inv_mass() : 0.0;
 	real_t inv_mass_B = collide_B ? B->get_inv_mass() : 0.0;
 
+	bool has_speculative_contacts = speculative_margin_A > 0.0 || speculative_margin_B > 0.0;
+
 	for (int i = 0; i < contact_count; i++) {
 		Contact &c = contacts[i];
 		c.active = false;
@@ -339,6 +377,32 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 		real_t depth = axis.dot(c.normal);
 
 		if (depth <= 0.0) {
+			if (!has_speculative_contacts || report_contacts_only) {
+				continue;
+			}
+
+			// Not touching yet, but the bodies can close the gap during this step.
+			c.rA = global_A - A->get_center_of_mass();
+			c.rB = global_B - B->get_center_of_mass() - offset_B;
+
+			c.active = true;
+			do_process = true;
+
+			Vector3 inertia_A = inv_inertia_tensor_A.xform(c.rA.cross(c.normal));
+			Vector3 inertia_B = inv_inertia_tensor_B.xform(c.rB.cross(c.normal));
+			real_t kNormal = inv_mass_A + inv_mass_B;
+			kNormal += c.normal.dot(inertia_A.cross(c.rA)) + c.normal.dot(inertia_B.cross(c.rB));
+			c.mass_normal = 1.0f / kNormal;
+
+			// Allow approaching by the gap, the impulses only remove the excess velocity.
+			c.bias = depth * inv_dt;
+			c.bounce = -depth * inv_dt;
+			c.depth = depth;
+
+			c.acc_normal_impulse = 0.0;
+			c.acc_tangent_impulse = Vector3();
+			c.acc_bias_impulse = 0.0;
+			c.acc_bias_impulse_center_of_mass = 0.0;
 			continue;
 		}
 
@@ -93,6 +93,10 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 
 	Vector3 offset_B; //use local A coordinates to avoid numerical issues on collision detection
 
+	// Shapes are grown by these when looking for speculative contacts.
+	real_t speculative_margin_A = 0.0;
+	real_t speculative_margin_B = 0.0;
+
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
@@ -104,6 +108,7 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	virtual uint32_t get_setup_batch() const override;
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
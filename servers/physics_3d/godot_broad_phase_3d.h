@@ -33,6 +33,7 @@
 
 #include "core/math/aabb.h"
 #include "core/math/math_funcs.h"
+#include "core/templates/local_vector.h"
 
 class GodotCollisionObject3D;
 
@@ -44,6 +45,10 @@ public:
 
 	typedef uint32_t ID;
 
+	// Scratch memory of a cull query. Queries given their own buffer can run
+	// concurrently, as long as the broadphase isn't modified meanwhile.
+	typedef LocalVector<uint32_t, uint32_t, true> CullBuffer;
+
 	typedef void *(*PairCallback)(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_userdata);
 	typedef void (*UnpairCallback)(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_userdata);
 
@@ -57,9 +62,16 @@ public:
 	virtual bool is_static(ID p_id) const = 0;
 	virtual int get_subindex(ID p_id) const = 0;
 
-	virtual int cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
-	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
-	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
+	virtual int cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr, CullBuffer *r_buffer = nullptr) = 0;
+	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr, CullBuffer *r_buffer = nullptr) = 0;
+	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr, CullBuffer *r_buffer = nullptr) = 0;
+
+	// Queries spread over several threads lock the broadphase once, then use the
+	// unlocked culls with a buffer each. It must not be modified until unlocked.
+	virtual void lock_queries() = 0;
+	virtual void unlock_queries() = 0;
+	virtual int cull_point_unlocked(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, CullBuffer *r_buffer) = 0;
+	virtual int cull_segment_unlocked(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, CullBuffer *r_buffer) = 0;
 
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
@@ -74,16 +74,32 @@ int GodotBroadPhase3DBVH::get_subindex(ID p_id) const {
 	return bvh.get_subindex(p_id - 1);
 }
 
-int GodotBroadPhase3DBVH::cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices) {
-	return bvh.cull_point(p_point, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
+int GodotBroadPhase3DBVH::cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, CullBuffer *r_buffer) {
+	return bvh.cull_point(p_point, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices, r_buffer);
 }
 
-int GodotBroadPhase3DBVH::cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices) {
-	return bvh.cull_segment(p_from, p_to, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
+int GodotBroadPhase3DBVH::cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, CullBuffer *r_buffer) {
+	return bvh.cull_segment(p_from, p_to, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices, r_buffer);
 }
 
-int GodotBroadPhase3DBVH::cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices) {
-	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
+int GodotBroadPhase3DBVH::cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, CullBuffer *r_buffer) {
+	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices, r_buffer);
+}
+
+void GodotBroadPhase3DBVH::lock_queries() {
+	bvh.cull_lock();
+}
+
+void GodotBroadPhase3DBVH::unlock_queries() {
+	bvh.cull_unlock();
+}
+
+int GodotBroadPhase3DBVH::cull_point_unlocked(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, CullBuffer *r_buffer) {
+	return bvh.cull_point_unlocked(p_point, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices, r_buffer);
+}
+
+int GodotBroadPhase3DBVH::cull_segment_unlocked(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, CullBuffer *r_buffer) {
+	return bvh.cull_segment_unlocked(p_from, p_to, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices, r_buffer);
 }
 
 void *GodotBroadPhase3DBVH::_pair_callback(void *self, uint32_t p_A, GodotCollisionObject3D *p_object_A, int subindex_A, uint32_t p_B, GodotCollisionObject3D *p_object_B, int subindex_B) {
@@ -123,6 +139,7 @@ GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
 }
 
 GodotBroadPhase3DBVH::GodotBroadPhase3DBVH() {
+	bvh.params_set_parallel_pairing(true);
 	bvh.set_pair_callback(_pair_callback, this);
 	bvh.set_unpair_callback(_unpair_callback, this);
 }
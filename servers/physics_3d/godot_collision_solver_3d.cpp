@@ -354,6 +354,183 @@ bool GodotCollisionSolver3D::solve_concave(const GodotShape3D *p_shape_A, const
 	return cinfo.collided;
 }
 
+// Analytic contacts for the sphere, box and capsule pairs that dominate most scenes.
+// They bypass the generic SAT path and its virtual projections and supports, so they
+// only handle rigid transforms and leave box/box and box/capsule to SAT, which clips
+// faces and edges to get stable manifolds.
+
+struct _PrimitiveCollector {
+	GodotCollisionSolver3D::CallbackResult callback = nullptr;
+	void *userdata = nullptr;
+	bool swap = false;
+	bool collided = false;
+	Vector3 *sep_axis = nullptr;
+
+	_FORCE_INLINE_ void call(const Vector3 &p_point_A, const Vector3 &p_point_B, const Vector3 &p_normal) {
+		collided = true;
+		if (sep_axis) {
+			*sep_axis = p_normal;
+		}
+		if (!callback) {
+			return;
+		}
+		if (swap) {
+			callback(p_point_B, 0, p_point_A, 0, userdata);
+		} else {
+			callback(p_point_A, 0, p_point_B, 0, userdata);
+		}
+	}
+};
+
+static _FORCE_INLINE_ bool _is_rigid_basis(const Basis &p_basis) {
+	static const real_t tolerance = 1e-4;
+
+	const Vector3 x = p_basis.get_column(0);
+	const Vector3 y = p_basis.get_column(1);
+	const Vector3 z = p_basis.get_column(2);
+
+	return Math::abs(x.length_squared() - 1.0) < tolerance && Math::abs(y.length_squared() - 1.0) < tolerance && Math::abs(z.length_squared() - 1.0) < tolerance &&
+			Math::abs(x.dot(y)) < tolerance && Math::abs(x.dot(z)) < tolerance && Math::abs(y.dot(z)) < tolerance;
+}
+
+static _FORCE_INLINE_ void _get_capsule_segment(const GodotCapsuleShape3D *p_capsule, const Transform3D &p_transform, Vector3 *r_segment) {
+	Vector3 capsule_axis = p_transform.basis.get_column(1) * (p_capsule->get_height() * 0.5 - p_capsule->get_radius());
+	r_segment[0] = p_transform.origin + capsule_axis;
+	r_segment[1] = p_transform.origin - capsule_axis;
+}
+
+// Radii include the margins. The normal points from B to A, like the SAT best axis.
+static _FORCE_INLINE_ void _primitive_sphere_sphere(const Vector3 &p_center_A, real_t p_radius_A, const Vector3 &p_center_B, real_t p_radius_B, _PrimitiveCollector &r_collector) {
+	Vector3 rel = p_center_A - p_center_B;
+	real_t radius = p_radius_A + p_radius_B;
+	real_t dist_sq = rel.length_squared();
+	if (dist_sq >= radius * radius) {
+		return;
+	}
+
+	real_t dist = Math::sqrt(dist_sq);
+	// Concentric spheres, use an upwards separator like SAT does.
+	Vector3 normal = dist > CMP_EPSILON ? rel / dist : Vector3(0.0, 1.0, 0.0);
+	r_collector.call(p_center_A - normal * p_radius_A, p_center_B + normal * p_radius_B, normal);
+}
+
+static _FORCE_INLINE_ void _primitive_sphere_box(const Vector3 &p_center_A, real_t p_radius_A, const Transform3D &p_transform_B, const Vector3 &p_half_extents_B, real_t p_margin_B, _PrimitiveCollector &r_collector) {
+	Vector3 local_center = p_transform_B.xform_inv(p_center_A);
+	Vector3 closest = local_center.clamp(-p_half_extents_B, p_half_extents_B);
+	Vector3 rel = local_center - closest;
+	real_t radius = p_radius_A + p_margin_B;
+	real_t dist_sq = rel.length_squared();
+
+	Vector3 normal;
+	if (dist_sq > CMP_EPSILON2) {
+		if (dist_sq >= radius * radius) {
+			return;
+		}
+		normal = rel / Math::sqrt(dist_sq);
+	} else {
+		// Center inside the box, push out through the closest face.
+		Vector3::Axis axis = (p_half_extents_B - local_center.abs()).min_axis_index();
+		normal[axis] = local_center[axis] < 0.0 ? -1.0 : 1.0;
+		closest[axis] = normal[axis] * p_half_extents_B[axis];
+	}
+
+	normal = p_transform_B.basis.xform(normal);
+	r_collector.call(p_center_A - normal * p_radius_A, p_transform_B.xform(closest) + normal * p_margin_B, normal);
+}
+
+static _FORCE_INLINE_ void _primitive_capsule_capsule(const Vector3 *p_segment_A, real_t p_radius_A, const Vector3 *p_segment_B, real_t p_radius_B, _PrimitiveCollector &r_collector) {
+	Vector3 dir_A = p_segment_A[1] - p_segment_A[0];
+	Vector3 dir_B = p_segment_B[1] - p_segment_B[0];
+	real_t len_sq_A = dir_A.length_squared();
+	real_t len_sq_B = dir_B.length_squared();
+
+	if (len_sq_A > CMP_EPSILON2 && len_sq_B > CMP_EPSILON2 && dir_A.cross(dir_B).length_squared() < 1e-4 * len_sq_A * len_sq_B) {
+		// Nearly parallel, put a contact at each end of the overlap so capsules can rest on each other.
+		real_t t0 = CLAMP(dir_A.dot(p_segment_B[0] - p_segment_A[0]) / len_sq_A, 0.0, 1.0);
+		real_t t1 = CLAMP(dir_A.dot(p_segment_B[1] - p_segment_A[0]) / len_sq_A, 0.0, 1.0);
+		if (!Math::is_equal_approx(t0, t1)) {
+			Vector3 point_A = p_segment_A[0] + dir_A * t0;
+			_primitive_sphere_sphere(point_A, p_radius_A, Geometry3D::get_closest_point_to_segment(point_A, p_segment_B), p_radius_B, r_collector);
+			point_A = p_segment_A[0] + dir_A * t1;
+			_primitive_sphere_sphere(point_A, p_radius_A, Geometry3D::get_closest_point_to_segment(point_A, p_segment_B), p_radius_B, r_collector);
+			return;
+		}
+	}
+
+	Vector3 closest_A, closest_B;
+	Geometry3D::get_closest_points_between_segments(p_segment_A[0], p_segment_A[1], p_segment_B[0], p_segment_B[1], closest_A, closest_B);
+	_primitive_sphere_sphere(closest_A, p_radius_A, closest_B, p_radius_B, r_collector);
+}
+
+bool GodotCollisionSolver3D::solve_primitive(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis, real_t p_margin_A, real_t p_margin_B, bool &r_collided) {
+	PhysicsServer3D::ShapeType type_A = p_shape_A->get_type();
+	PhysicsServer3D::ShapeType type_B = p_shape_B->get_type();
+
+	if (type_A < PhysicsServer3D::SHAPE_SPHERE || type_A > PhysicsServer3D::SHAPE_CAPSULE || type_B < PhysicsServer3D::SHAPE_SPHERE || type_B > PhysicsServer3D::SHAPE_CAPSULE) {
+		return false;
+	}
+
+	_PrimitiveCollector collector;
+	collector.callback = p_result_callback;
+	collector.userdata = p_userdata;
+	collector.sep_axis = r_sep_axis;
+
+	const GodotShape3D *A = p_shape_A;
+	const GodotShape3D *B = p_shape_B;
+	const Transform3D *transform_A = &p_transform_A;
+	const Transform3D *transform_B = &p_transform_B;
+	real_t margin_A = p_margin_A;
+	real_t margin_B = p_margin_B;
+
+	if (type_A > type_B) {
+		SWAP(A, B);
+		SWAP(transform_A, transform_B);
+		SWAP(type_A, type_B);
+		SWAP(margin_A, margin_B);
+		collector.swap = true;
+	}
+
+	if (type_A == PhysicsServer3D::SHAPE_BOX) {
+		return false;
+	}
+
+	if (!_is_rigid_basis(transform_A->basis) || !_is_rigid_basis(transform_B->basis)) {
+		return false;
+	}
+
+	if (type_A == PhysicsServer3D::SHAPE_SPHERE) {
+		const Vector3 &center_A = transform_A->origin;
+		real_t radius_A = static_cast<const GodotSphereShape3D *>(A)->get_radius() + margin_A;
+
+		switch (type_B) {
+			case PhysicsServer3D::SHAPE_SPHERE: {
+				real_t radius_B = static_cast<const GodotSphereShape3D *>(B)->get_radius() + margin_B;
+				_primitive_sphere_sphere(center_A, radius_A, transform_B->origin, radius_B, collector);
+			} break;
+			case PhysicsServer3D::SHAPE_BOX: {
+				_primitive_sphere_box(center_A, radius_A, *transform_B, static_cast<const GodotBoxShape3D *>(B)->get_half_extents(), margin_B, collector);
+			} break;
+			default: {
+				const GodotCapsuleShape3D *capsule_B = static_cast<const GodotCapsuleShape3D *>(B);
+				Vector3 segment_B[2];
+				_get_capsule_segment(capsule_B, *transform_B, segment_B);
+				_primitive_sphere_sphere(center_A, radius_A, Geometry3D::get_closest_point_to_segment(center_A, segment_B), capsule_B->get_radius() + margin_B, collector);
+			} break;
+		}
+	} else {
+		const GodotCapsuleShape3D *capsule_A = static_cast<const GodotCapsuleShape3D *>(A);
+		const GodotCapsuleShape3D *capsule_B = static_cast<const GodotCapsuleShape3D *>(B);
+		Vector3 segment_A[2];
+		Vector3 segment_B[2];
+		_get_capsule_segment(capsule_A, *transform_A, segment_A);
+		_get_capsule_segment(capsule_B, *transform_B, segment_B);
+		_primitive_capsule_capsule(segment_A, capsule_A->get_radius() + margin_A, segment_B, capsule_B->get_radius() + margin_B, collector);
+	}
+
+	r_collided = collector.collided;
+	return true;
+}
+
 bool GodotCollisionSolver3D::solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis, real_t p_margin_A, real_t p_margin_B) {
 	PhysicsServer3D::ShapeType type_A = p_shape_A->get_type();
 	PhysicsServer3D::ShapeType type_B = p_shape_B->get_type();
@@ -420,6 +597,11 @@ bool GodotCollisionSolver3D::solve_static(const GodotShape3D *p_shape_A, const T
 		}
 
 	} else {
+		bool collided = false;
+		if (solve_primitive(p_shape_A, p_transform_A, p_shape_B, p_transform_B, p_result_callback, p_userdata, r_sep_axis, p_margin_A, p_margin_B, collided)) {
+			return collided;
+		}
+
 		return collision_solver(p_shape_A, p_transform_A, p_shape_B, p_transform_B, p_result_callback, p_userdata, false, r_sep_axis, p_margin_A, p_margin_B);
 	}
 }
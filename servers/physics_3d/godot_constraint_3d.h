@@ -71,6 +71,13 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Constraints with the same setup batch are set up next to each other, so the
+	// same collision code path stays hot in the cache.
+	virtual uint32_t get_setup_batch() const { return 0; }
+
+	// Area pairs only track overlaps and are never solved.
+	virtual bool is_area_pair() const { return false; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
@@ -34,6 +34,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -58,9 +59,13 @@ _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, u
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	ERR_FAIL_COND_V(space->locked, false);
-	int amount = space->broadphase->cull_point(p_parameters.position, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+int GodotPhysicsDirectSpaceState3D::_intersect_point(const PointParameters &p_parameters, const Vector3 &p_position, ShapeResult *r_results, int p_result_max, const QueryBuffer &p_buffer) {
+	int amount;
+	if (p_buffer.broadphase_locked) {
+		amount = space->broadphase->cull_point_unlocked(p_position, p_buffer.results, GodotSpace3D::INTERSECTION_QUERY_MAX, p_buffer.subindex_results, p_buffer.cull_buffer);
+	} else {
+		amount = space->broadphase->cull_point(p_position, p_buffer.results, GodotSpace3D::INTERSECTION_QUERY_MAX, p_buffer.subindex_results, p_buffer.cull_buffer);
+	}
 	int cc = 0;
 
 	//Transform3D ai = p_xform.affine_inverse();
@@ -70,23 +75,23 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(p_buffer.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_buffer.results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = p_buffer.results[i];
+		int shape_idx = p_buffer.subindex_results[i];
 
 		Transform3D inv_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		inv_xform.affine_invert();
 
-		if (!col_obj->get_shape(shape_idx)->intersect_point(inv_xform.xform(p_parameters.position))) {
+		if (!col_obj->get_shape(shape_idx)->intersect_point(inv_xform.xform(p_position))) {
 			continue;
 		}
 
@@ -105,16 +110,24 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	ERR_FAIL_COND_V(space->locked, false);
+	return _intersect_point(p_parameters, p_parameters.position, r_results, p_result_max, _get_space_query_buffer());
+}
 
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const QueryBuffer &p_buffer) {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount;
+	if (p_buffer.broadphase_locked) {
+		amount = space->broadphase->cull_segment_unlocked(begin, end, p_buffer.results, GodotSpace3D::INTERSECTION_QUERY_MAX, p_buffer.subindex_results, p_buffer.cull_buffer);
+	} else {
+		amount = space->broadphase->cull_segment(begin, end, p_buffer.results, GodotSpace3D::INTERSECTION_QUERY_MAX, p_buffer.subindex_results, p_buffer.cull_buffer);
+	}
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -125,21 +138,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(p_buffer.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_buffer.results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_buffer.results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_buffer.results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_buffer.subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -200,6 +213,89 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, r_result, _get_space_query_buffer());
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+
+	QueryBatch batch;
+	batch.ray_parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.ray_results = r_results;
+	batch.hits = r_hits;
+	batch.query_count = p_count;
+	_run_query_batch(batch);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_points(const PointParameters &p_parameters, const Vector3 *p_positions, int p_count, ShapeResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+
+	QueryBatch batch;
+	batch.point_parameters = &p_parameters;
+	batch.from = p_positions;
+	batch.shape_results = r_results;
+	batch.hits = r_hits;
+	batch.query_count = p_count;
+	_run_query_batch(batch);
+}
+
+GodotPhysicsDirectSpaceState3D::QueryBuffer GodotPhysicsDirectSpaceState3D::_get_space_query_buffer() const {
+	QueryBuffer buffer;
+	buffer.results = space->intersection_query_results;
+	buffer.subindex_results = space->intersection_query_subindex_results;
+	return buffer;
+}
+
+void GodotPhysicsDirectSpaceState3D::_run_query_batch(QueryBatch &r_batch) {
+	if (r_batch.query_count == 0) {
+		return;
+	}
+
+	// Split the queries in a few chunks per thread, each chunk reuses its query buffer between its queries.
+	const uint32_t chunk_count = MIN(r_batch.query_count, uint32_t(MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * 4));
+	r_batch.chunk_size = (r_batch.query_count + chunk_count - 1) / chunk_count;
+
+	// Locking once for the whole batch, so the chunks don't wait on each other.
+	space->broadphase->lock_queries();
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_query_batch_chunk, &r_batch, chunk_count, -1, true, SNAME("Physics3DQueryBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	space->broadphase->unlock_queries();
+}
+
+void GodotPhysicsDirectSpaceState3D::_query_batch_chunk(uint32_t p_chunk, QueryBatch *p_batch) {
+	LocalVector<GodotCollisionObject3D *> results;
+	results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> subindex_results;
+	subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	GodotBroadPhase3D::CullBuffer cull_buffer;
+
+	QueryBuffer buffer;
+	buffer.results = results.ptr();
+	buffer.subindex_results = subindex_results.ptr();
+	buffer.cull_buffer = &cull_buffer;
+	buffer.broadphase_locked = true;
+
+	const uint32_t from = p_chunk * p_batch->chunk_size;
+	const uint32_t to = MIN(from + p_batch->chunk_size, p_batch->query_count);
+	for (uint32_t i = from; i < to; i++) {
+		if (p_batch->ray_parameters) {
+			p_batch->hits[i] = _intersect_ray(*p_batch->ray_parameters, p_batch->from[i], p_batch->to[i], p_batch->ray_results[i], buffer);
+		} else {
+			p_batch->hits[i] = _intersect_point(*p_batch->point_parameters, p_batch->from[i], &p_batch->shape_results[i], 1, buffer) > 0;
+		}
+	}
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -1268,6 +1364,12 @@ GodotSpace3D::GodotSpace3D() {
 	contact_bias = GLOBAL_DEF("physics/3d/solver/default_contact_bias", 0.8);
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/solver/default_contact_bias", PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"));
 
+	continuous_cd_mode = ContinuousCDMode(int(GLOBAL_DEF("physics/3d/solver/continuous_cd_mode", CONTINUOUS_CD_MODE_CAST_RAY)));
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/solver/continuous_cd_mode", PropertyInfo(Variant::INT, "physics/3d/solver/continuous_cd_mode", PROPERTY_HINT_ENUM, "Cast Ray,Speculative"));
+
+	max_substeps = GLOBAL_DEF("physics/3d/solver/max_substeps", 1);
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/solver/max_substeps", PropertyInfo(Variant::INT, "physics/3d/solver/max_substeps", PROPERTY_HINT_RANGE, "1,16,1,or_greater"));
+
 	broadphase = GodotBroadPhase3D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
 	broadphase->set_unpair_callback(_broadphase_unpair, this);
@@ -46,11 +46,41 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	// Where the broadphase writes the objects found by a query.
+	// Queries using separate buffers can run concurrently.
+	struct QueryBuffer {
+		GodotCollisionObject3D **results = nullptr;
+		int *subindex_results = nullptr;
+		GodotBroadPhase3D::CullBuffer *cull_buffer = nullptr;
+		bool broadphase_locked = false; // Held by the batch, the culls must not lock it again.
+	};
+
+	// Rays when ray_parameters is set, points otherwise.
+	struct QueryBatch {
+		const RayParameters *ray_parameters = nullptr;
+		const PointParameters *point_parameters = nullptr;
+		const Vector3 *from = nullptr; // Ray origins or point positions.
+		const Vector3 *to = nullptr;
+		RayResult *ray_results = nullptr;
+		ShapeResult *shape_results = nullptr;
+		bool *hits = nullptr;
+		uint32_t query_count = 0;
+		uint32_t chunk_size = 0;
+	};
+
+	QueryBuffer _get_space_query_buffer() const;
+	int _intersect_point(const PointParameters &p_parameters, const Vector3 &p_position, ShapeResult *r_results, int p_result_max, const QueryBuffer &p_buffer);
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const QueryBuffer &p_buffer);
+	void _run_query_batch(QueryBatch &r_batch);
+	void _query_batch_chunk(uint32_t p_chunk, QueryBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
+	virtual void intersect_points(const PointParameters &p_parameters, const Vector3 *p_positions, int p_count, ShapeResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
@@ -72,6 +102,11 @@ public:
 
 	};
 
+	enum ContinuousCDMode {
+		CONTINUOUS_CD_MODE_CAST_RAY,
+		CONTINUOUS_CD_MODE_SPECULATIVE,
+	};
+
 private:
 	uint64_t elapsed_time[ELAPSED_TIME_MAX] = {};
 
@@ -100,6 +135,9 @@ private:
 	real_t contact_max_allowed_penetration = 0.0;
 	real_t contact_bias = 0.0;
 
+	ContinuousCDMode continuous_cd_mode = CONTINUOUS_CD_MODE_CAST_RAY;
+	int max_substeps = 1;
+
 	enum {
 		INTERSECTION_QUERY_MAX = 2048
 	};
@@ -165,6 +203,8 @@ public:
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
 	_FORCE_INLINE_ real_t get_contact_bias() const { return contact_bias; }
+	_FORCE_INLINE_ ContinuousCDMode get_continuous_cd_mode() const { return continuous_cd_mode; }
+	_FORCE_INLINE_ int get_max_substeps() const { return max_substeps; }
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
@@ -111,6 +111,32 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_sort_constraints_by_setup_batch() {
+	// Counting sort, constraints keep their relative order inside a batch.
+	uint32_t constraint_count = all_constraints.size();
+	uint32_t batch_offsets[SETUP_BATCH_COUNT + 1] = {};
+
+	constraint_setup_batches.resize(constraint_count);
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		uint32_t batch = MIN(all_constraints[constraint_index]->get_setup_batch(), (uint32_t)SETUP_BATCH_COUNT - 1);
+		constraint_setup_batches[constraint_index] = batch;
+		batch_offsets[batch + 1]++;
+	}
+
+	for (uint32_t batch = 1; batch <= SETUP_BATCH_COUNT; ++batch) {
+		batch_offsets[batch] += batch_offsets[batch - 1];
+	}
+
+	sorted_constraints.resize(constraint_count);
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		sorted_constraints[batch_offsets[constraint_setup_batches[constraint_index]]++] = all_constraints[constraint_index];
+	}
+
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		all_constraints[constraint_index] = sorted_constraints[constraint_index];
+	}
+}
+
 void GodotStep3D::_setup_contraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -130,16 +156,18 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 }
 
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
-	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+	_solve_constraint_island(constraint_islands[p_island_index]);
+}
 
+void GodotStep3D::_solve_constraint_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
 	int current_priority = 1;
 
-	uint32_t constraint_count = constraint_island.size();
+	uint32_t constraint_count = p_constraint_island.size();
 	while (constraint_count > 0) {
 		for (int i = 0; i < iterations; i++) {
 			// Go through all iterations.
 			for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
-				constraint_island[constraint_index]->solve(delta);
+				p_constraint_island[constraint_index]->solve(delta);
 			}
 		}
 
@@ -147,16 +175,94 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 		uint32_t priority_constraint_count = 0;
 		++current_priority;
 		for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
-			GodotConstraint3D *constraint = constraint_island[constraint_index];
+			GodotConstraint3D *constraint = p_constraint_island[constraint_index];
 			if (constraint->get_priority() >= current_priority) {
 				// Keep this constraint for the next iteration.
-				constraint_island[priority_constraint_count++] = constraint;
+				p_constraint_island[priority_constraint_count++] = constraint;
 			}
 		}
 		constraint_count = priority_constraint_count;
 	}
 }
 
+uint32_t GodotStep3D::_get_island_substeps(const LocalVector<GodotBody3D *> &p_body_island, const LocalVector<GodotConstraint3D *> &p_constraint_island) const {
+	for (uint32_t constraint_index = 0; constraint_index < p_constraint_island.size(); ++constraint_index) {
+		if (p_constraint_island[constraint_index]->get_soft_body_count() > 0) {
+			return 1; // Soft bodies are solved separately, they can't be substepped.
+		}
+	}
+
+	// A continuous body is fast when it moves more than half its smallest extent in a step.
+	uint32_t substeps = 1;
+	for (uint32_t body_index = 0; body_index < p_body_island.size(); ++body_index) {
+		const GodotBody3D *body = p_body_island[body_index];
+		if (!body->is_continuous_collision_detection_enabled()) {
+			continue;
+		}
+
+		real_t extent = 0.0;
+		for (int shape_index = 0; shape_index < body->get_shape_count(); ++shape_index) {
+			if (body->is_shape_disabled(shape_index)) {
+				continue;
+			}
+			Vector3 size = body->get_shape(shape_index)->get_aabb().size;
+			real_t shape_extent = size[size.min_axis_index()];
+			if (extent == 0.0 || shape_extent < extent) {
+				extent = shape_extent;
+			}
+		}
+
+		real_t motion = body->get_linear_velocity().length() * delta;
+		if (extent > CMP_EPSILON && motion > extent * 0.5) {
+			substeps = MAX(substeps, (uint32_t)Math::ceil(motion / (extent * 0.5)));
+		}
+	}
+
+	return MIN(substeps, (uint32_t)max_substeps);
+}
+
+void GodotStep3D::_substep_island(SubstepIsland &p_island, real_t p_delta) {
+	// Collision detection, solving and integration run several times with a fraction of
+	// the step, so fast bodies can't skip over thin geometry. Forces were already
+	// integrated for the whole step.
+
+	// Area pairs don't affect the motion, so overlaps are only updated once per step.
+	uint32_t constraint_count = 0;
+	for (uint32_t constraint_index = 0; constraint_index < p_island.constraints.size(); ++constraint_index) {
+		GodotConstraint3D *constraint = p_island.constraints[constraint_index];
+		if (constraint->is_area_pair()) {
+			constraint->setup(p_delta);
+		} else {
+			p_island.constraints[constraint_count++] = constraint;
+		}
+	}
+	p_island.constraints.resize(constraint_count);
+
+	delta = p_delta / p_island.substeps;
+
+	for (uint32_t substep = 0; substep < p_island.substeps; ++substep) {
+		if (substep > 0) {
+			for (uint32_t body_index = 0; body_index < p_island.bodies.size(); ++body_index) {
+				p_island.bodies[body_index]->prepare_substep();
+			}
+		}
+
+		for (uint32_t constraint_index = 0; constraint_index < p_island.constraints.size(); ++constraint_index) {
+			p_island.constraints[constraint_index]->setup(delta);
+		}
+
+		substep_constraints = p_island.constraints;
+		_pre_solve_island(substep_constraints);
+		_solve_constraint_island(substep_constraints);
+
+		for (uint32_t body_index = 0; body_index < p_island.bodies.size(); ++body_index) {
+			p_island.bodies[body_index]->integrate_velocities(delta);
+		}
+	}
+
+	delta = p_delta;
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -189,6 +295,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->set_last_step(p_delta);
 
 	iterations = p_space->get_solver_iterations();
+	max_substeps = p_space->get_max_substeps();
 	delta = p_delta;
 
 	const SelfList<GodotBody3D>::List *body_list = &p_space->get_active_body_list();
@@ -262,6 +369,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	b = body_list->first();
 
 	uint32_t body_island_count = 0;
+	uint32_t substep_island_count = 0;
 
 	while (b) {
 		GodotBody3D *body = b->self();
@@ -283,8 +391,33 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 			constraint_island.clear();
 			constraint_island.reserve(ISLAND_SIZE_RESERVE);
 
+			uint32_t constraint_start = all_constraints.size();
 			_populate_island(body, body_island, constraint_island);
 
+			uint32_t substeps = 1;
+			if (max_substeps > 1 && !constraint_island.is_empty()) {
+				substeps = _get_island_substeps(body_island, constraint_island);
+			}
+
+			if (substeps > 1) {
+				// Islands with fast bodies are stepped on their own after the others are solved.
+				++substep_island_count;
+				if (substep_islands.size() < substep_island_count) {
+					substep_islands.resize(substep_island_count);
+				}
+				SubstepIsland &substep_island = substep_islands[substep_island_count - 1];
+				substep_island.bodies = body_island;
+				substep_island.constraints = constraint_island;
+				substep_island.substeps = substeps;
+
+				for (uint32_t body_index = 0; body_index < body_island.size(); ++body_index) {
+					body_island[body_index]->set_substep_step(_step);
+				}
+
+				all_constraints.resize(constraint_start);
+				constraint_island.clear();
+			}
+
 			if (body_island.is_empty()) {
 				--body_island_count;
 			}
@@ -342,6 +475,10 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
+	// Setup order doesn't matter, group the constraints by shape pair type so each
+	// worker runs through batches of the same collision kernel.
+	_sort_constraints_by_setup_batch();
+
 	uint32_t total_contraint_count = all_constraints.size();
 	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_contraint, nullptr, total_contraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
@@ -366,6 +503,13 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
+	/* SUBSTEP ISLANDS WITH FAST BODIES */
+
+	// Warning: This doesn't run on threads either, pre-solving is part of each substep.
+	for (uint32_t island_index = 0; island_index < substep_island_count; ++island_index) {
+		_substep_island(substep_islands[island_index], p_delta);
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
@@ -377,7 +521,9 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	b = body_list->first();
 	while (b) {
 		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
+		if (b->self()->get_substep_step() != _step) {
+			b->self()->integrate_velocities(p_delta);
+		}
 		b = n;
 	}
 
@@ -37,20 +37,39 @@
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
+	enum {
+		SETUP_BATCH_COUNT = PhysicsServer3D::SHAPE_CUSTOM * PhysicsServer3D::SHAPE_CUSTOM + 1,
+	};
+
+	struct SubstepIsland {
+		LocalVector<GodotBody3D *> bodies;
+		LocalVector<GodotConstraint3D *> constraints;
+		uint32_t substeps = 1;
+	};
+
 	uint64_t _step = 1;
 
 	int iterations = 0;
+	int max_substeps = 1;
 	real_t delta = 0.0;
 
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotConstraint3D *> sorted_constraints;
+	LocalVector<uint32_t> constraint_setup_batches;
+	LocalVector<SubstepIsland> substep_islands;
+	LocalVector<GodotConstraint3D *> substep_constraints;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _sort_constraints_by_setup_batch();
 	void _setup_contraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _solve_constraint_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
+	uint32_t _get_island_substeps(const LocalVector<GodotBody3D *> &p_body_island, const LocalVector<GodotConstraint3D *> &p_constraint_island) const;
+	void _substep_island(SubstepIsland &p_island, real_t p_delta);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/typed_array.h"
 
 PhysicsServer2D *PhysicsServer2D::singleton = nullptr;
@@ -373,6 +374,116 @@ TypedArray<Dictionary> PhysicsDirectSpaceState2D::_intersect_point(const Ref<Phy
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState2D::_intersect_rays(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The arrays of ray origins and ends must have the same size.");
+
+	const int count = p_from.size();
+	LocalVector<RayResult> results;
+	results.resize(count);
+	LocalVector<bool> hits;
+	hits.resize(count);
+	memset(hits.ptr(), 0, count * sizeof(bool)); // In case the server leaves some of them out.
+
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptr(), hits.ptr());
+
+	PackedVector2Array positions;
+	positions.resize(count);
+	PackedVector2Array normals;
+	normals.resize(count);
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	Array colliders;
+	colliders.resize(count);
+	PackedInt32Array shapes;
+	shapes.resize(count);
+	TypedArray<RID> rids;
+	rids.resize(count);
+	for (int i = 0; i < count; i++) {
+		if (hits[i]) {
+			positions.set(i, results[i].position);
+			normals.set(i, results[i].normal);
+			collider_ids.set(i, results[i].collider_id);
+			colliders[i] = results[i].collider;
+			shapes.set(i, results[i].shape);
+			rids[i] = results[i].rid;
+		} else {
+			positions.set(i, Vector2());
+			normals.set(i, Vector2());
+			collider_ids.set(i, 0);
+			shapes.set(i, -1);
+		}
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["collider_id"] = collider_ids;
+	d["collider"] = colliders;
+	d["shape"] = shapes;
+	d["rid"] = rids;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState2D::_intersect_points(const Ref<PhysicsPointQueryParameters2D> &p_point_query, const PackedVector2Array &p_positions) {
+	ERR_FAIL_COND_V(p_point_query.is_null(), Dictionary());
+
+	const int count = p_positions.size();
+	LocalVector<ShapeResult> results;
+	results.resize(count);
+	LocalVector<bool> hits;
+	hits.resize(count);
+	memset(hits.ptr(), 0, count * sizeof(bool)); // In case the server leaves some of them out.
+
+	intersect_points(p_point_query->get_parameters(), p_positions.ptr(), count, results.ptr(), hits.ptr());
+
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	Array colliders;
+	colliders.resize(count);
+	PackedInt32Array shapes;
+	shapes.resize(count);
+	TypedArray<RID> rids;
+	rids.resize(count);
+	for (int i = 0; i < count; i++) {
+		if (hits[i]) {
+			collider_ids.set(i, results[i].collider_id);
+			colliders[i] = results[i].collider;
+			shapes.set(i, results[i].shape);
+			rids[i] = results[i].rid;
+		} else {
+			collider_ids.set(i, 0);
+			shapes.set(i, -1);
+		}
+	}
+
+	Dictionary d;
+	d["collider_id"] = collider_ids;
+	d["collider"] = colliders;
+	d["shape"] = shapes;
+	d["rid"] = rids;
+
+	return d;
+}
+
+void PhysicsDirectSpaceState2D::intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
+void PhysicsDirectSpaceState2D::intersect_points(const PointParameters &p_parameters, const Vector2 *p_positions, int p_count, ShapeResult *r_results, bool *r_hits) {
+	PointParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.position = p_positions[i];
+		r_hits[i] = intersect_point(parameters, &r_results[i], 1) > 0;
+	}
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState2D::_intersect_shape(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, int p_max_results) {
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), TypedArray<Dictionary>());
 
@@ -454,6 +565,8 @@ void PhysicsDirectSpaceState2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState2D::_intersect_ray);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_intersect_shape, DEFVAL(32));
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to"), &PhysicsDirectSpaceState2D::_intersect_rays);
+	ClassDB::bind_method(D_METHOD("intersect_points", "parameters", "positions"), &PhysicsDirectSpaceState2D::_intersect_points);
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState2D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState2D::_get_rest_info);
@@ -786,6 +899,7 @@ void PhysicsServer2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(SPACE_PARAM_BODY_TIME_TO_SLEEP);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_SOLVER_ITERATIONS);
+	BIND_ENUM_CONSTANT(SPACE_PARAM_DETERMINISTIC);
 
 	BIND_ENUM_CONSTANT(SHAPE_WORLD_BOUNDARY);
 	BIND_ENUM_CONSTANT(SHAPE_SEPARATION_RAY);
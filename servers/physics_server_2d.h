@@ -117,6 +117,8 @@ class PhysicsDirectSpaceState2D : public Object {
 
 	Dictionary _intersect_ray(const Ref<PhysicsRayQueryParameters2D> &p_ray_query);
 	TypedArray<Dictionary> _intersect_point(const Ref<PhysicsPointQueryParameters2D> &p_point_query, int p_max_results = 32);
+	Dictionary _intersect_rays(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to);
+	Dictionary _intersect_points(const Ref<PhysicsPointQueryParameters2D> &p_point_query, const PackedVector2Array &p_positions);
 	TypedArray<Dictionary> _intersect_shape(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
 	TypedArray<PackedVector2Array> _collide_shape(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, int p_max_results = 32);
@@ -149,6 +151,11 @@ public:
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
 
+	// Casts p_count rays, all filtered like p_parameters (its from and to are ignored).
+	// Only the results of the rays flagged in r_hits are set. Runs the rays one by one
+	// by default, physics servers can override it to run them in parallel.
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits);
+
 	struct ShapeResult {
 		RID rid;
 		ObjectID collider_id;
@@ -170,6 +177,9 @@ public:
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) = 0;
 
+	// Same as intersect_rays(), finds the first object containing each position.
+	virtual void intersect_points(const PointParameters &p_parameters, const Vector2 *p_positions, int p_count, ShapeResult *r_results, bool *r_hits);
+
 	struct ShapeParameters {
 		RID shape_rid;
 		Transform2D transform;
@@ -262,6 +272,7 @@ public:
 		SPACE_PARAM_BODY_TIME_TO_SLEEP,
 		SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS,
 		SPACE_PARAM_SOLVER_ITERATIONS,
+		SPACE_PARAM_DETERMINISTIC,
 	};
 
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) = 0;
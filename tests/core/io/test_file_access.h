@@ -101,6 +101,43 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Batched positional reads") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(f.is_valid());
+	f->seek(6);
+
+	uint8_t a[5] = {};
+	uint8_t b[8] = {};
+	uint8_t c[16] = {};
+	FileAccess::BufferRead reads[3];
+	reads[0].position = 15; // Out of order on purpose.
+	reads[0].dst = b;
+	reads[0].length = 8;
+	reads[1].position = 0;
+	reads[1].dst = a;
+	reads[1].length = 5;
+	reads[2].position = f->get_length() - 4; // Runs past the end.
+	reads[2].dst = c;
+	reads[2].length = 16;
+
+	CHECK(f->get_buffers(reads, 3) == ERR_FILE_EOF);
+	CHECK(reads[0].read == 8);
+	CHECK(String::utf8((const char *)b, 8) == "My old f");
+	CHECK(reads[1].read == 5);
+	CHECK(String::utf8((const char *)a, 5) == "Hello");
+	CHECK(reads[2].read == 4);
+	CHECK(String::utf8((const char *)c, 4) == "ain\n");
+
+	CHECK_MESSAGE(f->get_position() == 6, "Batched reads should not move the file position.");
+	CHECK(f->get_8() == 'd');
+
+	// A read without a buffer is skipped, and doesn't report the count of the previous batch.
+	reads[1].dst = nullptr;
+	CHECK(f->get_buffers(reads, 3) == ERR_FILE_EOF);
+	CHECK(reads[1].read == 0);
+	CHECK(reads[0].read == 8);
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
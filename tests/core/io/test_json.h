@@ -31,7 +31,9 @@
 #ifndef TEST_JSON_H
 #define TEST_JSON_H
 
+#include "core/io/dir_access.h"
 #include "core/io/json.h"
+#include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
 
@@ -146,6 +148,151 @@ TEST_CASE("[JSON] Parsing objects (dictionaries)") {
 			dictionary["empty_object"].hash() == Dictionary().hash(),
 			"The parsed JSON should contain the expected values.");
 }
+
+class TestJSONStreamHandler : public JSON::StreamHandler {
+public:
+	String events;
+
+	virtual Error begin_object() override {
+		events += "{";
+		return OK;
+	}
+	virtual Error end_object() override {
+		events += "}";
+		return OK;
+	}
+	virtual Error begin_array() override {
+		events += "[";
+		return OK;
+	}
+	virtual Error end_array() override {
+		events += "]";
+		return OK;
+	}
+	virtual Error key(const String &p_key) override {
+		events += p_key + ":";
+		return OK;
+	}
+	virtual Error value(const Variant &p_value) override {
+		events += Variant::get_type_name(p_value.get_type()) + "(" + String(p_value) + ")";
+		return OK;
+	}
+};
+
+static String _get_json_stream_path() {
+	return OS::get_singleton()->get_cache_path().path_join("test_json_stream.json");
+}
+
+static Ref<FileAccess> _open_json_stream(const String &p_json) {
+	Ref<FileAccess> f = FileAccess::open(_get_json_stream_path(), FileAccess::WRITE_READ);
+	if (f.is_valid()) {
+		f->store_string(p_json);
+		f->seek(0);
+	}
+	return f;
+}
+
+TEST_CASE("[JSON] Streaming parser") {
+	JSON json;
+	TestJSONStreamHandler handler;
+
+	Ref<FileAccess> f = _open_json_stream(R"({"a": [1, -2.5e1, "h\u00e9\n"], "b": {"c": null, "d": true}, "e": []})");
+	REQUIRE(f.is_valid());
+	CHECK(json.parse_stream(f, &handler) == OK);
+	CHECK(json.get_error_line() == 0);
+	CHECK(handler.events == String::utf8("{a:[float(1)float(-25)String(h\xC3\xA9\n)]b:{c:Nil(<null>)d:bool(true)}e:[]}"));
+
+	handler.events = "";
+	f = _open_json_stream("\"\\ud83d\\ude00\"");
+	REQUIRE(f.is_valid());
+	CHECK(json.parse_stream(f, &handler) == OK);
+	CHECK(handler.events == String::utf8("String(\xF0\x9F\x98\x80)"));
+
+	// Errors report the same messages as parse().
+	f = _open_json_stream("{\"a\": 1\n\"b\": 2}");
+	REQUIRE(f.is_valid());
+	CHECK(json.parse_stream(f, &handler) == ERR_PARSE_ERROR);
+	CHECK(json.get_error_line() == 1);
+	CHECK(json.get_error_message() == "Expected '}' or ','");
+
+	f = _open_json_stream("[1] 2");
+	REQUIRE(f.is_valid());
+	CHECK(json.parse_stream(f, &handler) == ERR_PARSE_ERROR);
+	CHECK(json.get_error_message() == "Expected 'EOF'");
+
+	for (const String &truncated : { "[", "[1,", "{\"a\":" }) {
+		f = _open_json_stream(truncated);
+		REQUIRE(f.is_valid());
+		CHECK(json.parse_stream(f, &handler) == ERR_PARSE_ERROR);
+		JSON expected;
+		CHECK(expected.parse(truncated) == ERR_PARSE_ERROR);
+		CHECK_MESSAGE(json.get_error_message() == expected.get_error_message(), "Unexpected end of input should report the same error as parse().");
+	}
+
+	String long_number = "1";
+	for (int i = 0; i < 100; i++) {
+		long_number += "0";
+	}
+	f = _open_json_stream(long_number);
+	REQUIRE(f.is_valid());
+	CHECK(json.parse_stream(f, &handler) == ERR_PARSE_ERROR);
+	CHECK(json.get_error_message() == "Number is too long");
+
+	f.unref();
+	DirAccess::remove_file_or_error(_get_json_stream_path());
+}
+
+TEST_CASE("[JSON] Streaming parser without a handler") {
+	JSON json;
+
+	// Starts with a UTF-8 byte order mark.
+	Ref<FileAccess> f = _open_json_stream(String::utf8("\xEF\xBB\xBF{\"a\": [1, {\"b\": \"c\"}], \"d\": null}"));
+	REQUIRE(f.is_valid());
+	CHECK(json.parse_stream(f) == OK);
+
+	JSON expected;
+	REQUIRE(expected.parse(R"({"a": [1, {"b": "c"}], "d": null})") == OK);
+	CHECK(json.get_data().hash_compare(expected.get_data()));
+
+	f.unref();
+	DirAccess::remove_file_or_error(_get_json_stream_path());
+}
+
+TEST_CASE("[JSON] Streaming parser with large inputs") {
+	// Exceeds the internal read buffer and nests deeper than the recursive parser would like.
+	String json_string;
+	for (int i = 0; i < 10000; i++) {
+		json_string += "[";
+	}
+	for (int i = 0; i < 10000; i++) {
+		json_string += "\"0123456789abcdef\"]";
+		if (i < 9999) {
+			json_string += ",";
+		}
+	}
+
+	TestJSONStreamHandler handler;
+	JSON json;
+	Ref<FileAccess> f = _open_json_stream(json_string);
+	REQUIRE(f.is_valid());
+	CHECK(json.parse_stream(f, &handler) == OK);
+	CHECK(handler.events.length() == 10000 * 2 + 10000 * String("String(0123456789abcdef)").length());
+
+	// Multibyte characters split across two reads of the buffer. The opening quote
+	// puts the first byte of every character on an odd offset.
+	String accents;
+	for (int i = 0; i < 50000; i++) {
+		accents += String::utf8("\xC3\xA9");
+	}
+	handler.events = "";
+	f = _open_json_stream("\"" + accents + "\"");
+	REQUIRE(f.is_valid());
+	CHECK(json.parse_stream(f, &handler) == OK);
+	CHECK(handler.events == "String(" + accents + ")");
+
+	f.unref();
+	DirAccess::remove_file_or_error(_get_json_stream_path());
+}
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
@@ -32,6 +32,8 @@
 #define TEST_MARSHALLS_H
 
 #include "core/io/marshalls.h"
+#include "core/io/packet_peer.h"
+#include "core/math/random_pcg.h"
 
 #include "tests/test_macros.h"
 
@@ -326,6 +328,193 @@ TEST_CASE("[Marshalls] FLOAT double precision Variant decoding") {
 	CHECK(r_len == 12);
 	CHECK(variant == Variant(0.33333333333333333));
 }
+
+static Variant _make_random_variant(RandomPCG &p_rng, int p_depth) {
+	static const char *words[] = { "position", "velocity", "health", "name", "id", "" };
+	const int word_count = sizeof(words) / sizeof(words[0]);
+
+	switch (p_rng.rand(p_depth < 3 ? 16 : 12)) {
+		case 0:
+			return Variant();
+		case 1:
+			return p_rng.rand(2) == 1;
+		case 2:
+			return (int64_t(p_rng.rand()) << 32 | p_rng.rand()) >> p_rng.rand(64);
+		case 3:
+			return p_rng.rand(2) ? double(p_rng.randf()) : p_rng.random(-1e300, 1e300);
+		case 4:
+			return String(words[p_rng.rand(word_count)]) + String::chr(0x4e00 + p_rng.rand(32));
+		case 5:
+			return StringName(words[p_rng.rand(word_count)]);
+		case 6:
+			return Vector3(p_rng.randf(), p_rng.random(-1e6f, 1e6f), -0.5);
+		case 7:
+			return Vector2i(p_rng.rand(), -int32_t(p_rng.rand(1000)));
+		case 8:
+			return Transform3D(Basis(Vector3(0, 1, 0), p_rng.randf()), Vector3(1, 2, p_rng.randf()));
+		case 9:
+			return Color(p_rng.randf(), 0.25, 1, 0.5);
+		case 10: {
+			PackedInt32Array a;
+			for (uint32_t i = 0; i < p_rng.rand(20); i++) {
+				a.push_back(p_rng.rand());
+			}
+			return a;
+		}
+		case 11: {
+			PackedStringArray a;
+			for (uint32_t i = 0; i < p_rng.rand(8); i++) {
+				a.push_back(words[p_rng.rand(word_count)]);
+			}
+			return a;
+		}
+		case 12:
+		case 13: {
+			Array a;
+			for (uint32_t i = 0; i < p_rng.rand(6); i++) {
+				a.push_back(_make_random_variant(p_rng, p_depth + 1));
+			}
+			return a;
+		}
+		default: {
+			Dictionary d;
+			for (uint32_t i = 0; i < p_rng.rand(6); i++) {
+				d[words[p_rng.rand(word_count)]] = _make_random_variant(p_rng, p_depth + 1);
+			}
+			return d;
+		}
+	}
+}
+
+TEST_CASE("[Marshalls] Compact Variant encoding round trip") {
+	Dictionary d;
+	d["int"] = -123456789012345;
+	d["float"] = 0.5;
+	d["double"] = 0.33333333333333333;
+	d[StringName("name")] = StringName("name");
+	d["path"] = NodePath("../Parent/Node:property");
+	d["aabb"] = AABB(Vector3(1, 2, 3), Vector3(4, 5, 6));
+	d["projection"] = Projection(Vector4(1, 2, 3, 4), Vector4(5, 6, 7, 8), Vector4(9, 10, 11, 12), Vector4(13, 14, 15, 16));
+	d["rect"] = Rect2i(-1, 2, 3, 4);
+	d["bytes"] = PackedByteArray({ 1, 2, 3 });
+	d["vectors"] = PackedVector2Array({ Vector2(1, 2), Vector2(3, 4) });
+	d["colors"] = PackedColorArray({ Color(1, 0, 0), Color(0, 1, 0, 0.5) });
+	Array nested;
+	nested.push_back("name");
+	nested.push_back(1);
+	nested.push_back(Vector4i(1, -2, 3, -4));
+	nested.push_back(Variant());
+	d["nested"] = nested;
+
+	Vector<uint8_t> buffer;
+	REQUIRE(encode_variant_compact(d, buffer) == OK);
+
+	Variant decoded;
+	int r_len = 0;
+	CHECK(decode_variant_compact(decoded, buffer.ptr(), buffer.size(), &r_len) == OK);
+	CHECK(r_len == buffer.size());
+	CHECK(decoded.hash_compare(d));
+	CHECK(Dictionary(decoded)[StringName("name")].get_type() == Variant::STRING_NAME);
+
+	int legacy_len = 0;
+	REQUIRE(encode_variant(d, nullptr, legacy_len) == OK);
+	CHECK_MESSAGE(buffer.size() < legacy_len, "Compact encoding should be smaller than the regular one.");
+}
+
+TEST_CASE("[Marshalls] Compact Variant encoding interns repeated strings") {
+	Array a;
+	for (int i = 0; i < 100; i++) {
+		Dictionary d;
+		d["position"] = i;
+		d["velocity"] = -i;
+		a.push_back(d);
+	}
+
+	Vector<uint8_t> buffer;
+	REQUIRE(encode_variant_compact(a, buffer) == OK);
+	// 2 keys written out once, then 1 byte header + 1 byte index per key, plus small varints for the values.
+	CHECK(buffer.size() < 100 * 10);
+
+	Variant decoded;
+	CHECK(decode_variant_compact(decoded, buffer.ptr(), buffer.size()) == OK);
+	CHECK(decoded.hash_compare(a));
+}
+
+TEST_CASE("[Marshalls] Compact Variant encoding of floats outside single precision range") {
+	Array a;
+	a.push_back(1e300);
+	a.push_back(-1e300);
+	a.push_back(INFINITY);
+	a.push_back(0.5);
+
+	Vector<uint8_t> buffer;
+	REQUIRE(encode_variant_compact(a, buffer) == OK);
+
+	Variant decoded;
+	CHECK(decode_variant_compact(decoded, buffer.ptr(), buffer.size()) == OK);
+	CHECK(decoded.hash_compare(a));
+
+	// 1 byte array header and count, 2 doubles, then 2 floats.
+	CHECK(buffer.size() == 2 + 2 * 9 + 2 * 5);
+}
+
+TEST_CASE("[Marshalls] Compact Variant encoding in PacketPeer") {
+	Ref<StreamPeerBuffer> stream;
+	stream.instantiate();
+	Ref<PacketPeerStream> peer;
+	peer.instantiate();
+	peer->set_stream_peer(stream);
+	peer->set_compact_var_encoding(true);
+
+	Dictionary d;
+	d["name"] = "player";
+	d["position"] = Vector2(1.5, -2);
+	d["health"] = 100;
+	CHECK(peer->put_var(d) == OK);
+
+	// 4 bytes of packet length, then the packet.
+	Vector<uint8_t> compact;
+	CHECK(encode_variant_compact(d, compact) == OK);
+	CHECK(stream->get_size() == compact.size() + 4);
+
+	// The encode buffer is reused between calls.
+	CHECK(peer->put_var(d) == OK);
+	CHECK(stream->get_size() == 2 * (compact.size() + 4));
+
+	stream->seek(0);
+	Variant decoded;
+	CHECK(peer->get_var(decoded) == OK);
+	CHECK(decoded.hash_compare(d));
+	CHECK(peer->get_var(decoded) == OK);
+	CHECK(decoded.hash_compare(d));
+}
+
+TEST_CASE("[Marshalls] Compact Variant encoding fuzzing") {
+	RandomPCG rng(0x1234);
+
+	for (int i = 0; i < 200; i++) {
+		Variant v = _make_random_variant(rng, 0);
+
+		Vector<uint8_t> buffer;
+		REQUIRE(encode_variant_compact(v, buffer) == OK);
+
+		Variant decoded;
+		int r_len = 0;
+		CHECK(decode_variant_compact(decoded, buffer.ptr(), buffer.size(), &r_len) == OK);
+		CHECK(r_len == buffer.size());
+		CHECK(decoded.hash_compare(v));
+
+		// Truncated and corrupted input must fail gracefully.
+		ERR_PRINT_OFF;
+		if (buffer.size() > 1) {
+			// Proper prefixes never form a complete message.
+			CHECK(decode_variant_compact(decoded, buffer.ptr(), rng.rand(buffer.size() - 1) + 1) != OK);
+			buffer.write[rng.rand(buffer.size())] ^= 1 << rng.rand(8);
+			decode_variant_compact(decoded, buffer.ptr(), buffer.size());
+		}
+		ERR_PRINT_ON;
+	}
+}
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
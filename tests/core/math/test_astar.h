@@ -32,6 +32,8 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
+#include "core/math/random_number_generator.h"
 
 #include "tests/test_macros.h"
 
@@ -213,6 +215,138 @@ TEST_CASE("[AStar3D] Add/Remove") {
 	// It's been great work, cheers. \(^ ^)/
 }
 
+static real_t get_id_path_cost(const AStar3D &p_astar, const Vector<int64_t> &p_path) {
+	real_t cost = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		cost += p_astar.get_point_position(p_path[i - 1]).distance_to(p_astar.get_point_position(p_path[i])) * p_astar.get_point_weight_scale(p_path[i]);
+	}
+	return cost;
+}
+
+static void check_batched_id_paths(AStar3D &p_astar, const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids) {
+	const TypedArray<PackedInt64Array> paths = p_astar.get_id_paths(p_from_ids, p_to_ids);
+	REQUIRE(paths.size() == p_from_ids.size());
+
+	bool match = true;
+	for (int i = 0; i < p_from_ids.size(); i++) {
+		const PackedInt64Array batched = paths[i];
+		const Vector<int64_t> single = p_astar.get_id_path(p_from_ids[i], p_to_ids[i]);
+		// Paths of the same cost may go through different points, compare the costs.
+		if (batched.is_empty() != single.is_empty() ||
+				(!batched.is_empty() && (batched[0] != p_from_ids[i] || batched[batched.size() - 1] != p_to_ids[i])) ||
+				!Math::is_equal_approx(get_id_path_cost(p_astar, batched), get_id_path_cost(p_astar, single))) {
+			match = false;
+			break;
+		}
+	}
+	CHECK_MESSAGE(match, "Batched paths should match single queries.");
+}
+
+TEST_CASE("[AStar3D] Batched paths") {
+	AStar3D a;
+	RandomNumberGenerator rng;
+	rng.set_seed(1);
+
+	const int N = 200;
+	for (int i = 0; i < N; i++) {
+		a.add_point(i, Vector3(rng.randf_range(0, 100), rng.randf_range(0, 100), rng.randf_range(0, 100)), rng.randf_range(1, 3));
+	}
+	for (int i = 0; i < N * 3; i++) {
+		const int u = rng.randi_range(0, N - 1);
+		const int v = rng.randi_range(0, N - 1);
+		if (u != v) {
+			a.connect_points(u, v, rng.randi() % 2);
+		}
+	}
+	for (int i = 0; i < 10; i++) {
+		a.set_point_disabled(rng.randi_range(0, N - 1));
+	}
+
+	PackedInt64Array from_ids;
+	PackedInt64Array to_ids;
+	for (int i = 0; i < 100; i++) {
+		from_ids.push_back(rng.randi_range(0, N - 1));
+		to_ids.push_back(rng.randi_range(0, N - 1));
+	}
+	from_ids.push_back(5);
+	to_ids.push_back(5);
+
+	check_batched_id_paths(a, from_ids, to_ids);
+
+	SUBCASE("Graph changes are taken into account") {
+		for (int i = 0; i < 20; i++) {
+			a.disconnect_points(rng.randi_range(0, N - 1), rng.randi_range(0, N - 1));
+			a.set_point_position(rng.randi_range(0, N - 1), Vector3(rng.randf_range(0, 100), rng.randf_range(0, 100), rng.randf_range(0, 100)));
+		}
+		a.add_point(N, Vector3(50, 50, 50));
+		for (int i = 0; i < 20; i++) {
+			a.connect_points(N, i);
+		}
+		a.remove_point(7);
+		from_ids.push_back(N);
+		to_ids.push_back(N - 1);
+		for (int i = 0; i < from_ids.size(); i++) {
+			if (from_ids[i] == 7) {
+				from_ids.set(i, 8);
+			}
+			if (to_ids[i] == 7) {
+				to_ids.set(i, 8);
+			}
+		}
+
+		check_batched_id_paths(a, from_ids, to_ids);
+	}
+
+	SUBCASE("Invalid queries") {
+		ERR_PRINT_OFF;
+		CHECK(a.get_id_paths(from_ids, PackedInt64Array()).is_empty());
+
+		PackedInt64Array invalid_ids;
+		invalid_ids.push_back(N + 10);
+		const TypedArray<PackedInt64Array> paths = a.get_id_paths(invalid_ids, invalid_ids);
+		REQUIRE(paths.size() == 1);
+		CHECK(PackedInt64Array(paths[0]).is_empty());
+		ERR_PRINT_ON;
+	}
+}
+
+TEST_CASE("[AStar2D] Batched paths") {
+	AStar2D a;
+	const int W = 20;
+	for (int y = 0; y < W; y++) {
+		for (int x = 0; x < W; x++) {
+			a.add_point(y * W + x, Vector2(x, y));
+			if (x > 0) {
+				a.connect_points(y * W + x, y * W + x - 1);
+			}
+			if (y > 0) {
+				a.connect_points(y * W + x, (y - 1) * W + x);
+			}
+		}
+	}
+	// A wall with a single hole.
+	for (int y = 0; y < W - 1; y++) {
+		a.set_point_disabled(y * W + W / 2);
+	}
+
+	PackedInt64Array from_ids;
+	PackedInt64Array to_ids;
+	for (int y = 0; y < W; y++) {
+		from_ids.push_back(y * W);
+		to_ids.push_back(y * W + W - 1);
+	}
+
+	const TypedArray<PackedInt64Array> paths = a.get_id_paths(from_ids, to_ids);
+	REQUIRE(paths.size() == W);
+	for (int i = 0; i < W; i++) {
+		const PackedInt64Array path = paths[i];
+		const Vector<int64_t> single = a.get_id_path(from_ids[i], to_ids[i]);
+		CHECK(path.size() == single.size());
+		// Going around the wall through the hole in the last row.
+		CHECK(path.size() == (W - 1) + 2 * (W - 1 - i) + 1);
+	}
+}
+
 TEST_CASE("[Stress][AStar3D] Find paths") {
 	// Random stress tests with Floyd-Warshall.
 	const int N = 30;
@@ -357,6 +491,140 @@ TEST_CASE("[Stress][AStar3D] Find paths") {
 		CHECK_MESSAGE(match, "Found all paths.");
 	}
 }
+
+static real_t get_grid_path_length(const Vector<Vector2> &p_path) {
+	real_t length = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
+static void fill_random_obstacles(Ref<AStarGrid2D> p_grid, uint64_t p_seed, int p_count, int p_max_size) {
+	RandomNumberGenerator rng;
+	rng.set_seed(p_seed);
+	const Size2i size = p_grid->get_size();
+	for (int i = 0; i < p_count; i++) {
+		const Vector2i position(rng.randi_range(0, size.x - 1), rng.randi_range(0, size.y - 1));
+		const Vector2i extents(rng.randi_range(1, p_max_size), rng.randi_range(1, p_max_size));
+		p_grid->fill_solid_region(Rect2i(position, extents));
+	}
+}
+
+TEST_CASE("[AStarGrid2D] Solid regions") {
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_size(Size2i(200, 10));
+	grid->update();
+
+	grid->fill_solid_region(Rect2i(60, 2, 70, 5));
+	CHECK(grid->is_point_solid(Vector2i(60, 2)));
+	CHECK(grid->is_point_solid(Vector2i(64, 4)));
+	CHECK(grid->is_point_solid(Vector2i(129, 6)));
+	CHECK_FALSE(grid->is_point_solid(Vector2i(59, 2)));
+	CHECK_FALSE(grid->is_point_solid(Vector2i(130, 2)));
+	CHECK_FALSE(grid->is_point_solid(Vector2i(60, 1)));
+	CHECK_FALSE(grid->is_point_solid(Vector2i(60, 7)));
+
+	grid->fill_solid_region(Rect2i(100, 0, 10, 10), false);
+	CHECK(grid->is_point_solid(Vector2i(99, 3)));
+	CHECK_FALSE(grid->is_point_solid(Vector2i(100, 3)));
+	CHECK_FALSE(grid->is_point_solid(Vector2i(109, 3)));
+	CHECK(grid->is_point_solid(Vector2i(110, 3)));
+
+	// Regions are clipped to the grid.
+	grid->fill_solid_region(Rect2i(-10, -10, 1000, 11));
+	CHECK(grid->is_point_solid(Vector2i(0, 0)));
+	CHECK(grid->is_point_solid(Vector2i(199, 0)));
+	CHECK_FALSE(grid->is_point_solid(Vector2i(0, 1)));
+
+	grid->set_point_solid(Vector2i(5, 0), false);
+	CHECK_FALSE(grid->is_point_solid(Vector2i(5, 0)));
+	CHECK(grid->is_point_solid(Vector2i(6, 0)));
+
+	// A wall across the grid blocks all the paths.
+	grid->fill_solid_region(Rect2i(150, 0, 1, 10));
+	CHECK(grid->get_id_path(Vector2i(0, 5), Vector2i(199, 5)).is_empty());
+	grid->set_point_solid(Vector2i(150, 9), false);
+	CHECK_FALSE(grid->get_id_path(Vector2i(0, 5), Vector2i(199, 5)).is_empty());
+}
+
+TEST_CASE("[AStarGrid2D] Jumping paths") {
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_size(Size2i(64, 64));
+	grid->update();
+	fill_random_obstacles(grid, 7, 60, 6);
+
+	RandomNumberGenerator rng;
+	rng.set_seed(13);
+	bool same_length = true;
+	int found = 0;
+	for (int i = 0; i < 100; i++) {
+		const Vector2i from(rng.randi_range(0, 63), rng.randi_range(0, 63));
+		const Vector2i to(rng.randi_range(0, 63), rng.randi_range(0, 63));
+
+		grid->set_jumping_enabled(false);
+		const Vector<Vector2> path = grid->get_id_path(from, to);
+		grid->set_jumping_enabled(true);
+		const Vector<Vector2> jump_path = grid->get_id_path(from, to);
+
+		same_length = same_length && path.is_empty() == jump_path.is_empty();
+		if (!path.is_empty()) {
+			found++;
+			same_length = same_length && Math::is_equal_approx(get_grid_path_length(path), get_grid_path_length(jump_path));
+		}
+	}
+	CHECK(found > 50);
+	CHECK_MESSAGE(same_length, "Jump point search should find paths as short as the regular search.");
+}
+
+TEST_CASE("[Stress][AStarGrid2D] Large grid paths") {
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_size(Size2i(2048, 2048));
+	grid->update();
+
+	fill_random_obstacles(grid, 5, 20000, 16);
+
+	RandomNumberGenerator rng;
+	rng.set_seed(17);
+	bool valid_paths = true;
+	bool same_length = true;
+	int found = 0;
+	for (int i = 0; i < 5; i++) {
+		const Vector2i from(rng.randi_range(0, 2047), rng.randi_range(0, 2047));
+		const Vector2i to(rng.randi_range(0, 2047), rng.randi_range(0, 2047));
+		grid->fill_solid_region(Rect2i(from, Size2i(1, 1)), false);
+		grid->fill_solid_region(Rect2i(to, Size2i(1, 1)), false);
+
+		grid->set_jumping_enabled(false);
+		const Vector<Vector2> path = grid->get_id_path(from, to);
+		grid->set_jumping_enabled(true);
+		const Vector<Vector2> jump_path = grid->get_id_path(from, to);
+
+		same_length = same_length && path.is_empty() == jump_path.is_empty();
+		if (path.is_empty()) {
+			continue;
+		}
+		found++;
+		same_length = same_length && Math::is_equal_approx(get_grid_path_length(path), get_grid_path_length(jump_path));
+
+		// Consecutive points are neighbors, and none of them is solid.
+		valid_paths = valid_paths && Vector2i(path[0]) == from && Vector2i(path[path.size() - 1]) == to;
+		for (int j = 0; j < path.size(); j++) {
+			valid_paths = valid_paths && !grid->is_point_solid(Vector2i(path[j]));
+			if (j > 0) {
+				const Vector2i step = (Vector2i(path[j]) - Vector2i(path[j - 1])).abs();
+				valid_paths = valid_paths && step.x <= 1 && step.y <= 1;
+			}
+		}
+	}
+	CHECK(found > 0);
+	CHECK_MESSAGE(valid_paths, "Paths should go through neighboring points that aren't solid.");
+	CHECK_MESSAGE(same_length, "Jump point search should find paths as short as the regular search.");
+}
+
 } // namespace TestAStar
 
 #endif // TEST_ASTAR_H
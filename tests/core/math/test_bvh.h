@@ -0,0 +1,125 @@
+/*************************************************************************/
+/*  test_bvh.h                                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct PairItem {
+	int id = 0;
+};
+
+class PairTest {
+public:
+	static bool user_pair_check(const PairItem *p_a, const PairItem *p_b) {
+		return true;
+	}
+};
+
+class CullTest {
+public:
+	static bool user_cull_check(const PairItem *p_a, const PairItem *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<PairItem, 2, true, 128, PairTest, CullTest> PairBVH;
+
+struct PairLog {
+	LocalVector<Vector3i> events; // x: 1 for pair, 0 for unpair.
+
+	static void *pair(void *p_self, uint32_t, PairItem *p_a, int, uint32_t, PairItem *p_b, int) {
+		static_cast<PairLog *>(p_self)->events.push_back(Vector3i(1, p_a->id, p_b->id));
+		return nullptr;
+	}
+	static void unpair(void *p_self, uint32_t, PairItem *p_a, int, uint32_t, PairItem *p_b, int, void *) {
+		static_cast<PairLog *>(p_self)->events.push_back(Vector3i(0, p_a->id, p_b->id));
+	}
+};
+
+static void _run_pairing(bool p_parallel, PairItem *p_items, int p_count, PairLog &r_log) {
+	PairBVH bvh;
+	bvh.params_set_parallel_pairing(p_parallel);
+	bvh.set_pair_callback(PairLog::pair, &r_log);
+	bvh.set_unpair_callback(PairLog::unpair, &r_log);
+
+	LocalVector<BVHHandle> handles;
+	handles.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		AABB aabb(Vector3(i % 64, (i / 64) % 64, i / 4096) * 0.9, Vector3(1, 1, 1));
+		handles[i] = bvh.create(&p_items[i], true, i % 2, 3, aabb);
+	}
+	bvh.update();
+
+	// Move everything so pairs are both made and broken.
+	for (int step = 1; step <= 3; step++) {
+		for (int i = 0; i < p_count; i++) {
+			AABB aabb(Vector3(i % 64, (i / 64) % 64, i / 4096) * 0.9 + Vector3((i % 3) * step, 0, 0), Vector3(1, 1, 1));
+			bvh.move(handles[i], aabb);
+		}
+		bvh.update();
+	}
+
+	for (int i = 0; i < p_count; i++) {
+		bvh.erase(handles[i]);
+	}
+}
+
+TEST_CASE("[BVH] Parallel pairing matches serial pairing") {
+	const int count = 8192;
+	LocalVector<PairItem> items;
+	items.resize(count);
+	for (int i = 0; i < count; i++) {
+		items[i].id = i;
+	}
+
+	PairLog serial;
+	PairLog parallel;
+	_run_pairing(false, items.ptr(), count, serial);
+	_run_pairing(true, items.ptr(), count, parallel);
+
+	CHECK(serial.events.size() > 0);
+	REQUIRE(serial.events.size() == parallel.events.size());
+
+	bool same_order = true;
+	for (uint32_t i = 0; i < serial.events.size(); i++) {
+		same_order = same_order && serial.events[i] == parallel.events[i];
+	}
+	CHECK_MESSAGE(same_order, "Pair callbacks should be sent in the same order.");
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
@@ -295,6 +295,12 @@ TEST_CASE("[Vector] Slice") {
 	Vector<int> slice7 = vector.slice(5, 1);
 	CHECK(slice7.size() == 0); // Expected to fail.
 	ERR_PRINT_ON;
+
+	Vector<int> slice8 = vector.slice(0);
+	CHECK(slice8.ptr() == vector.ptr()); // Whole range shares the buffer.
+	slice8.write[0] = 42;
+	CHECK(slice8[0] == 42);
+	CHECK(vector[0] == 0);
 }
 
 TEST_CASE("[Vector] Find, has") {
@@ -0,0 +1,147 @@
+/*************************************************************************/
+/*  test_editor_file_system.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef TEST_EDITOR_FILE_SYSTEM_H
+#define TEST_EDITOR_FILE_SYSTEM_H
+
+#ifdef TOOLS_ENABLED
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "editor/editor_file_system.h"
+
+#include "tests/test_macros.h"
+
+// Declared in global namespace because EditorFileSystem befriends it.
+class TestEditorFileSystem {
+public:
+	typedef EditorFileSystem::ScannedDirectory ScannedDirectory;
+
+	static void set_valid_extensions(EditorFileSystem *p_efs, const Vector<String> &p_extensions) {
+		p_efs->valid_extensions.clear();
+		for (const String &E : p_extensions) {
+			p_efs->valid_extensions.insert(E);
+		}
+	}
+
+	static void scan(EditorFileSystem *p_efs, ScannedDirectory *p_root, bool p_parallel) {
+		if (p_parallel) {
+			p_efs->_scan_dir_tree_parallel(p_root, EditorFileSystem::ScanProgress());
+		} else {
+			p_efs->_scan_dir_tree(p_root);
+		}
+	}
+
+	static int count_files(const ScannedDirectory *p_dir) {
+		int count = p_dir->files.size();
+		for (const ScannedDirectory *sd : p_dir->subdirs) {
+			count += count_files(sd);
+		}
+		return count;
+	}
+
+	static bool is_same_scan(const ScannedDirectory *p_a, const ScannedDirectory *p_b) {
+		if (p_a->name != p_b->name || p_a->full_path != p_b->full_path || p_a->modified_time != p_b->modified_time) {
+			return false;
+		}
+		if (p_a->files.size() != p_b->files.size() || p_a->subdirs.size() != p_b->subdirs.size()) {
+			return false;
+		}
+		for (int i = 0; i < p_a->files.size(); i++) {
+			const ScannedDirectory::File &fa = p_a->files[i];
+			const ScannedDirectory::File &fb = p_b->files[i];
+			if (fa.name != fb.name || fa.modified_time != fb.modified_time || fa.import_modified_time != fb.import_modified_time) {
+				return false;
+			}
+		}
+		for (int i = 0; i < p_a->subdirs.size(); i++) {
+			if (!is_same_scan(p_a->subdirs[i], p_b->subdirs[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+namespace TestEditorFileSystemScan {
+
+TEST_CASE("[EditorFileSystem] Parallel scan matches sequential scan") {
+	const String root = OS::get_singleton()->get_cache_path().path_join("test_editor_file_system_scan");
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->change_dir(root) == OK) {
+		da->erase_contents_recursive();
+	}
+
+	// Wide enough that the tree is split into subtrees for the worker threads.
+	const int dir_count = 24;
+	const int subdir_count = 3;
+	for (int i = 0; i < dir_count; i++) {
+		for (int j = 0; j < subdir_count; j++) {
+			const String dir = root.path_join(vformat("dir_%d", i)).path_join(vformat("sub_%d", j));
+			REQUIRE(da->make_dir_recursive(dir) == OK);
+			for (const String &file : { "a.tres", "b.txt", "c.skip" }) {
+				Ref<FileAccess> f = FileAccess::open(dir.path_join(file), FileAccess::WRITE);
+				REQUIRE(f.is_valid());
+				f->store_string(file);
+			}
+		}
+	}
+
+	EditorFileSystem *efs = memnew(EditorFileSystem);
+	TestEditorFileSystem::set_valid_extensions(efs, { "tres", "txt" });
+
+	TestEditorFileSystem::ScannedDirectory sequential;
+	sequential.full_path = root;
+	TestEditorFileSystem::scan(efs, &sequential, false);
+
+	TestEditorFileSystem::ScannedDirectory parallel;
+	parallel.full_path = root;
+	TestEditorFileSystem::scan(efs, &parallel, true);
+
+	CHECK_MESSAGE(
+			TestEditorFileSystem::count_files(&sequential) == dir_count * subdir_count * 2,
+			"Only files with a recognized extension should be listed.");
+	CHECK_MESSAGE(
+			TestEditorFileSystem::is_same_scan(&sequential, &parallel),
+			"The merged parallel scan should match the sequential scan.");
+
+	memdelete(efs);
+
+	REQUIRE(da->change_dir(root) == OK);
+	da->erase_contents_recursive();
+}
+
+} // namespace TestEditorFileSystemScan
+
+#endif // TOOLS_ENABLED
+
+#endif // TEST_EDITOR_FILE_SYSTEM_H
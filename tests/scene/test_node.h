@@ -0,0 +1,440 @@
+/*************************************************************************/
+/*  test_node.h                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NODE_H
+#define TEST_NODE_H
+
+#include "scene/main/node.h"
+#include "scene/main/window.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+
+// Declared in global namespace because of GDCLASS macro warning (Windows):
+// "Unqualified friend declaration referring to type outside of the nearest enclosing namespace
+// is a Microsoft extension; add a nested name specifier".
+class _TestProcessGroupNode : public Node {
+	GDCLASS(_TestProcessGroupNode, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_PROCESS) {
+			process_count++;
+			other_accessible = other && other->is_accessible_from_caller_thread();
+			other_readable = other && other->is_readable_from_caller_thread() && other->get_node_or_null(NodePath(".")) == other;
+			if (detached) {
+				detached_accessible = detached->is_accessible_from_caller_thread();
+				detached->set_process(true);
+			}
+			if (deferred_target) {
+				if (free_deferred_target) {
+					deferred_target->call_deferred_thread_group("free");
+				}
+				deferred_target->call_deferred_thread_group("set_meta", "last", tag);
+			}
+		}
+	}
+
+public:
+	int tag = 0;
+	int process_count = 0;
+	Node *other = nullptr;
+	bool other_accessible = true;
+	bool other_readable = false;
+	Node *deferred_target = nullptr;
+	bool free_deferred_target = false;
+	Node *detached = nullptr;
+	bool detached_accessible = false;
+};
+
+class _TestResolveCacheNode : public Node {
+	GDCLASS(_TestResolveCacheNode, Node);
+
+public:
+	bool is_node_path_cached(const NodePath &p_path) const {
+		return _is_node_path_cached(p_path);
+	}
+};
+
+namespace TestNode {
+
+TEST_CASE("[Node] Child lookup by name") {
+	Node *parent = memnew(Node);
+
+	const int child_count = 10000;
+	for (int i = 0; i < child_count; i++) {
+		Node *child = memnew(Node);
+		child->set_name("item_" + itos(i));
+		parent->add_child(child);
+	}
+	CHECK(parent->get_child_count() == child_count);
+
+	Node *item = parent->get_node(NodePath("item_4711"));
+	REQUIRE(item);
+	CHECK(item->get_index() == 4711);
+	CHECK(parent->has_node(NodePath("item_9999")));
+	CHECK_FALSE(parent->has_node(NodePath("item_10000")));
+
+	// Clashing names are made unique.
+	Node *clash = memnew(Node);
+	clash->set_name("item_42");
+	parent->add_child(clash, true);
+	CHECK(clash->get_name() != StringName("item_42"));
+	CHECK(parent->get_node(NodePath(clash->get_name())) == clash);
+	CHECK(parent->get_node(NodePath("item_42"))->get_index() == 42);
+
+	// Renaming and removing keep the lookup in sync.
+	item->set_name("renamed");
+	CHECK(parent->get_node(NodePath("renamed")) == item);
+	CHECK_FALSE(parent->has_node(NodePath("item_4711")));
+
+	parent->remove_child(item);
+	CHECK_FALSE(parent->has_node(NodePath("renamed")));
+	memdelete(item);
+
+	Node *readded = memnew(Node);
+	readded->set_name("item_4711");
+	parent->add_child(readded);
+	CHECK(readded->get_name() == StringName("item_4711"));
+	CHECK(parent->get_node(NodePath("item_4711")) == readded);
+
+	memdelete(parent);
+}
+
+TEST_CASE("[Node] Child lookup by name with siblings sharing the name") {
+	// Scene instantiation doesn't validate names, so build a scene with three children named "dup".
+	Dictionary bundle;
+	bundle["names"] = PackedStringArray({ "Node", "Root", "dup" });
+	bundle["variants"] = Array();
+	bundle["node_count"] = 4;
+	// Parent, owner, type, name, instance, property count, group count.
+	bundle["nodes"] = PackedInt32Array({ -1, -1, 0, 1, -1, 0, 0,
+			0, 0, 0, 2, -1, 0, 0,
+			0, 0, 0, 2, -1, 0, 0,
+			0, 0, 0, 2, -1, 0, 0 });
+	bundle["conn_count"] = 0;
+	bundle["conns"] = PackedInt32Array();
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	scene->set("_bundled", bundle);
+
+	Node *root = scene->instantiate();
+	REQUIRE(root);
+	REQUIRE(root->get_child_count() == 3);
+	Node *first = root->get_child(0);
+	Node *second = root->get_child(1);
+	Node *third = root->get_child(2);
+	CHECK(root->get_node(NodePath("dup")) == first);
+
+	root->remove_child(first);
+	CHECK_MESSAGE(
+			root->get_node(NodePath("dup")) == second,
+			"Removing the first child sharing a name should resolve the name to the next one in order.");
+
+	root->move_child(third, 0);
+	CHECK_MESSAGE(
+			root->get_node(NodePath("dup")) == third,
+			"Moving a child sharing a name first should resolve the name to it.");
+
+	memdelete(first);
+	memdelete(root);
+}
+
+TEST_CASE("[Node] Cached path resolution") {
+	Node *root = memnew(Node);
+	Node *a = memnew(Node);
+	a->set_name("A");
+	root->add_child(a);
+	Node *b = memnew(Node);
+	b->set_name("B");
+	a->add_child(b);
+	Node *c = memnew(Node);
+	c->set_name("C");
+	b->add_child(c);
+
+	const NodePath path("A/B/C");
+	CHECK(root->get_node_or_null(path) == c);
+	CHECK(root->get_node_or_null(path) == c); // Cached.
+	CHECK(c->get_node_or_null(NodePath("../..")) == a);
+
+	b->set_name("X");
+	CHECK_MESSAGE(
+			root->get_node_or_null(path) == nullptr,
+			"Renaming a node should invalidate cached paths going through it.");
+	CHECK(root->get_node_or_null(NodePath("A/X/C")) == c);
+
+	b->set_name("B");
+	CHECK(root->get_node_or_null(path) == c);
+
+	b->remove_child(c);
+	CHECK_MESSAGE(
+			root->get_node_or_null(path) == nullptr,
+			"Removing a node should invalidate cached paths to it.");
+	CHECK(c->get_node_or_null(NodePath("../..")) == nullptr);
+
+	Node *c2 = memnew(Node);
+	c2->set_name("C");
+	b->add_child(c2);
+	CHECK_MESSAGE(
+			root->get_node_or_null(path) == c2,
+			"Adding a node should invalidate cached paths.");
+
+	memdelete(c);
+	memdelete(root);
+}
+
+TEST_CASE("[Node] Cached path resolution survives unrelated changes") {
+	Node *root = memnew(Node);
+	_TestResolveCacheNode *a = memnew(_TestResolveCacheNode);
+	a->set_name("A");
+	root->add_child(a);
+	Node *b = memnew(Node);
+	b->set_name("B");
+	a->add_child(b);
+	Node *c = memnew(Node);
+	c->set_name("C");
+	b->add_child(c);
+	Node *sibling = memnew(Node);
+	sibling->set_name("Sibling");
+	root->add_child(sibling);
+
+	const NodePath path("B/C");
+	CHECK(a->get_node_or_null(path) == c);
+	CHECK(a->is_node_path_cached(path));
+
+	// Churn outside of the subtree the path goes through.
+	for (int i = 0; i < 10; i++) {
+		Node *n = memnew(Node);
+		sibling->add_child(n);
+		sibling->remove_child(n);
+		memdelete(n);
+	}
+	sibling->set_name("Renamed");
+	root->add_child(memnew(Node));
+
+	CHECK_MESSAGE(
+			a->is_node_path_cached(path),
+			"Changes outside the resolved subtree should keep the cached path.");
+	CHECK(a->get_node_or_null(path) == c);
+
+	// Paths going above the node depend on the rest of the tree.
+	const NodePath up_path("../Renamed");
+	CHECK(a->get_node_or_null(up_path) == sibling);
+	sibling->add_child(memnew(Node));
+	CHECK_FALSE(a->is_node_path_cached(up_path));
+	CHECK(a->get_node_or_null(up_path) == sibling);
+
+	c->add_child(memnew(Node));
+	CHECK_FALSE_MESSAGE(
+			a->is_node_path_cached(path),
+			"Changes inside the resolved subtree should drop the cached path.");
+	CHECK(a->get_node_or_null(path) == c);
+
+	memdelete(root);
+}
+
+TEST_CASE("[SceneTree][Node] Group membership") {
+	const int node_count = 100000;
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	LocalVector<Node *> nodes;
+	nodes.resize(node_count);
+	for (int i = 0; i < node_count; i++) {
+		nodes[i] = memnew(Node);
+		nodes[i]->set_name("N" + itos(i));
+		parent->add_child(nodes[i]);
+		nodes[i]->add_to_group("members");
+	}
+
+	List<Node *> members;
+	SceneTree::get_singleton()->get_nodes_in_group("members", &members);
+	CHECK(members.size() == node_count);
+
+	// Remove every other node, the remaining ones stay in tree order.
+	for (int i = 0; i < node_count; i += 2) {
+		nodes[i]->remove_from_group("members");
+	}
+	CHECK_FALSE(nodes[0]->is_in_group("members"));
+
+	members.clear();
+	SceneTree::get_singleton()->get_nodes_in_group("members", &members);
+	REQUIRE(members.size() == node_count / 2);
+	int expected = 1;
+	bool ordered = true;
+	for (const Node *E : members) {
+		ordered = ordered && E == nodes[expected];
+		expected += 2;
+	}
+	CHECK_MESSAGE(ordered, "Group nodes should be in tree order.");
+	CHECK(SceneTree::get_singleton()->get_first_node_in_group("members") == nodes[1]);
+
+	// Churn: join and leave without iterating in between.
+	for (int i = 0; i < node_count; i += 2) {
+		nodes[i]->add_to_group("members");
+		nodes[i + 1]->remove_from_group("members");
+	}
+	members.clear();
+	SceneTree::get_singleton()->get_nodes_in_group("members", &members);
+	REQUIRE(members.size() == node_count / 2);
+	expected = 0;
+	ordered = true;
+	for (const Node *E : members) {
+		ordered = ordered && E == nodes[expected];
+		expected += 2;
+	}
+	CHECK_MESSAGE(ordered, "Group nodes should be sorted again after being reordered.");
+
+	// Leaving the tree removes the nodes from the group.
+	SceneTree::get_singleton()->get_root()->remove_child(parent);
+	CHECK_FALSE(SceneTree::get_singleton()->has_group("members"));
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Node] Process thread groups") {
+	Node *main_node = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(main_node);
+
+	_TestProcessGroupNode *nodes[2];
+	for (int i = 0; i < 2; i++) {
+		Node *owner = memnew(Node);
+		owner->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		owner->set_process_thread_group_order(1 - i);
+		main_node->add_child(owner);
+
+		nodes[i] = memnew(_TestProcessGroupNode);
+		nodes[i]->tag = i;
+		nodes[i]->deferred_target = main_node;
+		nodes[i]->set_process(true);
+		owner->add_child(nodes[i]);
+	}
+	nodes[0]->other = nodes[0]->get_parent();
+	nodes[1]->other = nodes[0];
+
+	CHECK_MESSAGE(
+			nodes[0]->is_accessible_from_caller_thread(),
+			"Nodes should be accessible from the main thread outside of processing.");
+
+	SceneTree::get_singleton()->process(0.0);
+
+	CHECK(nodes[0]->process_count == 1);
+	CHECK(nodes[1]->process_count == 1);
+	CHECK_MESSAGE(
+			nodes[0]->other_accessible,
+			"Nodes of the same thread group should be accessible while processing.");
+	CHECK_FALSE_MESSAGE(
+			nodes[1]->other_accessible,
+			"Nodes of other thread groups should not be accessible while processing.");
+	CHECK_MESSAGE(
+			nodes[1]->other_readable,
+			"Nodes of other thread groups should be readable while processing.");
+	CHECK_MESSAGE(
+			int(main_node->get_meta("last")) == 0,
+			"Deferred calls should be flushed in thread group order.");
+
+	// Leaving the thread group processes the node on the main thread again.
+	nodes[1]->get_parent()->set_process_thread_group(Node::PROCESS_THREAD_GROUP_INHERIT);
+	SceneTree::get_singleton()->process(0.0);
+
+	CHECK(nodes[1]->process_count == 2);
+	CHECK_MESSAGE(
+			nodes[1]->other_accessible,
+			"The main thread should be able to access every node once the thread groups are done.");
+	CHECK_MESSAGE(
+			int(main_node->get_meta("last")) == 1,
+			"Deferred calls from the main thread should run after the thread group ones.");
+
+	memdelete(main_node);
+}
+
+TEST_CASE("[SceneTree][Node] Process thread groups and nodes outside the tree") {
+	Node *owner = memnew(Node);
+	owner->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	SceneTree::get_singleton()->get_root()->add_child(owner);
+
+	_TestProcessGroupNode *node = memnew(_TestProcessGroupNode);
+	node->detached = memnew(Node);
+	node->deferred_target = memnew(Node);
+	node->free_deferred_target = true;
+	node->set_process(true);
+	owner->add_child(node);
+
+	ObjectID target_id = node->deferred_target->get_instance_id();
+	SceneTree::get_singleton()->process(0.0);
+
+	CHECK_MESSAGE(
+			node->detached_accessible,
+			"Nodes outside the tree should be accessible from thread groups.");
+	CHECK_MESSAGE(
+			node->detached->is_processing(),
+			"Thread groups should be able to set up nodes before adding them to the tree.");
+	CHECK_MESSAGE(
+			ObjectDB::get_instance(target_id) == nullptr,
+			"Deferred calls to a freed object should be skipped.");
+
+	memdelete(node->detached);
+	memdelete(owner);
+}
+
+TEST_CASE("[SceneTree][Node] Process thread group order follows the tree") {
+	Node *main_node = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(main_node);
+
+	Node *owners[2];
+	for (int i = 0; i < 2; i++) {
+		owners[i] = memnew(Node);
+		owners[i]->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		main_node->add_child(owners[i]);
+
+		_TestProcessGroupNode *node = memnew(_TestProcessGroupNode);
+		node->tag = i;
+		node->deferred_target = main_node;
+		node->set_process(true);
+		owners[i]->add_child(node);
+	}
+
+	SceneTree::get_singleton()->process(0.0);
+	CHECK_MESSAGE(
+			int(main_node->get_meta("last")) == 1,
+			"Thread groups with the same order should be flushed in tree order.");
+
+	main_node->move_child(owners[1], 0);
+	SceneTree::get_singleton()->process(0.0);
+	CHECK_MESSAGE(
+			int(main_node->get_meta("last")) == 0,
+			"Moving a thread group in the tree should update the flush order.");
+
+	memdelete(main_node);
+}
+
+} // namespace TestNode
+
+#endif // TEST_NODE_H
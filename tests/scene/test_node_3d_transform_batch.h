@@ -0,0 +1,208 @@
+/*************************************************************************/
+/*  test_node_3d_transform_batch.h                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NODE_3D_TRANSFORM_BATCH_H
+#define TEST_NODE_3D_TRANSFORM_BATCH_H
+
+#include "core/config/project_settings.h"
+#include "core/object/message_queue.h"
+#include "scene/3d/node_3d.h"
+#include "scene/3d/node_3d_transform_batch.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+// Declared in global namespace because of GDCLASS macro warning (Windows).
+class _TestTransformCounter3D : public Node3D {
+	GDCLASS(_TestTransformCounter3D, Node3D);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_TRANSFORM_CHANGED) {
+			count++;
+		}
+	}
+
+public:
+	int count = 0;
+
+	// Same as RigidBody3D applying the state from the physics server.
+	void set_state_transform(const Transform3D &p_transform) {
+		set_ignore_transform_notification(true);
+		set_global_transform(p_transform);
+		set_ignore_transform_notification(false);
+	}
+
+	_TestTransformCounter3D() {
+		set_notify_transform(true);
+	}
+};
+
+namespace TestNode3DTransformBatch {
+
+TEST_CASE("[Node3DTransformBatch] Global transforms") {
+	// The nodes are only used as notification targets, they stay outside of the tree.
+	Node3D *nodes[5];
+	for (int i = 0; i < 5; i++) {
+		nodes[i] = memnew(Node3D);
+	}
+
+	Node3DTransformBatch batch;
+	const Transform3D offset = Transform3D(Basis(), Vector3(1, 0, 0));
+	uint32_t root = batch.add(nodes[0], 0xFFFFFFFF, offset, false, false);
+	uint32_t child = batch.add(nodes[1], root, offset, false, false);
+	uint32_t grandchild = batch.add(nodes[2], child, offset, false, false);
+	uint32_t top_level = batch.add(nodes[3], child, offset, true, false);
+	uint32_t sibling = batch.add(nodes[4], child, offset, false, false);
+
+	// Dirty ancestors are composed on read.
+	CHECK(batch.get_global(grandchild).origin.is_equal_approx(Vector3(3, 0, 0)));
+	CHECK(batch.get_global(top_level).origin.is_equal_approx(Vector3(1, 0, 0)));
+
+	batch.flush();
+	CHECK(batch.get_global(child).origin.is_equal_approx(Vector3(2, 0, 0)));
+	CHECK(batch.get_global(grandchild).origin.is_equal_approx(Vector3(3, 0, 0)));
+
+	// Moving the root affects the whole subtree, except top level nodes.
+	batch.set_local(root, Transform3D(Basis(), Vector3(10, 0, 0)));
+	CHECK(batch.get_global(grandchild).origin.is_equal_approx(Vector3(12, 0, 0)));
+	// The ancestors were cached by the previous read, the sibling must still be composed again.
+	CHECK(batch.get_global(sibling).origin.is_equal_approx(Vector3(12, 0, 0)));
+	batch.set_local(child, Transform3D(Basis(), Vector3(2, 0, 0)));
+	CHECK(batch.get_global(grandchild).origin.is_equal_approx(Vector3(13, 0, 0)));
+	CHECK(batch.get_global(sibling).origin.is_equal_approx(Vector3(13, 0, 0)));
+	batch.set_local(child, offset);
+	batch.flush();
+	CHECK(batch.get_global(grandchild).origin.is_equal_approx(Vector3(12, 0, 0)));
+	CHECK(batch.get_global(top_level).origin.is_equal_approx(Vector3(1, 0, 0)));
+
+	batch.set_top_level(top_level, false);
+	batch.flush();
+	CHECK(batch.get_global(top_level).origin.is_equal_approx(Vector3(12, 0, 0)));
+
+	batch.set_local(child, Transform3D(Basis().scaled(Vector3(2, 2, 2)), Vector3(1, 0, 0)));
+	batch.set_disable_scale(grandchild, true);
+	batch.flush();
+	CHECK(batch.get_global(grandchild).basis.get_scale().is_equal_approx(Vector3(1, 1, 1)));
+	CHECK(batch.get_global(grandchild).origin.is_equal_approx(Vector3(13, 0, 0)));
+
+	batch.remove(sibling);
+	batch.remove(top_level);
+	batch.remove(grandchild);
+	batch.remove(child);
+	batch.remove(root);
+	CHECK(batch.get_node_count() == 0);
+
+	for (int i = 0; i < 5; i++) {
+		memdelete(nodes[i]);
+	}
+}
+
+TEST_CASE("[Node3DTransformBatch] Wide levels") {
+	// Large enough for levels to be updated on the WorkerThreadPool.
+	const int count = 4096;
+	Node3D *root_node = memnew(Node3D);
+	LocalVector<Node3D *> nodes;
+	LocalVector<uint32_t> slots;
+	nodes.resize(count);
+	slots.resize(count);
+
+	Node3DTransformBatch batch;
+	uint32_t root = batch.add(root_node, 0xFFFFFFFF, Transform3D(), false, false);
+	for (int i = 0; i < count; i++) {
+		nodes[i] = memnew(Node3D);
+		slots[i] = batch.add(nodes[i], root, Transform3D(Basis(), Vector3(0, i, 0)), false, false);
+	}
+	batch.flush();
+
+	batch.set_local(root, Transform3D(Basis(), Vector3(5, 0, 0)));
+	batch.flush();
+
+	bool all_updated = true;
+	for (int i = 0; i < count; i++) {
+		all_updated = all_updated && batch.get_global(slots[i]).origin.is_equal_approx(Vector3(5, i, 0));
+	}
+	CHECK(all_updated);
+
+	for (int i = 0; i < count; i++) {
+		batch.remove(slots[i]);
+		memdelete(nodes[i]);
+	}
+	batch.remove(root);
+	memdelete(root_node);
+}
+
+TEST_CASE("[SceneTree][Node3DTransformBatch] Ignored transform notifications") {
+	// The batch is created along with the tree, so replace the test tree with one that uses it.
+	SceneTree::get_singleton()->finalize();
+	MessageQueue::get_singleton()->flush();
+	memdelete(SceneTree::get_singleton());
+	ProjectSettings::get_singleton()->set_setting("application/run/batch_3d_transforms", true);
+	memnew(SceneTree);
+	SceneTree::get_singleton()->initialize();
+	ProjectSettings::get_singleton()->set_setting("application/run/batch_3d_transforms", false);
+	REQUIRE(SceneTree::get_singleton()->get_transform_batch_3d());
+
+	_TestTransformCounter3D *body = memnew(_TestTransformCounter3D);
+	_TestTransformCounter3D *child = memnew(_TestTransformCounter3D);
+	body->add_child(child);
+	SceneTree::get_singleton()->get_root()->add_child(body);
+	SceneTree::get_singleton()->flush_transform_notifications();
+	body->count = 0;
+	child->count = 0;
+
+	body->set_state_transform(Transform3D(Basis(), Vector3(1, 0, 0)));
+	SceneTree::get_singleton()->flush_transform_notifications();
+	CHECK(body->count == 0);
+	CHECK(child->count == 1);
+	CHECK(child->get_global_transform().origin.is_equal_approx(Vector3(1, 0, 0)));
+
+	// Reading a global transform before the flush caches it, but doesn't skip the notification.
+	child->set_position(Vector3(0, 1, 0));
+	CHECK(child->get_global_transform().origin.is_equal_approx(Vector3(1, 1, 0)));
+	SceneTree::get_singleton()->flush_transform_notifications();
+	CHECK(child->count == 2);
+	child->set_position(Vector3());
+	SceneTree::get_singleton()->flush_transform_notifications();
+	child->count = 0;
+
+	// A regular change in the same frame still notifies.
+	body->set_state_transform(Transform3D(Basis(), Vector3(2, 0, 0)));
+	body->set_position(Vector3(3, 0, 0));
+	SceneTree::get_singleton()->flush_transform_notifications();
+	CHECK(body->count == 1);
+	CHECK(child->count == 1);
+
+	memdelete(body);
+}
+
+} // namespace TestNode3DTransformBatch
+
+#endif // TEST_NODE_3D_TRANSFORM_BATCH_H
@@ -0,0 +1,101 @@
+/*************************************************************************/
+/*  test_packed_scene.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PACKED_SCENE_H
+#define TEST_PACKED_SCENE_H
+
+#include "scene/2d/node_2d.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedScene {
+
+TEST_CASE("[PackedScene] Batch instantiation") {
+	Node2D *root = memnew(Node2D);
+	root->set_name("Root");
+	root->set_position(Vector2(4, 8));
+	root->add_to_group("batched", true);
+
+	Node2D *child = memnew(Node2D);
+	child->set_name("Child");
+	child->set_rotation(0.5);
+	root->add_child(child);
+	child->set_owner(root);
+
+	Node *leaf = memnew(Node);
+	leaf->set_name("Leaf");
+	child->add_child(leaf);
+	leaf->set_owner(root);
+
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	CHECK(scene->pack(root) == OK);
+	memdelete(root);
+
+	SUBCASE("Copies match instantiate()") {
+		Vector<Node *> copies = scene->instantiate_batch(16);
+		REQUIRE(copies.size() == 16);
+
+		for (int i = 0; i < copies.size(); i++) {
+			Node2D *copy = Object::cast_to<Node2D>(copies[i]);
+			REQUIRE(copy);
+			CHECK(copy->get_name() == "Root");
+			CHECK(copy->get_position() == Vector2(4, 8));
+			CHECK(copy->is_in_group("batched"));
+
+			Node2D *copy_child = Object::cast_to<Node2D>(copy->get_node_or_null(NodePath("Child")));
+			REQUIRE(copy_child);
+			CHECK(copy_child->get_rotation() == doctest::Approx(0.5));
+			CHECK(copy_child->get_owner() == copy);
+
+			Node *copy_leaf = copy->get_node_or_null(NodePath("Child/Leaf"));
+			REQUIRE(copy_leaf);
+			CHECK(copy_leaf->get_owner() == copy);
+
+			// Every copy owns its own nodes.
+			if (i > 0) {
+				CHECK(copy_child != copies[i - 1]->get_child(0));
+			}
+		}
+
+		for (int i = 0; i < copies.size(); i++) {
+			memdelete(copies[i]);
+		}
+	}
+
+	SUBCASE("Empty batch") {
+		CHECK(scene->instantiate_batch(0).is_empty());
+	}
+}
+
+} // namespace TestPackedScene
+
+#endif // TEST_PACKED_SCENE_H
@@ -0,0 +1,153 @@
+/*************************************************************************/
+/*  test_scene_pool.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_SCENE_POOL_H
+#define TEST_SCENE_POOL_H
+
+#include "scene/2d/node_2d.h"
+#include "scene/main/scene_pool.h"
+#include "scene/main/window.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+
+namespace TestScenePool {
+
+static Ref<PackedScene> _make_scene() {
+	Node2D *root = memnew(Node2D);
+	root->set_name("Root");
+	root->set_position(Vector2(1, 2));
+	root->add_to_group("scene_group", true);
+
+	Ref<Resource> local_res;
+	local_res.instantiate();
+	local_res->set_name("local");
+	local_res->set_local_to_scene(true);
+	root->set_meta("local_res", local_res);
+
+	Node2D *child = memnew(Node2D);
+	child->set_name("Child");
+	root->add_child(child);
+	child->set_owner(root);
+
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	scene->pack(root);
+	memdelete(root);
+	return scene;
+}
+
+TEST_CASE("[ScenePool] Acquire and release") {
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(_make_scene());
+
+	Node2D *instance = Object::cast_to<Node2D>(pool->acquire());
+	REQUIRE(instance);
+	CHECK(pool->get_hit_count() == 0);
+	CHECK(pool->get_miss_count() == 1);
+
+	Ref<Resource> local_res = instance->get_meta("local_res");
+	REQUIRE(local_res.is_valid());
+	local_res->set_name("modified");
+
+	instance->set_position(Vector2(10, 20));
+	instance->add_to_group("runtime_group");
+	Node2D *child = Object::cast_to<Node2D>(instance->get_node(NodePath("Child")));
+	child->set_visible(false);
+	Node *runtime_child = memnew(Node);
+	child->add_child(runtime_child);
+	Node *owned_runtime_child = memnew(Node);
+	instance->add_child(owned_runtime_child);
+	owned_runtime_child->set_owner(instance);
+
+	CHECK(pool->release(instance));
+	CHECK(pool->get_available_count() == 1);
+
+	// The same instance comes back, reset to its scene values.
+	CHECK(pool->acquire() == instance);
+	CHECK(pool->get_hit_count() == 1);
+	CHECK(pool->get_miss_count() == 1);
+	CHECK(pool->get_available_count() == 0);
+	CHECK(instance->get_position() == Vector2(1, 2));
+	CHECK(child->is_visible());
+	CHECK(child->get_child_count() == 0);
+	CHECK(instance->get_child_count() == 1);
+
+	// Local to scene resources are duplicated again instead of keeping the changes.
+	Ref<Resource> recycled_res = instance->get_meta("local_res");
+	REQUIRE(recycled_res.is_valid());
+	CHECK(recycled_res != local_res);
+	CHECK(recycled_res->get_name() == "local");
+	CHECK(recycled_res->get_local_scene() == instance);
+	CHECK_FALSE(instance->is_in_group("runtime_group"));
+	CHECK(instance->is_in_group("scene_group"));
+
+	// Instances that lost scene nodes can't be reused.
+	child->set_name("Renamed");
+	CHECK_FALSE(pool->release(instance));
+	CHECK(pool->get_available_count() == 0);
+
+	SUBCASE("Max size") {
+		pool->set_max_size(2);
+		pool->prewarm(8);
+		CHECK(pool->get_available_count() == 2);
+		CHECK(pool->release(pool->acquire()));
+		CHECK(pool->get_available_count() == 2);
+	}
+}
+
+TEST_CASE("[SceneTree][ScenePool] Recycle on queue_free") {
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(_make_scene());
+	pool->set_recycle_on_free(true);
+
+	Node *instance = pool->acquire();
+	SceneTree::get_singleton()->get_root()->add_child(instance);
+	instance->queue_delete();
+	SceneTree::get_singleton()->process(0.0);
+
+	CHECK(pool->get_available_count() == 1);
+	CHECK_FALSE(instance->is_inside_tree());
+	CHECK_FALSE(instance->is_queued_for_deletion());
+	CHECK(pool->acquire() == instance);
+
+	// Without the flag, queue_delete() deletes the node as usual.
+	pool->set_recycle_on_free(false);
+	SceneTree::get_singleton()->get_root()->add_child(instance);
+	instance->queue_delete();
+	SceneTree::get_singleton()->process(0.0);
+	CHECK(pool->get_available_count() == 0);
+}
+
+} // namespace TestScenePool
+
+#endif // TEST_SCENE_POOL_H
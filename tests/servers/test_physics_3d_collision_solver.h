@@ -0,0 +1,154 @@
+/*************************************************************************/
+/*  test_physics_3d_collision_solver.h                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PHYSICS_3D_COLLISION_SOLVER_H
+#define TEST_PHYSICS_3D_COLLISION_SOLVER_H
+
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_3d/godot_collision_solver_3d_sat.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysics3DCollisionSolver {
+
+struct Contacts {
+	LocalVector<Vector3> points_A;
+	LocalVector<Vector3> points_B;
+
+	static void add(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, void *p_userdata) {
+		Contacts *contacts = static_cast<Contacts *>(p_userdata);
+		contacts->points_A.push_back(p_point_A);
+		contacts->points_B.push_back(p_point_B);
+	}
+};
+
+GodotShape3D *create_capsule(real_t p_radius, real_t p_height) {
+	Dictionary d;
+	d["radius"] = p_radius;
+	d["height"] = p_height;
+	GodotShape3D *capsule = memnew(GodotCapsuleShape3D);
+	capsule->set_data(d);
+	return capsule;
+}
+
+TEST_CASE("[Physics3D] Sphere contacts") {
+	GodotShape3D *sphere = memnew(GodotSphereShape3D);
+	sphere->set_data(1.0);
+
+	Contacts contacts;
+	CHECK(GodotCollisionSolver3D::solve_static(sphere, Transform3D(), sphere, Transform3D(Basis(), Vector3(1.5, 0, 0)), Contacts::add, &contacts));
+	REQUIRE(contacts.points_A.size() == 1);
+	CHECK(contacts.points_A[0].is_equal_approx(Vector3(1, 0, 0)));
+	CHECK(contacts.points_B[0].is_equal_approx(Vector3(0.5, 0, 0)));
+
+	CHECK_FALSE(GodotCollisionSolver3D::solve_static(sphere, Transform3D(), sphere, Transform3D(Basis(), Vector3(2.5, 0, 0)), Contacts::add, &contacts));
+	CHECK_MESSAGE(
+			GodotCollisionSolver3D::solve_static(sphere, Transform3D(), sphere, Transform3D(Basis(), Vector3(2.5, 0, 0)), nullptr, nullptr, nullptr, 0.3, 0.3),
+			"Margins should grow the spheres.");
+
+	// Agrees with the SAT solver.
+	Contacts sat_contacts;
+	Transform3D transform_B(Basis(Vector3(0, 1, 0), 0.3), Vector3(0.4, 1.2, -0.7));
+	contacts.points_A.clear();
+	contacts.points_B.clear();
+	CHECK(GodotCollisionSolver3D::solve_static(sphere, Transform3D(), sphere, transform_B, Contacts::add, &contacts));
+	CHECK(sat_calculate_penetration(sphere, Transform3D(), sphere, transform_B, Contacts::add, &sat_contacts));
+	REQUIRE(contacts.points_A.size() == sat_contacts.points_A.size());
+	CHECK(contacts.points_A[0].is_equal_approx(sat_contacts.points_A[0]));
+	CHECK(contacts.points_B[0].is_equal_approx(sat_contacts.points_B[0]));
+
+	memdelete(sphere);
+}
+
+TEST_CASE("[Physics3D] Sphere and box contacts") {
+	GodotShape3D *sphere = memnew(GodotSphereShape3D);
+	sphere->set_data(0.5);
+	GodotShape3D *box = memnew(GodotBoxShape3D);
+	box->set_data(Vector3(1, 1, 1));
+
+	// Rotated so the sphere faces an edge, the closest point is at x = sqrt(2).
+	Transform3D box_transform(Basis(Vector3(0, 1, 0), Math_PI / 4.0), Vector3());
+	Contacts contacts;
+	CHECK(GodotCollisionSolver3D::solve_static(sphere, Transform3D(Basis(), Vector3(1.8, 0, 0)), box, box_transform, Contacts::add, &contacts));
+	REQUIRE(contacts.points_A.size() == 1);
+	CHECK(contacts.points_A[0].is_equal_approx(Vector3(1.3, 0, 0)));
+	CHECK(contacts.points_B[0].is_equal_approx(Vector3(Math_SQRT2, 0, 0)));
+	CHECK_FALSE(GodotCollisionSolver3D::solve_static(sphere, Transform3D(Basis(), Vector3(2.0, 0, 0)), box, box_transform, Contacts::add, &contacts));
+
+	// Center inside the box, pushed out through the closest face. Swapped shapes swap the points.
+	contacts.points_A.clear();
+	contacts.points_B.clear();
+	CHECK(GodotCollisionSolver3D::solve_static(box, Transform3D(), sphere, Transform3D(Basis(), Vector3(0.2, 0.8, 0)), Contacts::add, &contacts));
+	REQUIRE(contacts.points_A.size() == 1);
+	CHECK(contacts.points_A[0].is_equal_approx(Vector3(0.2, 1, 0)));
+	CHECK(contacts.points_B[0].is_equal_approx(Vector3(0.2, 0.3, 0)));
+
+	// Scaled transforms fall back to SAT.
+	CHECK(GodotCollisionSolver3D::solve_static(sphere, Transform3D(Basis().scaled(Vector3(2, 2, 2)), Vector3(2.2, 0, 0)), box, Transform3D(), nullptr, nullptr));
+
+	memdelete(box);
+	memdelete(sphere);
+}
+
+TEST_CASE("[Physics3D] Capsule contacts") {
+	GodotShape3D *capsule = create_capsule(0.5, 3.0);
+	GodotShape3D *sphere = memnew(GodotSphereShape3D);
+	sphere->set_data(0.5);
+
+	Contacts contacts;
+	CHECK(GodotCollisionSolver3D::solve_static(sphere, Transform3D(Basis(), Vector3(0.8, 0.7, 0)), capsule, Transform3D(), Contacts::add, &contacts));
+	REQUIRE(contacts.points_A.size() == 1);
+	CHECK(contacts.points_A[0].is_equal_approx(Vector3(0.3, 0.7, 0)));
+	CHECK(contacts.points_B[0].is_equal_approx(Vector3(0.5, 0.7, 0)));
+	CHECK_FALSE(GodotCollisionSolver3D::solve_static(sphere, Transform3D(Basis(), Vector3(0, 2.6, 0)), capsule, Transform3D(), nullptr, nullptr));
+
+	// Parallel capsules rest on each other at both ends of the overlap.
+	contacts.points_A.clear();
+	contacts.points_B.clear();
+	CHECK(GodotCollisionSolver3D::solve_static(capsule, Transform3D(), capsule, Transform3D(Basis(), Vector3(0.8, 0.5, 0)), Contacts::add, &contacts));
+	REQUIRE(contacts.points_A.size() == 2);
+	CHECK(contacts.points_A[0].is_equal_approx(Vector3(0.5, 1, 0)));
+	CHECK(contacts.points_A[1].is_equal_approx(Vector3(0.5, -0.5, 0)));
+
+	// Crossed capsules touch at a single point.
+	contacts.points_A.clear();
+	contacts.points_B.clear();
+	CHECK(GodotCollisionSolver3D::solve_static(capsule, Transform3D(), capsule, Transform3D(Basis(Vector3(1, 0, 0), Math_PI / 2.0), Vector3(0.8, 0, 0)), Contacts::add, &contacts));
+	REQUIRE(contacts.points_A.size() == 1);
+	CHECK(contacts.points_A[0].is_equal_approx(Vector3(0.5, 0, 0)));
+	CHECK(contacts.points_B[0].is_equal_approx(Vector3(0.3, 0, 0)));
+
+	memdelete(sphere);
+	memdelete(capsule);
+}
+
+} // namespace TestPhysics3DCollisionSolver
+
+#endif // TEST_PHYSICS_3D_COLLISION_SOLVER_H
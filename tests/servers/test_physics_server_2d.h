@@ -0,0 +1,343 @@
+/*************************************************************************/
+/*  test_physics_server_2d.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "core/os/os.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+static void count_state_sync(void *p_instance, PhysicsDirectBodyState2D *p_state) {
+	(*(int *)p_instance)++;
+}
+
+// Hashes the state of the bodies, to compare two runs of a simulation tick by tick.
+static uint32_t hash_bodies_state(PhysicsServer2D *p_server, const Vector<RID> &p_bodies) {
+	uint32_t h = HASH_MURMUR3_SEED;
+	for (int i = 0; i < p_bodies.size(); i++) {
+		const Transform2D transform = p_server->body_get_state(p_bodies[i], PhysicsServer2D::BODY_STATE_TRANSFORM);
+		const Vector2 linear_velocity = p_server->body_get_state(p_bodies[i], PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+		const real_t angular_velocity = p_server->body_get_state(p_bodies[i], PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY);
+		for (int j = 0; j < 3; j++) {
+			h = hash_murmur3_one_real(transform.columns[j].x, h);
+			h = hash_murmur3_one_real(transform.columns[j].y, h);
+		}
+		h = hash_murmur3_one_real(linear_velocity.x, h);
+		h = hash_murmur3_one_real(linear_velocity.y, h);
+		h = hash_murmur3_one_real(angular_velocity, h);
+	}
+	return hash_fmix32(h);
+}
+
+// Simulates a few stacks of boxes toppling over, and returns the hash of the world state after each tick.
+// The bodies are always created in the same order, but are added to the space in a different one when p_reorder is true.
+static LocalVector<uint32_t> record_replay(bool p_reorder) {
+	PhysicsServer2D *server = PhysicsServer2D::get_singleton();
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+	server->space_set_param(space, PhysicsServer2D::SPACE_PARAM_DETERMINISTIC, 1);
+
+	if (p_reorder) {
+		// Leaves the broadphase with a different allocation history.
+		RID dummy_shape = server->circle_shape_create();
+		server->shape_set_data(dummy_shape, 50);
+		for (int i = 0; i < 10; i++) {
+			RID dummy = server->body_create();
+			server->body_add_shape(dummy, dummy_shape);
+			server->body_set_state(dummy, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(i * 30, 0)));
+			server->body_set_space(dummy, space);
+			server->free(dummy);
+		}
+		server->free(dummy_shape);
+	}
+
+	RID floor_shape = server->rectangle_shape_create();
+	server->shape_set_data(floor_shape, Vector2(1000, 10));
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 10)));
+
+	RID box_shape = server->rectangle_shape_create();
+	server->shape_set_data(box_shape, Vector2(5, 5));
+	Vector<RID> boxes;
+	for (int stack = 0; stack < 6; stack++) {
+		for (int i = 0; i < 10; i++) {
+			RID box = server->body_create();
+			server->body_add_shape(box, box_shape);
+			// Slightly offset and rotated, so that the stacks fall into each other.
+			server->body_set_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(i * 0.05, Vector2(stack * 12 + i * 1.5, -i * 11 - 6)));
+			boxes.push_back(box);
+		}
+	}
+
+	server->body_set_space(floor, space);
+	for (int i = 0; i < boxes.size(); i++) {
+		server->body_set_space(boxes[p_reorder ? boxes.size() - 1 - i : i], space);
+	}
+
+	LocalVector<uint32_t> hashes;
+	for (int tick = 0; tick < 180; tick++) {
+		if (tick == 60) {
+			// Input recorded in the replay.
+			server->body_apply_central_impulse(boxes[5], Vector2(200, -100));
+		}
+		server->step(1.0 / 60.0);
+		server->flush_queries();
+		hashes.push_back(hash_bodies_state(server, boxes));
+	}
+
+	for (int i = 0; i < boxes.size(); i++) {
+		server->free(boxes[i]);
+	}
+	server->free(box_shape);
+	server->free(floor);
+	server->free(floor_shape);
+	server->free(space);
+
+	return hashes;
+}
+
+TEST_CASE("[SceneTree][Physics2D] Bodies integrated in parallel") {
+	PhysicsServer2D *server = PhysicsServer2D::get_singleton();
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID floor_shape = server->rectangle_shape_create();
+	server->shape_set_data(floor_shape, Vector2(1000, 10));
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 110)));
+	server->body_set_space(floor, space);
+
+	RID ball_shape = server->circle_shape_create();
+	server->shape_set_data(ball_shape, 5);
+	const int ball_count = 200;
+	Vector<RID> balls;
+	for (int i = 0; i < ball_count; i++) {
+		RID ball = server->body_create();
+		server->body_add_shape(ball, ball_shape);
+		server->body_set_state(ball, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(i * 11 - ball_count * 5, 0)));
+		server->body_set_space(ball, space);
+		balls.push_back(ball);
+	}
+
+	int sync_count = 0;
+	server->body_set_state_sync_callback(balls[0], &sync_count, count_state_sync);
+
+	for (int i = 0; i < 300; i++) {
+		server->step(1.0 / 60.0);
+		server->flush_queries();
+	}
+
+	bool resting = true;
+	for (int i = 0; i < ball_count; i++) {
+		const Transform2D transform = server->body_get_state(balls[i], PhysicsServer2D::BODY_STATE_TRANSFORM);
+		if (!Math::is_equal_approx(transform.get_origin().x, real_t(i * 11 - ball_count * 5), real_t(0.1)) || Math::abs(transform.get_origin().y - 95) > 1) {
+			resting = false;
+			break;
+		}
+	}
+	CHECK_MESSAGE(resting, "All the balls should fall straight down and rest on the floor.");
+	CHECK_MESSAGE(sync_count > 0, "The state of the moving ball should be synchronized.");
+	CHECK_MESSAGE(bool(server->body_get_state(balls[0], PhysicsServer2D::BODY_STATE_SLEEPING)), "Resting balls should fall asleep.");
+
+	for (int i = 0; i < ball_count; i++) {
+		server->free(balls[i]);
+	}
+	server->free(ball_shape);
+	server->free(floor);
+	server->free(floor_shape);
+	server->free(space);
+}
+
+TEST_CASE("[SceneTree][Physics2D] Batched queries") {
+	PhysicsServer2D *server = PhysicsServer2D::get_singleton();
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID shape = server->circle_shape_create();
+	server->shape_set_data(shape, 10);
+	Vector<RID> bodies;
+	for (int i = 0; i < 20; i++) {
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer2D::BODY_MODE_STATIC);
+		server->body_add_shape(body, shape);
+		server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(i * 50, i * 5)));
+		server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+	server->step(1.0 / 60.0);
+	server->flush_queries();
+
+	PhysicsDirectSpaceState2D *state = server->space_get_direct_state(space);
+	REQUIRE(state);
+
+	// Every other ray and point misses.
+	const int query_count = 2000;
+	LocalVector<Vector2> from;
+	LocalVector<Vector2> to;
+	for (int i = 0; i < query_count; i++) {
+		const real_t x = (i % 40) * 25 + (i / 40) * real_t(0.1);
+		from.push_back(Vector2(x, -100));
+		to.push_back(Vector2(x, 200));
+	}
+
+	PhysicsDirectSpaceState2D::RayParameters ray_parameters;
+	LocalVector<PhysicsDirectSpaceState2D::RayResult> ray_results;
+	ray_results.resize(query_count);
+	LocalVector<bool> ray_hits;
+	ray_hits.resize(query_count);
+	state->intersect_rays(ray_parameters, from.ptr(), to.ptr(), query_count, ray_results.ptr(), ray_hits.ptr());
+
+	PhysicsDirectSpaceState2D::PointParameters point_parameters;
+	LocalVector<PhysicsDirectSpaceState2D::ShapeResult> point_results;
+	point_results.resize(query_count);
+	LocalVector<bool> point_hits;
+	point_hits.resize(query_count);
+	LocalVector<Vector2> positions;
+	for (int i = 0; i < query_count; i++) {
+		positions.push_back(Vector2(from[i].x, (i % 40) / 2 * 5));
+	}
+	state->intersect_points(point_parameters, positions.ptr(), query_count, point_results.ptr(), point_hits.ptr());
+
+	int ray_mismatches = 0;
+	int point_mismatches = 0;
+	int hit_count = 0;
+	for (int i = 0; i < query_count; i++) {
+		ray_parameters.from = from[i];
+		ray_parameters.to = to[i];
+		PhysicsDirectSpaceState2D::RayResult ray_result;
+		const bool ray_hit = state->intersect_ray(ray_parameters, ray_result);
+		if (ray_hit != ray_hits[i] || (ray_hit && (ray_result.rid != ray_results[i].rid || !ray_result.position.is_equal_approx(ray_results[i].position)))) {
+			ray_mismatches++;
+		}
+		hit_count += ray_hit;
+
+		point_parameters.position = positions[i];
+		PhysicsDirectSpaceState2D::ShapeResult point_result;
+		const bool point_hit = state->intersect_point(point_parameters, &point_result, 1) > 0;
+		if (point_hit != point_hits[i] || (point_hit && point_result.rid != point_results[i].rid)) {
+			point_mismatches++;
+		}
+	}
+	CHECK_MESSAGE(hit_count == query_count / 2, "Half of the rays should hit a body.");
+	CHECK_MESSAGE(ray_mismatches == 0, "Batched rays should match single rays.");
+	CHECK_MESSAGE(point_mismatches == 0, "Batched points should match single points.");
+
+	for (int i = 0; i < bodies.size(); i++) {
+		server->free(bodies[i]);
+	}
+	server->free(shape);
+	server->free(space);
+}
+
+TEST_CASE("[SceneTree][Physics2D] Deterministic replay") {
+	const LocalVector<uint32_t> recorded = record_replay(false);
+	const LocalVector<uint32_t> replayed = record_replay(true);
+	REQUIRE(recorded.size() == replayed.size());
+
+	int first_divergent_tick = -1;
+	for (uint32_t tick = 0; tick < recorded.size(); tick++) {
+		if (recorded[tick] != replayed[tick]) {
+			first_divergent_tick = tick;
+			break;
+		}
+	}
+	CHECK_MESSAGE(recorded[0] != recorded[recorded.size() - 1], "The boxes should move during the replay.");
+	CHECK_MESSAGE(first_divergent_tick == -1, "The replay should give the same world state on every tick.");
+}
+
+TEST_CASE("[Stress][SceneTree][Physics2D] Bullet hell") {
+	PhysicsServer2D *server = PhysicsServer2D::get_singleton();
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	// Bullets don't collide with each other, only with the player.
+	RID player_shape = server->circle_shape_create();
+	server->shape_set_data(player_shape, 20);
+	RID player = server->body_create();
+	server->body_set_mode(player, PhysicsServer2D::BODY_MODE_KINEMATIC);
+	server->body_add_shape(player, player_shape);
+	server->body_set_collision_layer(player, 2);
+	server->body_set_space(player, space);
+
+	RID bullet_shape = server->circle_shape_create();
+	server->shape_set_data(bullet_shape, 2);
+	const int bullet_count = 30000;
+	Vector<RID> bullets;
+	for (int i = 0; i < bullet_count; i++) {
+		const real_t angle = Math_TAU * i / bullet_count;
+		const Vector2 direction = Vector2(1, 0).rotated(angle);
+		RID bullet = server->body_create();
+		server->body_add_shape(bullet, bullet_shape);
+		server->body_set_collision_layer(bullet, 1);
+		server->body_set_collision_mask(bullet, 2);
+		server->body_set_param(bullet, PhysicsServer2D::BODY_PARAM_GRAVITY_SCALE, 0);
+		server->body_set_param(bullet, PhysicsServer2D::BODY_PARAM_LINEAR_DAMP_MODE, PhysicsServer2D::BODY_DAMP_MODE_REPLACE);
+		server->body_set_param(bullet, PhysicsServer2D::BODY_PARAM_LINEAR_DAMP, 0);
+		server->body_set_state(bullet, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, direction * (100 + (i % 50) * 20)));
+		server->body_set_state(bullet, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, direction * 100);
+		server->body_set_space(bullet, space);
+		bullets.push_back(bullet);
+	}
+
+	const int step_count = 60;
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < step_count; i++) {
+		server->body_set_state(player, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(i * 2, 0)));
+		server->step(1.0 / 60.0);
+		server->flush_queries();
+	}
+	const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+	print_line(vformat("Stepped %d bodies %d times in %d usec (%d usec per step).", bullet_count, step_count, elapsed, elapsed / step_count));
+
+	const Transform2D transform = server->body_get_state(bullets[0], PhysicsServer2D::BODY_STATE_TRANSFORM);
+	CHECK(transform.get_origin().x == doctest::Approx(200));
+
+	for (int i = 0; i < bullet_count; i++) {
+		server->free(bullets[i]);
+	}
+	server->free(bullet_shape);
+	server->free(player);
+	server->free(player_shape);
+	server->free(space);
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
@@ -0,0 +1,206 @@
+/*************************************************************************/
+/*  test_physics_server_3d.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/config/project_settings.h"
+#include "core/templates/local_vector.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// Shoots a small ball at a thin wall and returns where it ends up.
+static real_t shoot_ball_at_wall(bool p_continuous_cd, int p_continuous_cd_mode, int p_max_substeps) {
+	ProjectSettings *ps = ProjectSettings::get_singleton();
+	Variant old_mode = ps->get_setting("physics/3d/solver/continuous_cd_mode");
+	Variant old_substeps = ps->get_setting("physics/3d/solver/max_substeps");
+	ps->set_setting("physics/3d/solver/continuous_cd_mode", p_continuous_cd_mode);
+	ps->set_setting("physics/3d/solver/max_substeps", p_max_substeps);
+
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID wall_shape = server->box_shape_create();
+	server->shape_set_data(wall_shape, Vector3(0.05, 5, 5));
+	RID wall = server->body_create();
+	server->body_set_mode(wall, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(wall, wall_shape);
+	server->body_set_state(wall, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(5, 0, 0)));
+	server->body_set_space(wall, space);
+
+	RID ball_shape = server->sphere_shape_create();
+	server->shape_set_data(ball_shape, 0.25);
+	RID ball = server->body_create();
+	server->body_add_shape(ball, ball_shape);
+	server->body_set_enable_continuous_collision_detection(ball, p_continuous_cd);
+	server->body_set_space(ball, space);
+	server->body_set_state(ball, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(200, 0, 0));
+
+	for (int i = 0; i < 30; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	Transform3D transform = server->body_get_state(ball, PhysicsServer3D::BODY_STATE_TRANSFORM);
+
+	server->free(ball);
+	server->free(ball_shape);
+	server->free(wall);
+	server->free(wall_shape);
+	server->free(space);
+
+	ps->set_setting("physics/3d/solver/continuous_cd_mode", old_mode);
+	ps->set_setting("physics/3d/solver/max_substeps", old_substeps);
+
+	return transform.origin.x;
+}
+
+TEST_CASE("[SceneTree][Physics3D] Fast bodies don't tunnel with continuous collision detection") {
+	CHECK_MESSAGE(
+			shoot_ball_at_wall(false, 0, 1) > 5.0,
+			"The ball should go through the wall without continuous collision detection.");
+
+	CHECK_MESSAGE(
+			shoot_ball_at_wall(true, 1, 1) < 5.0,
+			"Speculative contacts should stop the ball.");
+
+	CHECK_MESSAGE(
+			shoot_ball_at_wall(true, 1, 16) < 5.0,
+			"Substepping the ball's island should stop it.");
+
+	CHECK_MESSAGE(
+			shoot_ball_at_wall(true, 0, 16) < 5.0,
+			"Substepping the ball's island should stop it without speculative contacts.");
+}
+
+TEST_CASE("[SceneTree][Physics3D] Batched queries") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID shape = server->sphere_shape_create();
+	server->shape_set_data(shape, 10);
+	Vector<RID> bodies;
+	for (int i = 0; i < 20; i++) {
+		RID body = server->body_create();
+		server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(body, shape);
+		server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(i * 50, i * 5, 0)));
+		server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+	server->step(1.0 / 60.0);
+	server->flush_queries();
+
+	PhysicsDirectSpaceState3D *state = server->space_get_direct_state(space);
+	REQUIRE(state);
+
+	// Every other ray and point misses.
+	const int query_count = 2000;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	for (int i = 0; i < query_count; i++) {
+		const real_t x = (i % 40) * 25 + (i / 40) * real_t(0.1);
+		from.push_back(Vector3(x, -100, 0));
+		to.push_back(Vector3(x, 200, 0));
+	}
+
+	PhysicsDirectSpaceState3D::RayParameters ray_parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> ray_results;
+	ray_results.resize(query_count);
+	LocalVector<bool> ray_hits;
+	ray_hits.resize(query_count);
+	state->intersect_rays(ray_parameters, from.ptr(), to.ptr(), query_count, ray_results.ptr(), ray_hits.ptr());
+
+	PhysicsDirectSpaceState3D::PointParameters point_parameters;
+	LocalVector<PhysicsDirectSpaceState3D::ShapeResult> point_results;
+	point_results.resize(query_count);
+	LocalVector<bool> point_hits;
+	point_hits.resize(query_count);
+	LocalVector<Vector3> positions;
+	for (int i = 0; i < query_count; i++) {
+		positions.push_back(Vector3(from[i].x, (i % 40) / 2 * 5, 0));
+	}
+	state->intersect_points(point_parameters, positions.ptr(), query_count, point_results.ptr(), point_hits.ptr());
+
+	int ray_mismatches = 0;
+	int point_mismatches = 0;
+	int hit_count = 0;
+	for (int i = 0; i < query_count; i++) {
+		ray_parameters.from = from[i];
+		ray_parameters.to = to[i];
+		PhysicsDirectSpaceState3D::RayResult ray_result;
+		const bool ray_hit = state->intersect_ray(ray_parameters, ray_result);
+		if (ray_hit != ray_hits[i] || (ray_hit && (ray_result.rid != ray_results[i].rid || !ray_result.position.is_equal_approx(ray_results[i].position)))) {
+			ray_mismatches++;
+		}
+		hit_count += ray_hit;
+
+		point_parameters.position = positions[i];
+		PhysicsDirectSpaceState3D::ShapeResult point_result;
+		const bool point_hit = state->intersect_point(point_parameters, &point_result, 1) > 0;
+		if (point_hit != point_hits[i] || (point_hit && point_result.rid != point_results[i].rid)) {
+			point_mismatches++;
+		}
+	}
+	CHECK_MESSAGE(hit_count == query_count / 2, "Half of the rays should hit a body.");
+	CHECK_MESSAGE(ray_mismatches == 0, "Batched rays should match single rays.");
+	CHECK_MESSAGE(point_mismatches == 0, "Batched points should match single points.");
+
+	// The first ray hits, the second misses.
+	Ref<PhysicsRayQueryParameters3D> ray_query;
+	ray_query.instantiate();
+	PackedVector3Array packed_from;
+	PackedVector3Array packed_to;
+	for (int i = 0; i < 2; i++) {
+		packed_from.push_back(from[i]);
+		packed_to.push_back(to[i]);
+	}
+	Dictionary rays = state->call("intersect_rays", ray_query, packed_from, packed_to);
+	Array rids = rays["rid"];
+	Array colliders = rays["collider"];
+	REQUIRE(rids.size() == 2);
+	CHECK(colliders.size() == 2);
+	CHECK(RID(rids[0]) == bodies[0]);
+	CHECK(RID(rids[1]) == RID());
+
+	for (int i = 0; i < bodies.size(); i++) {
+		server->free(bodies[i]);
+	}
+	server->free(shape);
+	server->free(space);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H